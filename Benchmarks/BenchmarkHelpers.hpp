@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/JobSystem.hpp"
+
+#include "Utils/TimeHelpers.hpp"
+
+namespace BenchmarkHelpers
+{
+    // Job system and a windowless Vulkan context, enough to load scenes and to create GPU resources
+    class HeadlessContext
+    {
+    public:
+        HeadlessContext()
+        {
+            JobSystem::Create();
+            VulkanContext::Create(nullptr);
+        }
+
+        ~HeadlessContext()
+        {
+            VulkanContext::device->WaitIdle();
+            VulkanContext::Destroy();
+            JobSystem::Destroy();
+        }
+
+        HeadlessContext(const HeadlessContext&) = delete;
+        HeadlessContext& operator=(const HeadlessContext&) = delete;
+    };
+
+    // Runs functor once to warm up, then returns the average duration of iterationCount runs
+    template <class F>
+    float MeasureMiliseconds(uint32_t iterationCount, F&& functor)
+    {
+        functor();
+
+        const TimePoint startTimePoint = std::chrono::high_resolution_clock::now();
+
+        for (uint32_t i = 0; i < iterationCount; ++i)
+        {
+            functor();
+        }
+
+        const float totalMiliseconds = std::chrono::duration<float, std::milli>(
+                std::chrono::high_resolution_clock::now() - startTimePoint).count();
+
+        return totalMiliseconds / static_cast<float>(std::max(iterationCount, 1u));
+    }
+}
@@ -0,0 +1,163 @@
+#include "BenchmarkHelpers.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+
+#include "Utils/Assert.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    constexpr uint32_t kIterationCount = 10;
+
+    // Calls of every batch fit into a single transient allocator region
+    constexpr uint32_t kCallCount = 1000;
+
+    constexpr std::array<vk::DeviceSize, 3> kDataSizes{ 64, 256, 1024 };
+
+    // Staging buffer with its own device memory, which is mapped and unmapped on every update as it used to be
+    struct LegacyStagingBuffer
+    {
+        vk::Buffer buffer;
+        vk::DeviceMemory memory;
+    };
+
+    static LegacyStagingBuffer CreateLegacyStagingBuffer(vk::DeviceSize size)
+    {
+        const vk::Device device = VulkanContext::device->Get();
+
+        const vk::BufferCreateInfo createInfo({}, size, vk::BufferUsageFlagBits::eTransferSrc);
+
+        const auto [bufferResult, buffer] = device.createBuffer(createInfo);
+        Assert(bufferResult == vk::Result::eSuccess);
+
+        const vk::MemoryRequirements memoryRequirements = device.getBufferMemoryRequirements(buffer);
+
+        const vk::MemoryPropertyFlags memoryProperties
+                = vk::MemoryPropertyFlagBits::eHostVisible
+                | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+        const vk::MemoryAllocateInfo allocateInfo(memoryRequirements.size,
+                VulkanContext::device->GetMemoryTypeIndex(memoryRequirements.memoryTypeBits, memoryProperties));
+
+        const auto [memoryResult, memory] = device.allocateMemory(allocateInfo);
+        Assert(memoryResult == vk::Result::eSuccess);
+
+        const vk::Result bindResult = device.bindBufferMemory(buffer, memory, 0);
+        Assert(bindResult == vk::Result::eSuccess);
+
+        return LegacyStagingBuffer{ buffer, memory };
+    }
+
+    static void DestroyLegacyStagingBuffer(const LegacyStagingBuffer& stagingBuffer)
+    {
+        VulkanContext::device->Get().destroyBuffer(stagingBuffer.buffer);
+        VulkanContext::device->Get().freeMemory(stagingBuffer.memory);
+    }
+
+    static vk::Buffer CreateBuffer(vk::DeviceSize size, vk::MemoryPropertyFlags memoryProperties,
+            BufferCreateFlags createFlags)
+    {
+        const BufferDescription description{
+            size, vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eTransferDst,
+            memoryProperties
+        };
+
+        return VulkanContext::bufferManager->CreateBuffer(description, createFlags);
+    }
+
+    // Returns the average cost of a single call in microseconds, calls are recorded into one command buffer
+    template <class F>
+    static float MeasureCall(F&& call)
+    {
+        float miliseconds = 0.0f;
+
+        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+            {
+                miliseconds = BenchmarkHelpers::MeasureMiliseconds(kIterationCount, [&]()
+                    {
+                        for (uint32_t i = 0; i < kCallCount; ++i)
+                        {
+                            call(commandBuffer);
+                        }
+                    });
+            });
+
+        return miliseconds * 1000.0f / static_cast<float>(kCallCount);
+    }
+
+    static void RunBenchmark(vk::DeviceSize dataSize)
+    {
+        const Bytes data(dataSize, 0xFF);
+
+        const LegacyStagingBuffer legacyStagingBuffer = CreateLegacyStagingBuffer(dataSize);
+
+        const vk::Buffer deviceBuffer = CreateBuffer(dataSize,
+                vk::MemoryPropertyFlagBits::eDeviceLocal, BufferCreateFlagBits::eStagingBuffer);
+
+        const vk::Buffer hostBuffer = CreateBuffer(dataSize,
+                vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                BufferCreateFlags());
+
+        const float mapUnmapMicroseconds = MeasureCall([&](vk::CommandBuffer commandBuffer)
+            {
+                const vk::Device device = VulkanContext::device->Get();
+
+                void* mappedMemory = nullptr;
+
+                const vk::Result result = device.mapMemory(legacyStagingBuffer.memory,
+                        0, dataSize, vk::MemoryMapFlags(), &mappedMemory);
+                Assert(result == vk::Result::eSuccess);
+
+                std::memcpy(mappedMemory, data.data(), dataSize);
+
+                device.unmapMemory(legacyStagingBuffer.memory);
+
+                commandBuffer.copyBuffer(legacyStagingBuffer.buffer, deviceBuffer, { vk::BufferCopy(0, 0, dataSize) });
+            });
+
+        const float persistentStagingMicroseconds = MeasureCall([&](vk::CommandBuffer commandBuffer)
+            {
+                VulkanContext::bufferManager->UpdateBuffer(commandBuffer, deviceBuffer, ByteView(data));
+            });
+
+        const float persistentHostMicroseconds = MeasureCall([&](vk::CommandBuffer commandBuffer)
+            {
+                VulkanContext::bufferManager->UpdateBuffer(commandBuffer, hostBuffer, ByteView(data));
+            });
+
+        uint32_t callIndex = 0;
+
+        const float transientMicroseconds = MeasureCall([&](vk::CommandBuffer)
+            {
+                if (callIndex++ % kCallCount == 0)
+                {
+                    VulkanContext::transientAllocator->BeginFrame(0);
+                }
+
+                VulkanContext::transientAllocator->Allocate(ByteView(data));
+            });
+
+        VulkanContext::bufferManager->DestroyBuffer(deviceBuffer);
+        VulkanContext::bufferManager->DestroyBuffer(hostBuffer);
+
+        DestroyLegacyStagingBuffer(legacyStagingBuffer);
+
+        LogI << "BufferUpdateBenchmark: " << dataSize << " bytes, "
+                << "map and unmap with staging " << mapUnmapMicroseconds << " us, "
+                << "persistent staging " << persistentStagingMicroseconds << " us, "
+                << "persistent host visible " << persistentHostMicroseconds << " us, "
+                << "transient allocator " << transientMicroseconds << " us\n";
+    }
+}
+
+int main()
+{
+    const BenchmarkHelpers::HeadlessContext context;
+
+    for (const vk::DeviceSize dataSize : Details::kDataSizes)
+    {
+        Details::RunBenchmark(dataSize);
+    }
+
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <thread>
+
+#include "BenchmarkHelpers.hpp"
+
+#include "Engine/JobSystem.hpp"
+
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    constexpr uint32_t kIterationCount = 10;
+
+    constexpr uint32_t kEmptyJobCount = 100000;
+
+    constexpr uint32_t kElementCount = 1 << 20;
+    constexpr uint32_t kElementIterationCount = 64;
+
+    static uint32_t GetMaxWorkerThreadCount()
+    {
+        const uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+
+        return hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 1;
+    }
+
+    // Scheduling overhead only, every job is executed and waited for through a single counter
+    static float MeasureEmptyJobs()
+    {
+        return BenchmarkHelpers::MeasureMiliseconds(kIterationCount, []()
+            {
+                JobCounter counter;
+
+                for (uint32_t i = 0; i < kEmptyJobCount; ++i)
+                {
+                    JobSystem::Execute([]() {}, counter);
+                }
+
+                JobSystem::Wait(counter);
+            });
+    }
+
+    static float MeasureParallelFor(std::vector<float>& elements)
+    {
+        return BenchmarkHelpers::MeasureMiliseconds(kIterationCount, [&]()
+            {
+                JobSystem::ParallelFor(kElementCount, [&](uint32_t i)
+                    {
+                        float value = static_cast<float>(i);
+
+                        for (uint32_t j = 0; j < kElementIterationCount; ++j)
+                        {
+                            value = std::sqrt(value * value + 1.0f) * 0.5f;
+                        }
+
+                        elements[i] = value;
+                    });
+            });
+    }
+}
+
+int main()
+{
+    std::vector<float> elements(Details::kElementCount);
+
+    float baseParallelForMiliseconds = 0.0f;
+
+    for (uint32_t workerCount = 1; workerCount <= Details::GetMaxWorkerThreadCount(); ++workerCount)
+    {
+        JobSystem::Create(workerCount);
+
+        const float emptyJobsMiliseconds = Details::MeasureEmptyJobs();
+        const float parallelForMiliseconds = Details::MeasureParallelFor(elements);
+
+        JobSystem::Destroy();
+
+        if (workerCount == 1)
+        {
+            baseParallelForMiliseconds = parallelForMiliseconds;
+        }
+
+        const float nanosecondsPerJob = emptyJobsMiliseconds * 1000000.0f / static_cast<float>(Details::kEmptyJobCount);
+
+        LogI << "JobSystemBenchmark: " << workerCount << " workers, "
+                << "empty job " << nanosecondsPerJob << " ns, "
+                << "parallel for " << parallelForMiliseconds << " ms, "
+                << "speedup " << baseParallelForMiliseconds / parallelForMiliseconds << "\n";
+    }
+
+    return 0;
+}
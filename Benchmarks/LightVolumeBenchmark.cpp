@@ -0,0 +1,66 @@
+#include "BenchmarkHelpers.hpp"
+
+#include "Engine/Scene/GlobalIllumination.hpp"
+#include "Engine/JobSystem.hpp"
+
+#include "Utils/AABBox.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    constexpr uint32_t kIterationCount = 3;
+
+    constexpr uint32_t kMinDepth = 2;
+    constexpr uint32_t kMaxDepth = 8;
+
+    // Cells of this edge are not split further, so a volume of 2^depth such cells has its leaves at that depth
+    constexpr float kLeafCellSize = 0.8f;
+
+    constexpr float kShellRadius = 0.35f;
+
+    // Cells containing geometry form the surface of a sphere, which resembles the sparse occupancy of real scenes
+    static bool IntersectsShell(const AABBox& volumeBBox, const AABBox& cellBBox)
+    {
+        const glm::vec3 center = volumeBBox.GetCenter();
+        const float radius = volumeBBox.GetShortestEdge() * kShellRadius;
+
+        const glm::vec3 minOffset = cellBBox.GetMin() - center;
+        const glm::vec3 maxOffset = cellBBox.GetMax() - center;
+
+        const glm::vec3 nearest = glm::max(glm::max(minOffset, -maxOffset), glm::vec3(0.0f));
+        const glm::vec3 farthest = glm::max(glm::abs(minOffset), glm::abs(maxOffset));
+
+        return glm::length(nearest) <= radius && glm::length(farthest) >= radius;
+    }
+}
+
+int main()
+{
+    JobSystem::Create();
+
+    for (uint32_t depth = Details::kMinDepth; depth <= Details::kMaxDepth; ++depth)
+    {
+        const float volumeSize = Details::kLeafCellSize * static_cast<float>(1 << depth);
+
+        const AABBox volumeBBox(glm::vec3(-0.5f * volumeSize), glm::vec3(0.5f * volumeSize));
+
+        const auto predicate = [&](const AABBox& cellBBox)
+            {
+                return Details::IntersectsShell(volumeBBox, cellBBox);
+            };
+
+        size_t positionCount = 0;
+
+        const float miliseconds = BenchmarkHelpers::MeasureMiliseconds(Details::kIterationCount, [&]()
+            {
+                positionCount = GlobalIlluminationHelpers::GenerateLightVolumePositions(volumeBBox, predicate).size();
+            });
+
+        LogI << "LightVolumeBenchmark: depth " << depth << ", "
+                << positionCount << " positions in " << miliseconds << " ms\n";
+    }
+
+    JobSystem::Destroy();
+
+    return 0;
+}
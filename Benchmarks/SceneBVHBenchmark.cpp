@@ -0,0 +1,72 @@
+#include "BenchmarkHelpers.hpp"
+
+#include "Engine/Scene/SceneBVH.hpp"
+#include "Engine/Scene/SceneCache.hpp"
+#include "Engine/Scene/SceneGenerator.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Camera.hpp"
+
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    constexpr uint32_t kIterationCount = 10;
+
+    constexpr std::array<uint32_t, 4> kItemCounts{ 1000, 10000, 100000, 200000 };
+
+    // Items only need distinct bounds, the primitive count merely keeps the BLAS generation short
+    constexpr uint32_t kPrimitiveCount = 64;
+
+    static void RunBenchmark(uint32_t itemCount)
+    {
+        const SceneGenerator::Description description{
+            .primitiveCount = kPrimitiveCount,
+            .materialCount = 1,
+            .instanceCount = itemCount,
+            .hierarchyDepth = 1
+        };
+
+        const Scene scene(SceneGenerator::Generate(description));
+
+        const auto& cameraComponent = scene.ctx().get<CameraComponent>();
+
+        const glm::mat4 viewProj = cameraComponent.projMatrix * cameraComponent.viewMatrix;
+
+        const float buildMiliseconds = BenchmarkHelpers::MeasureMiliseconds(kIterationCount, [&]()
+            {
+                const SceneBVH sceneBVH(scene);
+            });
+
+        SceneBVH sceneBVH(scene);
+
+        const float refitMiliseconds = BenchmarkHelpers::MeasureMiliseconds(kIterationCount, [&]()
+            {
+                sceneBVH.Refit(scene);
+            });
+
+        SceneBVH::CullingStats stats;
+
+        const float cullMiliseconds = BenchmarkHelpers::MeasureMiliseconds(kIterationCount, [&]()
+            {
+                sceneBVH.Cull(viewProj, stats);
+            });
+
+        LogI << "SceneBVHBenchmark: " << itemCount << " items, "
+                << "build " << buildMiliseconds << " ms, "
+                << "refit " << refitMiliseconds << " ms, "
+                << "cull " << cullMiliseconds << " ms, "
+                << stats.testedCount << " tested, " << stats.drawnCount << " drawn\n";
+    }
+}
+
+int main()
+{
+    const BenchmarkHelpers::HeadlessContext context;
+
+    for (const uint32_t itemCount : Details::kItemCounts)
+    {
+        Details::RunBenchmark(itemCount);
+    }
+
+    return 0;
+}
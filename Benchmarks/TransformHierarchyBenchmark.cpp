@@ -0,0 +1,99 @@
+#include "BenchmarkHelpers.hpp"
+
+#include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/SceneCache.hpp"
+#include "Engine/Scene/SceneGenerator.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/TransformHierarchy.hpp"
+
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    constexpr uint32_t kIterationCount = 10;
+
+    constexpr uint32_t kInstanceCount = 100000;
+
+    constexpr std::array<uint32_t, 5> kHierarchyDepths{ 1, 8, 64, 512, 4096 };
+
+    // Every chain with an index divisible by this has its root marked dirty in the partial update
+    constexpr uint32_t kPartialUpdateStep = 100;
+
+    constexpr uint32_t kPrimitiveCount = 64;
+
+    static std::vector<entt::entity> CollectRoots(const Scene& scene)
+    {
+        std::vector<entt::entity> roots;
+
+        for (auto&& [entity, hc] : scene.view<HierarchyComponent, RenderComponent>().each())
+        {
+            if (hc.parent == entt::null)
+            {
+                roots.push_back(entity);
+            }
+        }
+
+        return roots;
+    }
+
+    // Dirty roots force an update of their whole chains
+    static float MeasureUpdate(Scene& scene, TransformHierarchy& transformHierarchy,
+            const std::vector<entt::entity>& roots, uint32_t rootStep, uint32_t& updatedCount)
+    {
+        return BenchmarkHelpers::MeasureMiliseconds(kIterationCount, [&]()
+            {
+                for (size_t i = 0; i < roots.size(); i += rootStep)
+                {
+                    scene.get<TransformComponent>(roots[i]).dirty = true;
+                }
+
+                updatedCount = transformHierarchy.Update(scene);
+            });
+    }
+
+    static void RunBenchmark(uint32_t hierarchyDepth)
+    {
+        const SceneGenerator::Description description{
+            .primitiveCount = kPrimitiveCount,
+            .materialCount = 1,
+            .instanceCount = kInstanceCount,
+            .hierarchyDepth = hierarchyDepth
+        };
+
+        Scene scene(SceneGenerator::Generate(description));
+
+        const std::vector<entt::entity> roots = CollectRoots(scene);
+
+        const float buildMiliseconds = BenchmarkHelpers::MeasureMiliseconds(kIterationCount, [&]()
+            {
+                const TransformHierarchy transformHierarchy(scene, 0);
+            });
+
+        TransformHierarchy transformHierarchy(scene, 0);
+
+        uint32_t fullUpdateCount = 0;
+        uint32_t partialUpdateCount = 0;
+
+        const float fullUpdateMiliseconds = MeasureUpdate(scene, transformHierarchy, roots, 1, fullUpdateCount);
+        const float partialUpdateMiliseconds = MeasureUpdate(scene, transformHierarchy, roots,
+                kPartialUpdateStep, partialUpdateCount);
+
+        LogI << "TransformHierarchyBenchmark: " << kInstanceCount << " instances, "
+                << "depth " << transformHierarchy.GetDepth() << ", "
+                << "build " << buildMiliseconds << " ms, "
+                << "full update " << fullUpdateCount << " in " << fullUpdateMiliseconds << " ms, "
+                << "partial update " << partialUpdateCount << " in " << partialUpdateMiliseconds << " ms\n";
+    }
+}
+
+int main()
+{
+    const BenchmarkHelpers::HeadlessContext context;
+
+    for (const uint32_t hierarchyDepth : Details::kHierarchyDepths)
+    {
+        Details::RunBenchmark(hierarchyDepth);
+    }
+
+    return 0;
+}
@@ -33,4 +33,7 @@ namespace CameraHelpers
     glm::mat4 CalculateViewMatrix(const CameraLocation& location);
 
     glm::mat4 CalculateProjMatrix(const CameraProjection& projection);
+
+    // Planes point inside the frustum, valid for both regular and reverse depth
+    std::array<glm::vec4, 6> GetFrustumPlanes(const glm::mat4& viewProj);
 }
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace CommandLine
+{
+    // Forces GlobalIllumination to regenerate the light volume even if a valid cache exists
+    constexpr const char* kRebuildLightVolume = "--rebuild-light-volume";
+
+    // Renders offscreen without a window, surface and swapchain, then exits
+    constexpr const char* kHeadless = "--headless";
+
+    // Number of frames rendered in headless mode, e.g. --frame-count=100
+    constexpr const char* kFrameCount = "--frame-count";
+
+    // PNG file which receives the last frame rendered in headless mode, e.g. --capture=Frame.png
+    constexpr const char* kCapture = "--capture";
+
+    // JSON file which receives the GPU trace after the headless run, e.g. --gpu-trace=GpuTrace.json
+    constexpr const char* kGpuTrace = "--gpu-trace";
+
+    // Opens the procedural scene of Config::kGeneratedScene instead of a scene file
+    constexpr const char* kGeneratedScene = "--generated-scene";
+
+    void Parse(int argc, char* argv[]);
+
+    bool Contains(const std::string& option);
+
+    // Returns value of the option passed as option=value
+    std::optional<std::string> GetValue(const std::string& option);
+}
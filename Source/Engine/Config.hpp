@@ -3,6 +3,7 @@
 #include "Engine/Window.hpp"
 #include "Engine/Filesystem/Filepath.hpp"
 #include "Engine/Systems/CameraSystem.hpp"
+#include "Engine/Scene/SceneGenerator.hpp"
 #include "Engine/EngineHelpers.hpp"
 
 namespace Config
@@ -15,10 +16,21 @@ namespace Config
 
     constexpr bool kVSyncEnabled = false;
 
+    // Used when the frame count is not specified on the command line
+    constexpr uint32_t kHeadlessFrameCount = 100;
+
     constexpr bool kRayTracingEnabled = true;
 
+    // G-buffer draws are culled and generated by a compute pass, otherwise recorded per primitive after CPU culling
+    constexpr bool kGpuDrivenRendering = true;
+
+    // 0 means one worker per hardware thread besides the main one
+    constexpr uint32_t kJobWorkerCount = 0;
+
     const Filepath kShadersDirectory("~/Shaders/");
 
+    const Filepath kCacheDirectory("~/Cache/");
+
     //const Filepath kDefaultScenePath("~/Assets/Scenes/Porsche/Porsche.gltf");
     //const Filepath kDefaultScenePath("~/Assets/Scenes/SanMiguel/SanMiguel.gltf");
     const Filepath kDefaultScenePath("~/Assets/Scenes/ModernSponza/ModernSponza.gltf");
@@ -28,8 +40,20 @@ namespace Config
     //const Filepath kDefaultPanoramaPath("~/Assets/Environments/Dusk.hdr");
     const Filepath kDefaultPanoramaPath("~/Assets/Environments/SunnyHills.hdr");
 
+    // Opened with --generated-scene, exceeds 16-bit primitive and 8-bit material indices of the instance data
+    constexpr SceneGenerator::Description kGeneratedScene{
+        .primitiveCount = 70000,
+        .materialCount = 300,
+        .instanceCount = 200000,
+        .hierarchyDepth = 1
+    };
+
     constexpr bool kUseDefaultAssets = true;
 
+    constexpr bool kSceneCacheEnabled = true;
+
+    constexpr bool kEnvironmentCacheEnabled = true;
+
     constexpr bool kStaticCamera = false;
 
     constexpr float kPointLightRadius = 0.05f;
@@ -39,6 +63,9 @@ namespace Config
 
     constexpr bool kGlobalIlluminationEnabled = false;
 
+    // Light volume probes are projected into SH on the CPU instead of LightVolume.comp
+    constexpr bool kLightVolumeCpuProjection = true;
+
     constexpr bool kReverseDepth = true;
 
     namespace DefaultCamera
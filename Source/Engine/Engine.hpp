@@ -20,6 +20,7 @@ public:
     {
         RenderMode renderMode = RenderMode::eHybrid;
         bool drawingSuspended = false;
+        bool headless = false;
     };
 
     static void Create();
@@ -60,6 +61,12 @@ private:
     template <class T, class ...Args>
     static void AddSystem(Args&&...args);
 
+    static void BindUIText();
+
+    static void ProcessFrame();
+
+    static void RunHeadless();
+
     static void HandleResizeEvent(const vk::Extent2D& extent);
 
     static void HandleKeyInputEvent(const KeyInput& keyInput);
@@ -5,6 +5,8 @@
 
 #include "Engine/Filesystem/Filesystem.hpp"
 
+#include "Utils/Logger.hpp"
+
 std::optional<Filepath> Filesystem::ShowOpenDialog(const DialogDescription& description)
 {
     pfd::open_file openDialog(description.title,
@@ -42,3 +44,65 @@ std::string Filesystem::ReadFile(const Filepath& filepath)
 
     return buffer.str();
 }
+
+Bytes Filesystem::ReadBinaryFile(const Filepath& filepath)
+{
+    std::ifstream file(filepath.GetAbsolute(), std::ios::binary | std::ios::ate);
+
+    if (!file.is_open())
+    {
+        return Bytes();
+    }
+
+    const std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    Bytes bytes(static_cast<size_t>(size));
+    file.read(reinterpret_cast<char*>(bytes.data()), size);
+
+    if (!file)
+    {
+        return Bytes();
+    }
+
+    return bytes;
+}
+
+void Filesystem::WriteBinaryFile(const Filepath& filepath, const ByteView& data)
+{
+    const Filepath directory(filepath.GetDirectory());
+
+    CreateDirectories(directory);
+
+    std::ofstream file(filepath.GetAbsolute(), std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        LogW << "Failed to write file: " << filepath.GetAbsolute() << "\n";
+        return;
+    }
+
+    file.write(reinterpret_cast<const char*>(data.data), static_cast<std::streamsize>(data.size));
+}
+
+int64_t Filesystem::GetLastWriteTime(const Filepath& filepath)
+{
+    std::error_code errorCode;
+
+    const std::filesystem::file_time_type time
+            = std::filesystem::last_write_time(filepath.GetAbsolute(), errorCode);
+
+    if (errorCode)
+    {
+        return 0;
+    }
+
+    return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+void Filesystem::CreateDirectories(const Filepath& directory)
+{
+    std::error_code errorCode;
+
+    std::filesystem::create_directories(directory.GetAbsolute(), errorCode);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+
+using Job = std::function<void()>;
+
+// Tracks unfinished jobs of a group, waiting for a counter executes pending jobs
+// and blocks only when the remaining jobs of the group are running on other threads
+class JobCounter
+{
+public:
+    JobCounter() = default;
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return count.load(std::memory_order_acquire) == 0; }
+
+private:
+    std::atomic<uint32_t> count = 0;
+
+    friend class JobSystem;
+};
+
+class JobSystem
+{
+public:
+    // Zero worker count falls back to Config::kJobWorkerCount
+    static void Create(uint32_t workerThreadCount = 0);
+    static void Destroy();
+
+    // Including the main thread
+    static uint32_t GetThreadCount();
+
+    static void Execute(Job job, JobCounter& counter);
+
+    static void Wait(const JobCounter& counter);
+
+    // Calls functor(index) for every index in [0, count) and waits for completion
+    template <class F>
+    static void ParallelFor(uint32_t count, F&& functor, uint32_t batchSize = 0);
+
+private:
+    struct Worker;
+
+    static std::vector<std::unique_ptr<Worker>> workers;
+
+    static std::atomic<bool> running;
+    static std::atomic<uint32_t> pendingJobCount;
+
+    static void WorkerLoop(uint32_t workerIndex);
+
+    static bool ExecuteJob(uint32_t workerIndex);
+};
+
+template <class F>
+void JobSystem::ParallelFor(uint32_t count, F&& functor, uint32_t batchSize)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (batchSize == 0)
+    {
+        constexpr uint32_t kBatchesPerThread = 4;
+
+        batchSize = std::max(count / (GetThreadCount() * kBatchesPerThread), 1u);
+    }
+
+    JobCounter counter;
+
+    for (uint32_t begin = 0; begin < count; begin += batchSize)
+    {
+        const uint32_t end = std::min(begin + batchSize, count);
+
+        Execute([&functor, begin, end]()
+            {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    functor(i);
+                }
+            }, counter);
+    }
+
+    Wait(counter);
+}
@@ -26,6 +26,11 @@ namespace Details
 
         return projMatrix;
     }
+
+    glm::vec4 GetRow(const glm::mat4& matrix, uint32_t index)
+    {
+        return glm::vec4(matrix[0][index], matrix[1][index], matrix[2][index], matrix[3][index]);
+    }
 }
 
 glm::mat4 CameraHelpers::CalculateViewMatrix(const CameraLocation& location)
@@ -47,3 +52,20 @@ glm::mat4 CameraHelpers::CalculateProjMatrix(const CameraProjection& projection)
     return Details::CalculatePerspectiveMatrix(
             projection.yFov, projection.width, projection.height, zNear, zFar);
 }
+
+std::array<glm::vec4, 6> CameraHelpers::GetFrustumPlanes(const glm::mat4& viewProj)
+{
+    const glm::vec4 row0 = Details::GetRow(viewProj, 0);
+    const glm::vec4 row1 = Details::GetRow(viewProj, 1);
+    const glm::vec4 row2 = Details::GetRow(viewProj, 2);
+    const glm::vec4 row3 = Details::GetRow(viewProj, 3);
+
+    return {
+        row3 + row0,
+        row3 - row0,
+        row3 + row1,
+        row3 - row1,
+        row2,
+        row3 - row2
+    };
+}
@@ -0,0 +1,38 @@
+#include "Engine/CommandLine.hpp"
+
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    static std::set<std::string> options;
+}
+
+void CommandLine::Parse(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        Details::options.emplace(argv[i]);
+
+        LogI << "Command line option: " << argv[i] << "\n";
+    }
+}
+
+bool CommandLine::Contains(const std::string& option)
+{
+    return Details::options.contains(option);
+}
+
+std::optional<std::string> CommandLine::GetValue(const std::string& option)
+{
+    const std::string prefix = option + "=";
+
+    for (const std::string& argument : Details::options)
+    {
+        if (argument.starts_with(prefix))
+        {
+            return argument.substr(prefix.size());
+        }
+    }
+
+    return std::nullopt;
+}
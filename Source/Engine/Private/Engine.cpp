@@ -1,17 +1,29 @@
+#include <charconv>
+
 #include "Engine/Engine.hpp"
 
 #include "Engine/Config.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/CommandLine.hpp"
 #include "Engine/Filesystem/Filesystem.hpp"
 #include "Engine/Systems/CameraSystem.hpp"
+#include "Engine/Systems/SceneBVHSystem.hpp"
+#include "Engine/Systems/TransformSystem.hpp"
 #include "Engine/Systems/UIRenderer.hpp"
 #include "Engine/Render/PathTracingRenderer.hpp"
 #include "Engine/Render/HybridRenderer.hpp"
 #include "Engine/Render/FrameLoop.hpp"
 #include "Engine/Render/RenderContext.hpp"
+#include "Engine/Render/Vulkan/RayTracing/DynamicTlas.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+#include "Engine/Scene/SceneCache.hpp"
+#include "Engine/Scene/SceneGenerator.hpp"
 
 namespace Details
 {
+    static const Filepath kGpuTracePath(Config::kCacheDirectory.GetAbsolute() + "GpuTrace.json");
+
     static Filepath GetScenePath()
     {
         if constexpr (Config::kUseDefaultAssets)
@@ -30,6 +42,52 @@ namespace Details
             return scenePath.value_or(Config::kDefaultScenePath);
         }
     }
+
+    static uint32_t GetHeadlessFrameCount()
+    {
+        const std::optional<std::string> frameCount = CommandLine::GetValue(CommandLine::kFrameCount);
+
+        if (!frameCount.has_value())
+        {
+            return Config::kHeadlessFrameCount;
+        }
+
+        const std::string& text = frameCount.value();
+
+        uint32_t value = 0;
+
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+        const bool isValid = error == std::errc() && end == text.data() + text.size() && value > 0;
+
+        if (!isValid)
+        {
+            LogE << "Invalid headless frame count: \"" << text << "\", expected a positive integer\n";
+            Assert(false);
+
+            return Config::kHeadlessFrameCount;
+        }
+
+        return value;
+    }
+
+    // UI render pass leaves the swapchain image in the present layout, headless frames have no UI
+    static void TransitSwapchainImageToPresent(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
+    {
+        const vk::Image swapchainImage = VulkanContext::swapchain->GetImages()[imageIndex];
+
+        const ImageLayoutTransition layoutTransition{
+            vk::ImageLayout::eColorAttachmentOptimal,
+            vk::ImageLayout::ePresentSrcKHR,
+            PipelineBarrier{
+                SyncScope::kColorAttachmentWrite,
+                SyncScope::kBlockNone
+            }
+        };
+
+        ImageHelpers::TransitImageLayout(commandBuffer, swapchainImage,
+                ImageHelpers::kFlatColor, layoutTransition);
+    }
 }
 
 Timer Engine::timer;
@@ -51,9 +109,16 @@ void Engine::Create()
 {
     EASY_FUNCTION()
 
-    window = std::make_unique<Window>(Config::kExtent, Config::kWindowMode);
+    state.headless = CommandLine::Contains(CommandLine::kHeadless);
+
+    if (!state.headless)
+    {
+        window = std::make_unique<Window>(Config::kExtent, Config::kWindowMode);
+    }
+
+    JobSystem::Create();
 
-    VulkanContext::Create(*window);
+    VulkanContext::Create(window.get());
     RenderContext::Create();
 
     AddEventHandler<vk::Extent2D>(EventType::eResize, &Engine::HandleResizeEvent);
@@ -62,7 +127,11 @@ void Engine::Create()
 
     frameLoop = std::make_unique<FrameLoop>();
 
-    uiRenderer = std::make_unique<UIRenderer>(*window);
+    if (window)
+    {
+        uiRenderer = std::make_unique<UIRenderer>(*window);
+    }
+
     hybridRenderer = std::make_unique<HybridRenderer>();
 
     if constexpr (Config::kRayTracingEnabled)
@@ -70,47 +139,33 @@ void Engine::Create()
         pathTracingRenderer = std::make_unique<PathTracingRenderer>();
     }
 
+    if (uiRenderer)
+    {
+        BindUIText();
+    }
+
     AddSystem<CameraSystem>();
+    AddSystem<TransformSystem>();
+    AddSystem<SceneBVHSystem>();
 
     OpenScene();
 }
 
 void Engine::Run()
 {
+    if (state.headless)
+    {
+        RunHeadless();
+        return;
+    }
+
     while (!window->ShouldClose())
     {
         EASY_BLOCK("Engine::Frame")
 
         window->PollEvents();
 
-        if (scene)
-        {
-            const float deltaSeconds = timer.GetDeltaSeconds();
-
-            for (const auto& system : systems)
-            {
-                system->Process(*scene, deltaSeconds);
-            }
-        }
-
-        if (state.drawingSuspended)
-        {
-            continue;
-        }
-
-        frameLoop->Draw([](vk::CommandBuffer commandBuffer, uint32_t imageIndex)
-            {
-                if (state.renderMode == RenderMode::ePathTracing && pathTracingRenderer)
-                {
-                    pathTracingRenderer->Render(commandBuffer, imageIndex);
-                }
-                else
-                {
-                    hybridRenderer->Render(commandBuffer, imageIndex);
-                }
-
-                uiRenderer->Render(commandBuffer, imageIndex);
-            });
+        ProcessFrame();
     }
 }
 
@@ -130,6 +185,8 @@ void Engine::Destroy()
 
     RenderContext::Destroy();
     VulkanContext::Destroy();
+
+    JobSystem::Destroy();
 }
 
 void Engine::TriggerEvent(EventType type)
@@ -149,6 +206,178 @@ void Engine::AddEventHandler(EventType type, std::function<void()> handler)
         });
 }
 
+void Engine::BindUIText()
+{
+    uiRenderer->BindText([]()
+        {
+            const FrameLoop::Stats& stats = frameLoop->GetStats();
+
+            return Format("Frame: %.2f ms CPU, %.2f ms wait, %.2f ms latency, %u in flight",
+                    stats.cpuMiliseconds, stats.waitMiliseconds, stats.latencyMiliseconds,
+                    VulkanConfig::kMaxFramesInFlight);
+        });
+
+    uiRenderer->BindText([]()
+        {
+            if constexpr (Config::kGpuDrivenRendering)
+            {
+                return std::string("Culling: GPU driven");
+            }
+            else
+            {
+                const SceneBVH::CullingStats& stats = hybridRenderer->GetCullingStats();
+
+                return Format("Culling: %u tested, %u culled, %u drawn, %.3f ms",
+                        stats.testedCount, stats.culledCount, stats.drawnCount, stats.cullMiliseconds);
+            }
+        });
+
+    if constexpr (Config::kRayTracingEnabled)
+    {
+        uiRenderer->BindText([]()
+            {
+                const DynamicTlas* dynamicTlas = scene ? scene->ctx().find<DynamicTlas>() : nullptr;
+
+                if (!dynamicTlas)
+                {
+                    return std::string();
+                }
+
+                const DynamicTlas::Stats& stats = dynamicTlas->GetStats();
+
+                return Format("TLAS: %u refits %.3f ms, %u rebuilds %.3f ms",
+                        stats.refitCount, stats.refitMiliseconds, stats.rebuildCount, stats.rebuildMiliseconds);
+            });
+    }
+
+    uiRenderer->BindText([]()
+        {
+            const BufferPool::Stats stats = VulkanContext::bufferPool->GetStats();
+
+            return Format("Buffer pool: %u slices in %u arenas, %.1f / %.1f MB, %.1f%% fragmented",
+                    stats.allocationCount, stats.arenaCount,
+                    static_cast<float>(stats.usedSize) / static_cast<float>(Numbers::kMegabyte),
+                    static_cast<float>(stats.reservedSize) / static_cast<float>(Numbers::kMegabyte),
+                    stats.fragmentation * 100.0f);
+        });
+
+    uiRenderer->BindText([]()
+        {
+            const TransientAllocator::Stats& stats = VulkanContext::transientAllocator->GetStats();
+
+            return Format("Transient: %.2f KB last frame, %.2f KB peak, %.2f KB region",
+                    static_cast<float>(stats.lastFrameSize) / static_cast<float>(Numbers::kKilobyte),
+                    static_cast<float>(stats.peakFrameSize) / static_cast<float>(Numbers::kKilobyte),
+                    static_cast<float>(stats.regionSize) / static_cast<float>(Numbers::kKilobyte));
+        });
+}
+
+void Engine::ProcessFrame()
+{
+    if (scene)
+    {
+        const float deltaSeconds = timer.GetDeltaSeconds();
+
+        for (const auto& system : systems)
+        {
+            system->Process(*scene, deltaSeconds);
+        }
+
+        if (scene->UpdateRayTracingInstances())
+        {
+            hybridRenderer->RegisterScene(scene.get());
+            if (pathTracingRenderer)
+            {
+                pathTracingRenderer->RegisterScene(scene.get());
+            }
+        }
+    }
+
+    if (state.drawingSuspended)
+    {
+        return;
+    }
+
+    frameLoop->Draw([](vk::CommandBuffer commandBuffer, uint32_t imageIndex)
+        {
+            if (DynamicTlas* dynamicTlas = scene ? scene->ctx().find<DynamicTlas>() : nullptr)
+            {
+                const GpuScope gpuScope(commandBuffer, "DynamicTlas");
+                dynamicTlas->Update(commandBuffer);
+            }
+
+            if (state.renderMode == RenderMode::ePathTracing && pathTracingRenderer)
+            {
+                pathTracingRenderer->Render(commandBuffer, imageIndex);
+            }
+            else
+            {
+                hybridRenderer->Render(commandBuffer, imageIndex);
+            }
+
+            if (uiRenderer)
+            {
+                const GpuScope gpuScope(commandBuffer, "UIRenderer");
+                uiRenderer->Render(commandBuffer, imageIndex);
+            }
+            else
+            {
+                Details::TransitSwapchainImageToPresent(commandBuffer, imageIndex);
+            }
+        });
+}
+
+void Engine::RunHeadless()
+{
+    const uint32_t frameCount = Details::GetHeadlessFrameCount();
+
+    const TimePoint startTimePoint = std::chrono::high_resolution_clock::now();
+
+    for (uint32_t i = 0; i < frameCount; ++i)
+    {
+        EASY_BLOCK("Engine::Frame")
+
+        ProcessFrame();
+    }
+
+    VulkanContext::device->WaitIdle();
+
+    const float totalMiliseconds = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTimePoint).count();
+
+    LogI << "Headless run: " << frameCount << " frames in " << totalMiliseconds << " ms, "
+            << totalMiliseconds / static_cast<float>(std::max(frameCount, 1u)) << " ms per frame\n";
+
+    if (const DynamicTlas* dynamicTlas = scene ? scene->ctx().find<DynamicTlas>() : nullptr)
+    {
+        const DynamicTlas::Stats& stats = dynamicTlas->GetStats();
+
+        LogI << "Headless TLAS: " << dynamicTlas->GetInstanceCount() << " instances, "
+                << stats.refitCount << " refits, last " << stats.refitMiliseconds << " ms, "
+                << stats.rebuildCount << " rebuilds, last " << stats.rebuildMiliseconds << " ms\n";
+    }
+
+    for (const GpuProfiler::ScopeStats& scopeStats : VulkanContext::gpuProfiler->GetScopeStats())
+    {
+        LogI << "Headless GPU scope: " << std::string(scopeStats.depth * 2, ' ') << scopeStats.name << " "
+                << scopeStats.averageMiliseconds << " ms\n";
+    }
+
+    const std::optional<std::string> capturePath = CommandLine::GetValue(CommandLine::kCapture);
+
+    if (capturePath.has_value() && frameCount > 0)
+    {
+        frameLoop->CaptureLastImage(Filepath(capturePath.value()));
+    }
+
+    const std::optional<std::string> gpuTracePath = CommandLine::GetValue(CommandLine::kGpuTrace);
+
+    if (gpuTracePath.has_value())
+    {
+        VulkanContext::gpuProfiler->ExportTrace(Filepath(gpuTracePath.value()));
+    }
+}
+
 void Engine::HandleResizeEvent(const vk::Extent2D& extent)
 {
     VulkanContext::device->WaitIdle();
@@ -184,6 +413,9 @@ void Engine::HandleKeyInputEvent(const KeyInput& keyInput)
         case Key::eT:
             ToggleRenderMode();
             break;
+        case Key::eP:
+            VulkanContext::gpuProfiler->ExportTrace(Details::kGpuTracePath);
+            break;
         default:
             break;
         }
@@ -229,7 +461,15 @@ void Engine::OpenScene()
         pathTracingRenderer->RemoveScene();
     }
 
-    scene = std::make_unique<Scene>(Details::GetScenePath());
+    if (CommandLine::Contains(CommandLine::kGeneratedScene))
+    {
+        scene = std::make_unique<Scene>(SceneGenerator::Generate(Config::kGeneratedScene));
+    }
+    else
+    {
+        scene = std::make_unique<Scene>(state.headless ? Config::kDefaultScenePath : Details::GetScenePath());
+    }
+
     scene->PrepareToRender();
 
     hybridRenderer->RegisterScene(scene.get());
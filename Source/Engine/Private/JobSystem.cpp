@@ -0,0 +1,229 @@
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <condition_variable>
+
+#include "Engine/JobSystem.hpp"
+
+#include "Engine/Config.hpp"
+
+#include "Utils/Assert.hpp"
+#include "Utils/Helpers.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    struct ScheduledJob
+    {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    // Index 0 belongs to the main thread and to any other thread which is not a worker
+    static thread_local uint32_t threadIndex = 0;
+
+    static std::mutex sleepMutex;
+    static std::condition_variable sleepCondition;
+
+    static uint32_t GetWorkerThreadCount(uint32_t requestedCount)
+    {
+        if (requestedCount > 0)
+        {
+            return requestedCount;
+        }
+
+        if constexpr (Config::kJobWorkerCount > 0)
+        {
+            return Config::kJobWorkerCount;
+        }
+
+        const uint32_t hardwareThreadCount = std::thread::hardware_concurrency();
+
+        return hardwareThreadCount > 1 ? hardwareThreadCount - 1 : 1;
+    }
+}
+
+// Owner pushes and pops jobs at the back, other threads steal from the front
+struct JobSystem::Worker
+{
+    std::mutex mutex;
+    std::deque<Details::ScheduledJob> jobs;
+    std::thread thread;
+};
+
+std::vector<std::unique_ptr<JobSystem::Worker>> JobSystem::workers;
+
+std::atomic<bool> JobSystem::running = false;
+std::atomic<uint32_t> JobSystem::pendingJobCount = 0;
+
+void JobSystem::Create(uint32_t workerThreadCount)
+{
+    EASY_FUNCTION()
+
+    workerThreadCount = Details::GetWorkerThreadCount(workerThreadCount);
+
+    workers.resize(workerThreadCount + 1);
+
+    for (auto& worker : workers)
+    {
+        worker = std::make_unique<Worker>();
+    }
+
+    running = true;
+
+    for (uint32_t i = 1; i < workers.size(); ++i)
+    {
+        workers[i]->thread = std::thread(&JobSystem::WorkerLoop, i);
+    }
+
+    LogI << "Job system created: " << workerThreadCount << " worker threads" << "\n";
+}
+
+void JobSystem::Destroy()
+{
+    Assert(pendingJobCount == 0);
+
+    {
+        const std::lock_guard lock(Details::sleepMutex);
+
+        running = false;
+    }
+
+    Details::sleepCondition.notify_all();
+
+    for (uint32_t i = 1; i < workers.size(); ++i)
+    {
+        workers[i]->thread.join();
+    }
+
+    workers.clear();
+}
+
+uint32_t JobSystem::GetThreadCount()
+{
+    return static_cast<uint32_t>(workers.size());
+}
+
+void JobSystem::Execute(Job job, JobCounter& counter)
+{
+    Assert(!workers.empty());
+
+    counter.count.fetch_add(1, std::memory_order_relaxed);
+
+    {
+        const std::lock_guard lock(Details::sleepMutex);
+
+        pendingJobCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Worker& worker = *workers[Details::threadIndex];
+
+    {
+        const std::lock_guard lock(worker.mutex);
+
+        worker.jobs.push_back(Details::ScheduledJob{ std::move(job), &counter });
+    }
+
+    Details::sleepCondition.notify_one();
+}
+
+void JobSystem::Wait(const JobCounter& counter)
+{
+    EASY_FUNCTION()
+
+    while (!counter.IsDone())
+    {
+        if (ExecuteJob(Details::threadIndex))
+        {
+            continue;
+        }
+
+        // Remaining jobs of the group run on other threads, sleep until they finish or new jobs are queued
+        std::unique_lock lock(Details::sleepMutex);
+
+        Details::sleepCondition.wait(lock, [&counter]()
+            {
+                return counter.IsDone() || pendingJobCount > 0;
+            });
+    }
+}
+
+void JobSystem::WorkerLoop(uint32_t workerIndex)
+{
+    Details::threadIndex = workerIndex;
+
+    const std::string threadName = Format("JobWorker%u", workerIndex);
+
+    EASY_THREAD(threadName.c_str())
+
+    while (true)
+    {
+        if (ExecuteJob(workerIndex))
+        {
+            continue;
+        }
+
+        std::unique_lock lock(Details::sleepMutex);
+
+        Details::sleepCondition.wait(lock, []()
+            {
+                return !running || pendingJobCount > 0;
+            });
+
+        if (!running)
+        {
+            break;
+        }
+    }
+}
+
+bool JobSystem::ExecuteJob(uint32_t workerIndex)
+{
+    std::optional<Details::ScheduledJob> scheduledJob;
+
+    {
+        Worker& worker = *workers[workerIndex];
+
+        const std::lock_guard lock(worker.mutex);
+
+        if (!worker.jobs.empty())
+        {
+            scheduledJob = std::move(worker.jobs.back());
+            worker.jobs.pop_back();
+        }
+    }
+
+    for (uint32_t i = 1; i < workers.size() && !scheduledJob.has_value(); ++i)
+    {
+        Worker& victim = *workers[(workerIndex + i) % workers.size()];
+
+        const std::lock_guard lock(victim.mutex);
+
+        if (!victim.jobs.empty())
+        {
+            scheduledJob = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+
+    if (!scheduledJob.has_value())
+    {
+        return false;
+    }
+
+    pendingJobCount.fetch_sub(1, std::memory_order_relaxed);
+
+    scheduledJob->job();
+
+    if (scheduledJob->counter->count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        {
+            // Waiting thread checks the counter under the mutex, so the wakeup can't be lost
+            const std::lock_guard lock(Details::sleepMutex);
+        }
+
+        Details::sleepCondition.notify_all();
+    }
+
+    return true;
+}
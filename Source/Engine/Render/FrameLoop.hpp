@@ -2,21 +2,61 @@
 
 #include "Engine/Render/Vulkan/VulkanHelpers.hpp"
 
+#include "Utils/TimeHelpers.hpp"
+
+class Filepath;
+
+// Cycles kMaxFramesInFlight frame contexts independently of the swapchain image count,
+// so the host records the next frame while the device is still executing the previous ones.
+// Acquire semaphores belong to frame contexts, rendering complete semaphores belong to swapchain images,
+// since an image is only reacquired after its presentation which waits for the semaphore.
+// Offscreen swapchain images are cycled in order without acquire and present.
 class FrameLoop
 {
 public:
+    struct Stats
+    {
+        float cpuMiliseconds = 0.0f; // host frame time excluding the wait for a free frame context
+        float waitMiliseconds = 0.0f; // host time blocked on the frame context submitted earlier
+        float latencyMiliseconds = 0.0f; // from the start of the last retired frame until its completion
+    };
+
     FrameLoop();
     ~FrameLoop();
 
+    const Stats& GetStats() const { return stats; }
+
     void Draw(RenderCommands renderCommands);
 
+    // Waits for the device and writes the last drawn offscreen image to PNG file
+    void CaptureLastImage(const Filepath& path) const;
+
 private:
     struct Frame
     {
         vk::CommandBuffer commandBuffer;
-        CommandBufferSync sync;
+        CommandBufferSync sync; // signal semaphores are taken from renderingCompleteSemaphores
+        std::optional<TimePoint> startTimePoint; // set while the frame is in flight
     };
 
     uint32_t frameIndex = 0;
     std::vector<Frame> frames;
+
+    std::vector<vk::Semaphore> renderingCompleteSemaphores; // indexed by swapchain image
+
+    std::optional<uint32_t> lastImageIndex;
+
+    std::optional<TimePoint> frameStartTimePoint;
+
+    Stats stats;
+
+    uint32_t AcquireImage(const Frame& frame);
+
+    vk::Semaphore GetRenderingCompleteSemaphore(uint32_t imageIndex);
+
+    void Present(uint32_t imageIndex) const;
+
+    void RetireCompletedFrames();
+
+    void RetireFrame(Frame& frame, const TimePoint& completionTimePoint);
 };
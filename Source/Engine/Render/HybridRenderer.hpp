@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Scene/SceneBVH.hpp"
+
 class Scene;
 class GBufferStage;
 class LightingStage;
@@ -21,6 +23,8 @@ public:
 
     void Resize(const vk::Extent2D& extent) const;
 
+    const SceneBVH::CullingStats& GetCullingStats() const;
+
 private:
     const Scene* scene = nullptr;
 
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/DescriptorHelpers.hpp"
+#include "Engine/Scene/Material.hpp"
+
+class Scene;
+class ComputePipeline;
+
+// Culls scene render objects on the GPU and writes indexed indirect draw commands for the merged geometry.
+// Commands are grouped into buckets, render objects go to the bucket matching their material flags.
+class IndirectDrawCuller
+{
+public:
+    IndirectDrawCuller(const Scene& scene_, const std::vector<MaterialFlags>& bucketFlags);
+
+    ~IndirectDrawCuller();
+
+    // Contains gpu::DrawObject array in binding 0, accessible from vertex shaders with gl_InstanceIndex
+    const DescriptorSet& GetDescriptorSet() const { return descriptorSet; }
+
+    // Version of the scene BVH the objects were collected from, the culler has to be recreated when it changes
+    uint32_t GetSceneVersion() const { return sceneVersion; }
+
+    // Uploads objects with changed transforms, has to be recorded outside of render passes before any Draw
+    void Cull(vk::CommandBuffer commandBuffer, const glm::mat4& viewProj);
+
+    void Draw(vk::CommandBuffer commandBuffer, uint32_t bucketIndex) const;
+
+    void ReloadShaders();
+
+private:
+    const Scene* scene = nullptr;
+
+    uint32_t sceneVersion = 0;
+    uint32_t objectCount = 0;
+
+    std::vector<gpu::DrawObject> objects;
+
+    // Transform hierarchy version the object transforms were taken from
+    uint32_t transformVersion = 0;
+    std::map<entt::entity, std::vector<uint32_t>> entityObjects;
+
+    std::vector<uint32_t> bucketOffsets;
+    std::vector<uint32_t> bucketSizes;
+
+    vk::Buffer objectBuffer;
+    vk::Buffer drawBuffer;
+    vk::Buffer countBuffer;
+
+    DescriptorSet descriptorSet;
+
+    std::unique_ptr<ComputePipeline> pipeline;
+
+    void UpdateTransforms(vk::CommandBuffer commandBuffer);
+};
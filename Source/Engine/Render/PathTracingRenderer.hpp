@@ -26,9 +26,10 @@ public:
     void Resize(const vk::Extent2D& extent);
 
 protected:
-    PathTracingRenderer(uint32_t sampleCount_, const vk::Extent2D& extent);
+    PathTracingRenderer(uint32_t sampleCount_, const vk::Extent2D& extent, uint32_t layerCount_);
 
-    virtual const CameraComponent& GetCameraComponent() const;
+    // Traces all layers of the array render target with a single dispatch, one camera per layer
+    void RenderLayers(vk::CommandBuffer commandBuffer, const std::vector<CameraComponent>& layerCameras);
 
     struct RenderTargets
     {
@@ -42,6 +43,7 @@ protected:
 private:
     const bool isProbeRenderer;
     const uint32_t sampleCount;
+    const uint32_t layerCount;
 
     const Scene* scene = nullptr;
 
@@ -57,9 +59,16 @@ private:
 
     bool UseSwapchainRenderTarget() const { return !isProbeRenderer; }
 
+    const CameraComponent& GetCameraComponent() const;
+
     std::vector<vk::DescriptorSetLayout> GetDescriptorSetLayouts() const;
 
-    void UpdateCameraBuffer(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
+    // Returns dynamic offset of the camera data in the transient allocator
+    uint32_t UpdateCameraData() const;
+
+    // Camera offsets are bound only for the transient camera data, layer cameras are stored in a regular buffer
+    void TraceRays(vk::CommandBuffer commandBuffer, uint32_t descriptorSetIndex, uint32_t depth,
+            const std::vector<uint32_t>& cameraOffsets);
 
     void HandleKeyInputEvent(const KeyInput& keyInput);
 
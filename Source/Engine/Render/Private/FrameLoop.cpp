@@ -1,17 +1,29 @@
+#include <stb_image_write.h>
+
 #include "Engine/Render/FrameLoop.hpp"
 
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+#include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
+#include "Engine/Filesystem/Filesystem.hpp"
 
 #include "Utils/Assert.hpp"
 
+namespace Details
+{
+    static float GetDeltaMiliseconds(const TimePoint& start, const TimePoint& end)
+    {
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+}
+
 FrameLoop::FrameLoop()
 {
-    frames.resize(VulkanContext::swapchain->GetImageCount());
+    frames.resize(VulkanConfig::kMaxFramesInFlight);
     for (auto& frame : frames)
     {
         frame.commandBuffer = VulkanContext::device->AllocateCommandBuffer(CommandBufferType::eOneTime);
         frame.sync.waitSemaphores.push_back(VulkanHelpers::CreateSemaphore(VulkanContext::device->Get()));
-        frame.sync.signalSemaphores.push_back(VulkanHelpers::CreateSemaphore(VulkanContext::device->Get()));
         frame.sync.fence = VulkanHelpers::CreateFence(VulkanContext::device->Get(), vk::FenceCreateFlagBits::eSignaled);
         frame.sync.waitStages.emplace_back(vk::PipelineStageFlagBits::eRayTracingShaderKHR);
     }
@@ -23,38 +35,179 @@ FrameLoop::~FrameLoop()
     {
         VulkanHelpers::DestroyCommandBufferSync(VulkanContext::device->Get(), frame.sync);
     }
+
+    for (const vk::Semaphore semaphore : renderingCompleteSemaphores)
+    {
+        VulkanContext::device->Get().destroySemaphore(semaphore);
+    }
 }
 
 void FrameLoop::Draw(RenderCommands renderCommands)
 {
-    const vk::SwapchainKHR swapchain = VulkanContext::swapchain->Get();
+    EASY_FUNCTION()
+
     const vk::Device device = VulkanContext::device->Get();
 
-    const auto& [graphicsQueue, presentQueue] = VulkanContext::device->GetQueues();
-    const auto& [commandBuffer, synchronization] = frames[frameIndex];
+    const Queues& queues = VulkanContext::device->GetQueues();
 
-    const vk::Semaphore presentCompleteSemaphore = synchronization.waitSemaphores.front();
-    const vk::Semaphore renderingCompleteSemaphore = synchronization.signalSemaphores.front();
-    const vk::Fence renderingFence = synchronization.fence;
+    if (!frameStartTimePoint.has_value())
+    {
+        frameStartTimePoint = std::chrono::high_resolution_clock::now();
+    }
+
+    RetireCompletedFrames();
+
+    Frame& frame = frames[frameIndex];
+
+    const vk::Fence renderingFence = frame.sync.fence;
 
-    const auto& [acquireResult, imageIndex] = device.acquireNextImageKHR(
-            swapchain, Numbers::kMaxUint, presentCompleteSemaphore, nullptr);
-    Assert(acquireResult == vk::Result::eSuccess || acquireResult == vk::Result::eSuboptimalKHR);
+    const TimePoint waitStartTimePoint = std::chrono::high_resolution_clock::now();
+
+    if (frame.startTimePoint.has_value())
+    {
+        EASY_BLOCK("FrameLoop::WaitForFrame")
+
+        VulkanHelpers::WaitForFences(device, { renderingFence });
+
+        RetireFrame(frame, std::chrono::high_resolution_clock::now());
+    }
 
-    VulkanHelpers::WaitForFences(device, { renderingFence });
+    const TimePoint waitEndTimePoint = std::chrono::high_resolution_clock::now();
+
+    const uint32_t imageIndex = AcquireImage(frame);
 
     const vk::Result resetResult = device.resetFences(1, &renderingFence);
     Assert(resetResult == vk::Result::eSuccess);
 
-    const DeviceCommands deviceCommands = [&](vk::CommandBuffer cb) { renderCommands(cb, imageIndex); };
+    VulkanContext::uploadManager->Submit();
+
+    VulkanContext::transientAllocator->BeginFrame(frameIndex);
+
+    const DeviceCommands deviceCommands = [&](vk::CommandBuffer cb)
+        {
+            VulkanContext::gpuProfiler->BeginFrame(cb, frameIndex);
+
+            renderCommands(cb, imageIndex);
+
+            VulkanContext::gpuProfiler->EndFrame(cb);
+        };
+
+    if (VulkanContext::swapchain->IsOffscreen())
+    {
+        const CommandBufferSync offscreenSync{ {}, {}, {}, renderingFence };
+
+        VulkanHelpers::SubmitCommandBuffer(queues.graphics, frame.commandBuffer, deviceCommands, offscreenSync);
+    }
+    else
+    {
+        CommandBufferSync sync = frame.sync;
+        sync.signalSemaphores = { GetRenderingCompleteSemaphore(imageIndex) };
+
+        VulkanHelpers::SubmitCommandBuffer(queues.graphics, frame.commandBuffer, deviceCommands, sync);
+
+        Present(imageIndex);
+    }
+
+    lastImageIndex = imageIndex;
+
+    const TimePoint frameEndTimePoint = std::chrono::high_resolution_clock::now();
 
-    VulkanHelpers::SubmitCommandBuffer(graphicsQueue, commandBuffer, deviceCommands, synchronization);
+    frame.startTimePoint = frameStartTimePoint;
+
+    stats.waitMiliseconds = Details::GetDeltaMiliseconds(waitStartTimePoint, waitEndTimePoint);
+    stats.cpuMiliseconds = Details::GetDeltaMiliseconds(frameStartTimePoint.value(), frameEndTimePoint)
+            - stats.waitMiliseconds;
+
+    frameStartTimePoint = frameEndTimePoint;
+
+    frameIndex = (frameIndex + 1) % frames.size();
+}
+
+void FrameLoop::CaptureLastImage(const Filepath& path) const
+{
+    Assert(VulkanContext::swapchain->IsOffscreen());
+    Assert(lastImageIndex.has_value());
+
+    VulkanContext::device->WaitIdle();
+
+    const vk::Image image = VulkanContext::swapchain->GetImages()[lastImageIndex.value()];
+    const vk::Extent2D& extent = VulkanContext::swapchain->GetExtent();
+
+    const Bytes data = ImageHelpers::ReadImage(image, vk::ImageLayout::ePresentSrcKHR);
+
+    Filesystem::CreateDirectories(Filepath(path.GetDirectory()));
+
+    const int width = static_cast<int>(extent.width);
+    const int height = static_cast<int>(extent.height);
+
+    const int result = stbi_write_png(path.GetAbsolute().c_str(), width, height, 4, data.data(), width * 4);
+    Assert(result != 0);
+
+    LogI << "Frame captured: " << path.GetAbsolute() << "\n";
+}
+
+uint32_t FrameLoop::AcquireImage(const Frame& frame)
+{
+    if (VulkanContext::swapchain->IsOffscreen())
+    {
+        if (!lastImageIndex.has_value())
+        {
+            return 0;
+        }
+
+        return (lastImageIndex.value() + 1) % VulkanContext::swapchain->GetImageCount();
+    }
+
+    const vk::Semaphore presentCompleteSemaphore = frame.sync.waitSemaphores.front();
+
+    const auto& [result, imageIndex] = VulkanContext::device->Get().acquireNextImageKHR(
+            VulkanContext::swapchain->Get(), Numbers::kMaxUint, presentCompleteSemaphore, nullptr);
+    Assert(result == vk::Result::eSuccess || result == vk::Result::eSuboptimalKHR);
+
+    return imageIndex;
+}
+
+// Swapchain recreation may change the image count, semaphores of the removed images are kept
+vk::Semaphore FrameLoop::GetRenderingCompleteSemaphore(uint32_t imageIndex)
+{
+    while (renderingCompleteSemaphores.size() <= imageIndex)
+    {
+        renderingCompleteSemaphores.push_back(VulkanHelpers::CreateSemaphore(VulkanContext::device->Get()));
+    }
+
+    return renderingCompleteSemaphores[imageIndex];
+}
+
+void FrameLoop::Present(uint32_t imageIndex) const
+{
+    const vk::SwapchainKHR swapchain = VulkanContext::swapchain->Get();
+    const vk::Semaphore renderingCompleteSemaphore = renderingCompleteSemaphores[imageIndex];
 
     const vk::PresentInfoKHR presentInfo(1, &renderingCompleteSemaphore,
             1, &swapchain, &imageIndex, nullptr);
 
-    const vk::Result presentResult = presentQueue.presentKHR(presentInfo);
+    const vk::Result presentResult = VulkanContext::device->GetQueues().present.presentKHR(presentInfo);
     Assert(presentResult == vk::Result::eSuccess);
+}
 
-    frameIndex = (frameIndex + 1) % frames.size();
+void FrameLoop::RetireCompletedFrames()
+{
+    const vk::Device device = VulkanContext::device->Get();
+
+    const TimePoint now = std::chrono::high_resolution_clock::now();
+
+    for (Frame& frame : frames)
+    {
+        if (frame.startTimePoint.has_value() && device.getFenceStatus(frame.sync.fence) == vk::Result::eSuccess)
+        {
+            RetireFrame(frame, now);
+        }
+    }
+}
+
+void FrameLoop::RetireFrame(Frame& frame, const TimePoint& completionTimePoint)
+{
+    stats.latencyMiliseconds = Details::GetDeltaMiliseconds(frame.startTimePoint.value(), completionTimePoint);
+
+    frame.startTimePoint = std::nullopt;
 }
@@ -53,9 +53,18 @@ void HybridRenderer::Render(vk::CommandBuffer commandBuffer, uint32_t imageIndex
 {
     if (scene)
     {
-        gBufferStage->Execute(commandBuffer, imageIndex);
-        lightingStage->Execute(commandBuffer, imageIndex);
-        forwardStage->Execute(commandBuffer, imageIndex);
+        {
+            const GpuScope gpuScope(commandBuffer, "GBufferStage");
+            gBufferStage->Execute(commandBuffer);
+        }
+        {
+            const GpuScope gpuScope(commandBuffer, "LightingStage");
+            lightingStage->Execute(commandBuffer, imageIndex);
+        }
+        {
+            const GpuScope gpuScope(commandBuffer, "ForwardStage");
+            forwardStage->Execute(commandBuffer, imageIndex);
+        }
     }
     else
     {
@@ -84,6 +93,11 @@ void HybridRenderer::Resize(const vk::Extent2D& extent) const
     forwardStage->Resize(gBufferStage->GetDepthImageView());
 }
 
+const SceneBVH::CullingStats& HybridRenderer::GetCullingStats() const
+{
+    return gBufferStage->GetCullingStats();
+}
+
 void HybridRenderer::HandleKeyInputEvent(const KeyInput& keyInput) const
 {
     if (keyInput.action == KeyAction::ePress)
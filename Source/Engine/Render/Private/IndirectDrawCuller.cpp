@@ -0,0 +1,355 @@
+#include <numeric>
+
+#include "Engine/Render/IndirectDrawCuller.hpp"
+
+#include "Engine/Camera.hpp"
+#include "Engine/Render/Vulkan/ComputePipeline.hpp"
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
+#include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
+#include "Engine/Scene/StorageComponents.hpp"
+#include "Engine/Scene/TransformHierarchy.hpp"
+
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kWorkGroupSize = 64;
+
+    struct PushConstants
+    {
+        std::array<glm::vec4, 6> frustumPlanes;
+        uint32_t objectCount;
+    };
+
+    static uint32_t GetBucketIndex(const std::vector<MaterialFlags>& bucketFlags, MaterialFlags materialFlags)
+    {
+        const auto it = std::ranges::find(bucketFlags, materialFlags);
+        Assert(it != bucketFlags.end());
+
+        return static_cast<uint32_t>(std::distance(bucketFlags.begin(), it));
+    }
+
+    // Objects follow the scene BVH order, so that spatially close objects are processed together
+    static std::vector<gpu::DrawObject> CollectObjects(const Scene& scene,
+            const std::vector<MaterialFlags>& bucketFlags)
+    {
+        const auto& materialComponent = scene.ctx().get<MaterialStorageComponent>();
+        const auto& geometryComponent = scene.ctx().get<GeometryStorageComponent>();
+        const auto& mergedGeometryComponent = scene.ctx().get<MergedGeometryStorageComponent>();
+
+        const std::vector<SceneBVH::Item>& items = scene.ctx().get<SceneBVH>().GetItems();
+
+        std::vector<gpu::DrawObject> objects;
+        objects.reserve(items.size());
+
+        for (const SceneBVH::Item& item : items)
+        {
+            const auto& tc = scene.get<TransformComponent>(item.entity);
+            const auto& ro = scene.get<RenderComponent>(item.entity).renderObjects[item.renderObject];
+
+            const Primitive& primitive = geometryComponent.primitives[ro.primitive];
+            const MergedGeometryStorageComponent::Range& range = mergedGeometryComponent.ranges[ro.primitive];
+
+            const MaterialFlags materialFlags = materialComponent.materials[ro.material].flags;
+
+            gpu::DrawObject object{};
+            object.transform = tc.worldTransform.GetMatrix();
+            object.bboxCenter = glm::vec4(primitive.bbox.GetCenter(), 0.0f);
+            object.bboxExtent = glm::vec4(primitive.bbox.GetSize() * 0.5f, 0.0f);
+            object.firstIndex = range.firstIndex;
+            object.indexCount = primitive.indexCount;
+            object.vertexOffset = range.vertexOffset;
+            object.materialIndex = ro.material;
+            object.bucketIndex = GetBucketIndex(bucketFlags, materialFlags);
+
+            objects.push_back(object);
+        }
+
+        return objects;
+    }
+
+    static vk::Buffer CreateDrawBuffer(uint32_t objectCount)
+    {
+        const BufferDescription description{
+            std::max(objectCount, 1u) * sizeof(gpu::DrawCommand),
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        };
+
+        return VulkanContext::bufferManager->CreateBuffer(description, BufferCreateFlags::kNone);
+    }
+
+    static vk::Buffer CreateCountBuffer(uint32_t bucketCount)
+    {
+        const BufferDescription description{
+            std::max(bucketCount, 1u) * sizeof(uint32_t),
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer
+                    | vk::BufferUsageFlagBits::eTransferDst,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        };
+
+        return VulkanContext::bufferManager->CreateBuffer(description, BufferCreateFlags::kNone);
+    }
+
+    static DescriptorSet CreateDescriptorSet(vk::Buffer objectBuffer, vk::Buffer drawBuffer, vk::Buffer countBuffer)
+    {
+        const DescriptorSetDescription descriptorSetDescription{
+            DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                vk::ShaderStageFlagBits::eCompute | vk::ShaderStageFlagBits::eVertex,
+                vk::DescriptorBindingFlags()
+            },
+            DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                vk::ShaderStageFlagBits::eCompute,
+                vk::DescriptorBindingFlags()
+            },
+            DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                vk::ShaderStageFlagBits::eCompute,
+                vk::DescriptorBindingFlags()
+            }
+        };
+
+        const DescriptorSetData descriptorSetData{
+            DescriptorHelpers::GetStorageData(objectBuffer),
+            DescriptorHelpers::GetStorageData(drawBuffer),
+            DescriptorHelpers::GetStorageData(countBuffer)
+        };
+
+        return DescriptorHelpers::CreateDescriptorSet(descriptorSetDescription, descriptorSetData);
+    }
+
+    // vkCmdUpdateBuffer is limited to 65536 bytes per command
+    static void UpdateObjectRange(vk::CommandBuffer commandBuffer, vk::Buffer objectBuffer,
+            const std::vector<gpu::DrawObject>& objects, uint32_t firstObject, uint32_t objectCount)
+    {
+        constexpr uint32_t maxObjectCount = 65536 / sizeof(gpu::DrawObject);
+
+        for (uint32_t i = 0; i < objectCount; i += maxObjectCount)
+        {
+            const uint32_t count = std::min(objectCount - i, maxObjectCount);
+
+            commandBuffer.updateBuffer(objectBuffer, (firstObject + i) * sizeof(gpu::DrawObject),
+                    count * sizeof(gpu::DrawObject), objects.data() + firstObject + i);
+        }
+    }
+
+    static std::unique_ptr<ComputePipeline> CreatePipeline(vk::DescriptorSetLayout descriptorSetLayout)
+    {
+        const ShaderModule shaderModule = VulkanContext::shaderManager->CreateShaderModule(
+                vk::ShaderStageFlagBits::eCompute, Filepath("~/Shaders/Hybrid/Culling.comp"),
+                {}, std::make_tuple(kWorkGroupSize));
+
+        const vk::PushConstantRange pushConstantRange(
+                vk::ShaderStageFlagBits::eCompute, 0, sizeof(PushConstants));
+
+        const ComputePipeline::Description description{
+            shaderModule, { descriptorSetLayout }, { pushConstantRange }
+        };
+
+        std::unique_ptr<ComputePipeline> pipeline = ComputePipeline::Create(description);
+
+        VulkanContext::shaderManager->DestroyShaderModule(shaderModule);
+
+        return pipeline;
+    }
+}
+
+IndirectDrawCuller::IndirectDrawCuller(const Scene& scene_, const std::vector<MaterialFlags>& bucketFlags)
+    : scene(&scene_)
+{
+    EASY_FUNCTION()
+
+    sceneVersion = scene->ctx().get<SceneBVH>().GetVersion();
+
+    objects = Details::CollectObjects(*scene, bucketFlags);
+
+    transformVersion = scene->ctx().get<TransformHierarchy>().GetVersion();
+
+    const std::vector<SceneBVH::Item>& items = scene->ctx().get<SceneBVH>().GetItems();
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(items.size()); ++i)
+    {
+        entityObjects[items[i].entity].push_back(i);
+    }
+
+    objectCount = static_cast<uint32_t>(objects.size());
+
+    bucketSizes.resize(bucketFlags.size(), 0);
+    bucketOffsets.resize(bucketFlags.size(), 0);
+
+    for (const gpu::DrawObject& object : objects)
+    {
+        ++bucketSizes[object.bucketIndex];
+    }
+
+    for (size_t i = 1; i < bucketOffsets.size(); ++i)
+    {
+        bucketOffsets[i] = bucketOffsets[i - 1] + bucketSizes[i - 1];
+    }
+
+    for (gpu::DrawObject& object : objects)
+    {
+        object.firstCommand = bucketOffsets[object.bucketIndex];
+    }
+
+    if (objects.empty())
+    {
+        objects.emplace_back();
+    }
+
+    objectBuffer = BufferHelpers::CreateBufferWithData(vk::BufferUsageFlagBits::eStorageBuffer, ByteView(objects));
+
+    drawBuffer = Details::CreateDrawBuffer(objectCount);
+    countBuffer = Details::CreateCountBuffer(static_cast<uint32_t>(bucketFlags.size()));
+
+    descriptorSet = Details::CreateDescriptorSet(objectBuffer, drawBuffer, countBuffer);
+
+    pipeline = Details::CreatePipeline(descriptorSet.layout);
+
+    LogI << "Indirect draw culler: " << objectCount << " objects in " << bucketFlags.size() << " buckets\n";
+}
+
+IndirectDrawCuller::~IndirectDrawCuller()
+{
+    DescriptorHelpers::DestroyDescriptorSet(descriptorSet);
+
+    VulkanContext::bufferManager->DestroyBuffer(objectBuffer);
+    VulkanContext::bufferManager->DestroyBuffer(drawBuffer);
+    VulkanContext::bufferManager->DestroyBuffer(countBuffer);
+}
+
+void IndirectDrawCuller::Cull(vk::CommandBuffer commandBuffer, const glm::mat4& viewProj)
+{
+    EASY_FUNCTION()
+
+    // Objects, commands and counts of the previous frame may still be consumed by culling and indirect draws
+    const PipelineBarrier previousDrawBarrier{
+        SyncScope::kIndirectCommandRead | SyncScope::kComputeShaderRead | SyncScope::kVertexShaderRead,
+        SyncScope::kTransferWrite | SyncScope::kComputeShaderWrite
+    };
+
+    VulkanHelpers::InsertMemoryBarrier(commandBuffer, previousDrawBarrier);
+
+    UpdateTransforms(commandBuffer);
+
+    commandBuffer.fillBuffer(countBuffer, 0, VK_WHOLE_SIZE, 0);
+
+    const PipelineBarrier clearBarrier{
+        SyncScope::kTransferWrite,
+        SyncScope::kComputeShaderRead | SyncScope::kComputeShaderWrite | SyncScope::kVertexShaderRead
+    };
+
+    VulkanHelpers::InsertMemoryBarrier(commandBuffer, clearBarrier);
+
+    const Details::PushConstants pushConstants{
+        CameraHelpers::GetFrustumPlanes(viewProj),
+        objectCount
+    };
+
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->Get());
+
+    commandBuffer.pushConstants<Details::PushConstants>(pipeline->GetLayout(),
+            vk::ShaderStageFlagBits::eCompute, 0, { pushConstants });
+
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+            pipeline->GetLayout(), 0, { descriptorSet.value }, {});
+
+    const uint32_t groupCount = (objectCount + Details::kWorkGroupSize - 1) / Details::kWorkGroupSize;
+
+    commandBuffer.dispatch(groupCount, 1, 1);
+
+    const PipelineBarrier cullingBarrier{
+        SyncScope::kComputeShaderWrite,
+        SyncScope::kIndirectCommandRead
+    };
+
+    VulkanHelpers::InsertMemoryBarrier(commandBuffer, cullingBarrier);
+}
+
+void IndirectDrawCuller::Draw(vk::CommandBuffer commandBuffer, uint32_t bucketIndex) const
+{
+    if (bucketSizes[bucketIndex] == 0)
+    {
+        return;
+    }
+
+    const auto& mergedGeometryComponent = scene->ctx().get<MergedGeometryStorageComponent>();
+
+    const BufferSlice& indexBuffer = mergedGeometryComponent.indexBuffer;
+    const BufferSlice& vertexBuffer = mergedGeometryComponent.vertexBuffer;
+
+    commandBuffer.bindIndexBuffer(indexBuffer.buffer, indexBuffer.offset, vk::IndexType::eUint32);
+    commandBuffer.bindVertexBuffers(0, { vertexBuffer.buffer }, { vertexBuffer.offset });
+
+    commandBuffer.drawIndexedIndirectCountKHR(drawBuffer,
+            bucketOffsets[bucketIndex] * sizeof(gpu::DrawCommand),
+            countBuffer, bucketIndex * sizeof(uint32_t),
+            bucketSizes[bucketIndex], sizeof(gpu::DrawCommand));
+}
+
+void IndirectDrawCuller::UpdateTransforms(vk::CommandBuffer commandBuffer)
+{
+    const TransformHierarchy& transformHierarchy = scene->ctx().get<TransformHierarchy>();
+
+    if (transformHierarchy.GetVersion() == transformVersion)
+    {
+        return;
+    }
+
+    std::vector<uint32_t> changedObjects;
+
+    if (transformHierarchy.GetVersion() == transformVersion + 1)
+    {
+        for (const entt::entity entity : transformHierarchy.GetUpdatedEntities())
+        {
+            const auto it = entityObjects.find(entity);
+
+            if (it != entityObjects.end())
+            {
+                std::ranges::copy(it->second, std::back_inserter(changedObjects));
+            }
+        }
+
+        std::ranges::sort(changedObjects);
+    }
+    else
+    {
+        // Updated entities are only known for the last update, the ones of skipped frames are lost
+        changedObjects.resize(objectCount);
+        std::iota(changedObjects.begin(), changedObjects.end(), 0);
+    }
+
+    transformVersion = transformHierarchy.GetVersion();
+
+    const std::vector<SceneBVH::Item>& items = scene->ctx().get<SceneBVH>().GetItems();
+
+    for (const uint32_t i : changedObjects)
+    {
+        objects[i].transform = scene->get<TransformComponent>(items[i].entity).worldTransform.GetMatrix();
+    }
+
+    size_t rangeBegin = 0;
+
+    for (size_t i = 1; i <= changedObjects.size(); ++i)
+    {
+        if (i == changedObjects.size() || changedObjects[i] != changedObjects[i - 1] + 1)
+        {
+            const uint32_t firstObject = changedObjects[rangeBegin];
+            const uint32_t rangeSize = static_cast<uint32_t>(i - rangeBegin);
+
+            Details::UpdateObjectRange(commandBuffer, objectBuffer, objects, firstObject, rangeSize);
+
+            rangeBegin = i;
+        }
+    }
+}
+
+void IndirectDrawCuller::ReloadShaders()
+{
+    pipeline = Details::CreatePipeline(descriptorSet.layout);
+}
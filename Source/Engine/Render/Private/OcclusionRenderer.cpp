@@ -294,8 +294,10 @@ void OcclusionRenderer::Render(vk::CommandBuffer commandBuffer) const
         {
             const Primitive& primitive = geometryComponent.primitives[ro.primitive];
 
-            commandBuffer.bindIndexBuffer(primitive.indexBuffer, 0, primitive.indexType);
-            commandBuffer.bindVertexBuffers(0, { primitive.vertexBuffer }, { 0 });
+            commandBuffer.bindIndexBuffer(primitive.indexBuffer.buffer,
+                    primitive.indexBuffer.offset, primitive.indexType);
+            commandBuffer.bindVertexBuffers(0,
+                    { primitive.vertexBuffer.buffer }, { primitive.vertexBuffer.offset });
 
             commandBuffer.pushConstants<glm::mat4>(pipeline->GetLayout(),
                     vk::ShaderStageFlagBits::eVertex, 0, { tc.worldTransform.GetMatrix() });
@@ -91,13 +91,41 @@ namespace Details
         return MultiDescriptorSet{ descriptorSetLayout, {} };
     }
 
-    static CameraData CreateCameraData(uint32_t bufferCount)
+    static CameraData CreateCameraData()
     {
-        constexpr vk::DeviceSize bufferSize = sizeof(gpu::CameraPT);
+        const DescriptorSet descriptorSet = RenderHelpers::CreateTransientDescriptorSet(
+                sizeof(gpu::CameraPT), vk::ShaderStageFlagBits::eRaygenKHR);
 
-        constexpr vk::ShaderStageFlags shaderStages = vk::ShaderStageFlagBits::eRaygenKHR;
+        return CameraData{ {}, MultiDescriptorSet{ descriptorSet.layout, { descriptorSet.value } } };
+    }
+
+    static CameraData CreateLayerCameraData(uint32_t layerCount)
+    {
+        const vk::Buffer buffer = BufferHelpers::CreateEmptyBuffer(
+                vk::BufferUsageFlagBits::eStorageBuffer, sizeof(gpu::CameraPT) * layerCount);
+
+        const DescriptorDescription descriptorDescription{
+            1, vk::DescriptorType::eStorageBuffer,
+            vk::ShaderStageFlagBits::eRaygenKHR,
+            vk::DescriptorBindingFlags()
+        };
+
+        const DescriptorSetData descriptorSetData{ DescriptorHelpers::GetStorageData(buffer) };
+
+        const MultiDescriptorSet descriptorSet = DescriptorHelpers::CreateMultiDescriptorSet(
+                { descriptorDescription }, { descriptorSetData });
 
-        return RenderHelpers::CreateCameraData(bufferCount, bufferSize, shaderStages);
+        return CameraData{ { buffer }, descriptorSet };
+    }
+
+    static gpu::CameraPT GetCameraShaderData(const CameraComponent& cameraComponent)
+    {
+        return gpu::CameraPT{
+            glm::inverse(cameraComponent.viewMatrix),
+            glm::inverse(cameraComponent.projMatrix),
+            cameraComponent.projection.zNear,
+            cameraComponent.projection.zFar
+        };
     }
 
     static DescriptorSet CreateSceneDescriptorSet(const Scene& scene)
@@ -153,6 +181,11 @@ namespace Details
                 primitiveCount, vk::DescriptorType::eStorageBuffer,
                 primitiveShaderStages,
                 vk::DescriptorBindingFlags()
+            },
+            DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                primitiveShaderStages,
+                vk::DescriptorBindingFlags()
             }
         };
 
@@ -164,6 +197,7 @@ namespace Details
             DescriptorHelpers::GetData(textureComponent.textures),
             DescriptorHelpers::GetStorageData(rayTracingComponent.indexBuffers),
             DescriptorHelpers::GetStorageData(rayTracingComponent.vertexBuffers),
+            DescriptorHelpers::GetStorageData(renderComponent.instanceBuffer),
         };
 
         return DescriptorHelpers::CreateDescriptorSet(descriptorSetDescription, descriptorSetData);
@@ -241,6 +275,7 @@ namespace Details
 PathTracingRenderer::PathTracingRenderer()
     : isProbeRenderer(false)
     , sampleCount(Details::kDefaultSampleCount)
+    , layerCount(1)
 {
     EASY_FUNCTION()
 
@@ -249,7 +284,7 @@ PathTracingRenderer::PathTracingRenderer()
     renderTargets.descriptorSet = Details::CreateRenderTargetsDescriptorSet(
             renderTargets.accumulationTexture.view, UseSwapchainRenderTarget());
 
-    cameraData = Details::CreateCameraData(VulkanContext::swapchain->GetImageCount());
+    cameraData = Details::CreateCameraData();
 
     Engine::AddEventHandler<KeyInput>(EventType::eKeyInput,
             MakeFunction(this, &PathTracingRenderer::HandleKeyInputEvent));
@@ -307,20 +342,38 @@ void PathTracingRenderer::RemoveScene()
     scene = nullptr;
 }
 
-PathTracingRenderer::PathTracingRenderer(uint32_t sampleCount_, const vk::Extent2D& extent)
+PathTracingRenderer::PathTracingRenderer(uint32_t sampleCount_, const vk::Extent2D& extent, uint32_t layerCount_)
     : isProbeRenderer(true)
     , sampleCount(sampleCount_)
+    , layerCount(layerCount_)
 {
     renderTargets.extent = extent;
     renderTargets.descriptorSet = Details::CreateRenderTargetsDescriptorSet(
             renderTargets.accumulationTexture.view, UseSwapchainRenderTarget());
 
-    cameraData = Details::CreateCameraData(ImageHelpers::kCubeFaceCount);
+    cameraData = Details::CreateLayerCameraData(layerCount);
 }
 
-const CameraComponent& PathTracingRenderer::GetCameraComponent() const
+void PathTracingRenderer::RenderLayers(vk::CommandBuffer commandBuffer,
+        const std::vector<CameraComponent>& layerCameras)
 {
-    return scene->ctx().get<CameraComponent>();
+    Assert(isProbeRenderer && scene);
+    Assert(!layerCameras.empty() && layerCameras.size() <= layerCount);
+
+    std::vector<gpu::CameraPT> camerasShaderData;
+    camerasShaderData.reserve(layerCameras.size());
+
+    for (const CameraComponent& cameraComponent : layerCameras)
+    {
+        camerasShaderData.push_back(Details::GetCameraShaderData(cameraComponent));
+    }
+
+    const SyncScope& storageReadSyncScope = SyncScope::kRayTracingShaderRead;
+
+    BufferHelpers::UpdateBuffer(commandBuffer, cameraData.buffers.front(),
+            ByteView(camerasShaderData), storageReadSyncScope, storageReadSyncScope);
+
+    TraceRays(commandBuffer, 0, static_cast<uint32_t>(layerCameras.size()), {});
 }
 
 void PathTracingRenderer::Render(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
@@ -344,35 +397,11 @@ void PathTracingRenderer::Render(vk::CommandBuffer commandBuffer, uint32_t image
 
     if (scene)
     {
-        UpdateCameraBuffer(commandBuffer, imageIndex);
-
-        const std::vector<vk::DescriptorSet> descriptorSets{
-            renderTargets.descriptorSet.values[imageIndex],
-            cameraData.descriptorSet.values[imageIndex],
-            sceneDescriptorSet.value
-        };
-
-        commandBuffer.bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, rayTracingPipeline->Get());
-
-        if (AccumulationEnabled())
-        {
-            commandBuffer.pushConstants<uint32_t>(rayTracingPipeline->GetLayout(),
-                    vk::ShaderStageFlagBits::eRaygenKHR, 0, { accumulationIndex++ });
-        }
-
-        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eRayTracingKHR,
-                rayTracingPipeline->GetLayout(), 0, descriptorSets, {});
-
-        const ShaderBindingTable& sbt = rayTracingPipeline->GetShaderBindingTable();
+        const GpuScope gpuScope(commandBuffer, "PathTracing");
 
-        const vk::DeviceAddress bufferAddress = VulkanContext::device->GetAddress(sbt.buffer);
+        const uint32_t cameraOffset = UpdateCameraData();
 
-        const vk::StridedDeviceAddressRegionKHR raygenSBT(bufferAddress + sbt.raygenOffset, sbt.stride, sbt.stride);
-        const vk::StridedDeviceAddressRegionKHR missSBT(bufferAddress + sbt.missOffset, sbt.stride, sbt.stride);
-        const vk::StridedDeviceAddressRegionKHR hitSBT(bufferAddress + sbt.hitOffset, sbt.stride, sbt.stride);
-
-        commandBuffer.traceRaysKHR(raygenSBT, missSBT, hitSBT, vk::StridedDeviceAddressRegionKHR(),
-                renderTargets.extent.width, renderTargets.extent.height, 1);
+        TraceRays(commandBuffer, imageIndex, 1, { cameraOffset });
     }
 
     if (UseSwapchainRenderTarget())
@@ -412,24 +441,53 @@ void PathTracingRenderer::Resize(const vk::Extent2D& extent)
             renderTargets.accumulationTexture.view, UseSwapchainRenderTarget());
 }
 
+const CameraComponent& PathTracingRenderer::GetCameraComponent() const
+{
+    return scene->ctx().get<CameraComponent>();
+}
+
 std::vector<vk::DescriptorSetLayout> PathTracingRenderer::GetDescriptorSetLayouts() const
 {
     return { renderTargets.descriptorSet.layout, cameraData.descriptorSet.layout, sceneDescriptorSet.layout };
 }
 
-void PathTracingRenderer::UpdateCameraBuffer(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+uint32_t PathTracingRenderer::UpdateCameraData() const
 {
-    const gpu::CameraPT cameraShaderData{
-        glm::inverse(GetCameraComponent().viewMatrix),
-        glm::inverse(GetCameraComponent().projMatrix),
-        GetCameraComponent().projection.zNear,
-        GetCameraComponent().projection.zFar
+    const gpu::CameraPT cameraShaderData = Details::GetCameraShaderData(GetCameraComponent());
+
+    return VulkanContext::transientAllocator->Allocate(ByteView(cameraShaderData));
+}
+
+void PathTracingRenderer::TraceRays(vk::CommandBuffer commandBuffer, uint32_t descriptorSetIndex, uint32_t depth,
+        const std::vector<uint32_t>& cameraOffsets)
+{
+    const std::vector<vk::DescriptorSet> descriptorSets{
+        renderTargets.descriptorSet.values[descriptorSetIndex],
+        cameraData.descriptorSet.values.front(),
+        sceneDescriptorSet.value
     };
 
-    const SyncScope& uniformReadSyncScope = SyncScope::kRayTracingUniformRead;
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eRayTracingKHR, rayTracingPipeline->Get());
+
+    if (AccumulationEnabled())
+    {
+        commandBuffer.pushConstants<uint32_t>(rayTracingPipeline->GetLayout(),
+                vk::ShaderStageFlagBits::eRaygenKHR, 0, { accumulationIndex++ });
+    }
+
+    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eRayTracingKHR,
+            rayTracingPipeline->GetLayout(), 0, descriptorSets, cameraOffsets);
+
+    const ShaderBindingTable& sbt = rayTracingPipeline->GetShaderBindingTable();
+
+    const vk::DeviceAddress bufferAddress = VulkanContext::device->GetAddress(sbt.buffer);
+
+    const vk::StridedDeviceAddressRegionKHR raygenSBT(bufferAddress + sbt.raygenOffset, sbt.stride, sbt.stride);
+    const vk::StridedDeviceAddressRegionKHR missSBT(bufferAddress + sbt.missOffset, sbt.stride, sbt.stride);
+    const vk::StridedDeviceAddressRegionKHR hitSBT(bufferAddress + sbt.hitOffset, sbt.stride, sbt.stride);
 
-    BufferHelpers::UpdateBuffer(commandBuffer, cameraData.buffers[imageIndex],
-            ByteView(cameraShaderData), uniformReadSyncScope, uniformReadSyncScope);
+    commandBuffer.traceRaysKHR(raygenSBT, missSBT, hitSBT, vk::StridedDeviceAddressRegionKHR(),
+            renderTargets.extent.width, renderTargets.extent.height, depth);
 }
 
 void PathTracingRenderer::HandleKeyInputEvent(const KeyInput& keyInput)
@@ -5,12 +5,6 @@
 
 namespace Details
 {
-    constexpr uint32_t kSampleCount = 16;
-
-    constexpr vk::Format kProbeFormat = vk::Format::eR16G16B16A16Sfloat;
-
-    constexpr vk::Extent2D kProbeExtent(32, 32);
-
     constexpr CameraProjection kCameraProjection{
         .yFov = glm::radians(90.0f),
         .width = 1.0f,
@@ -19,14 +13,15 @@ namespace Details
         .zFar = 1000.0f
     };
 
-    static vk::Image CreateProbeImage()
+    static vk::Image CreateProbesImage(uint32_t probeCount)
     {
-        constexpr vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
+        constexpr vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eStorage
+                | vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferSrc;
 
         const ImageDescription imageDescription{
-            ImageType::eCube, kProbeFormat,
-            VulkanHelpers::GetExtent3D(kProbeExtent),
-            1, ImageHelpers::kCubeFaceCount,
+            ImageType::eCube, ProbeRenderer::kProbeFormat,
+            VulkanHelpers::GetExtent3D(ProbeRenderer::kProbeExtent),
+            1, probeCount * ImageHelpers::kCubeFaceCount,
             vk::SampleCountFlagBits::e1,
             vk::ImageTiling::eOptimal, usage,
             vk::MemoryPropertyFlagBits::eDeviceLocal
@@ -51,29 +46,76 @@ namespace Details
 
         return glm::cross(direction, Direction::kRight);
     }
+
+    static vk::ImageSubresourceRange GetProbesRange(uint32_t probeCount)
+    {
+        return vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor,
+                0, 1, 0, probeCount * ImageHelpers::kCubeFaceCount);
+    }
 }
 
-ProbeRenderer::ProbeRenderer(const Scene* scene_)
-    : PathTracingRenderer(Details::kSampleCount, Details::kProbeExtent)
+ProbeRenderer::ProbeRenderer(const Scene* scene_, uint32_t batchSize_)
+    : PathTracingRenderer(kSampleCount, kProbeExtent, batchSize_ * ImageHelpers::kCubeFaceCount)
+    , batchSize(batchSize_)
 {
+    Assert(batchSize > 0);
+
     RegisterScene(scene_);
 
     cameraComponent.projection = Details::kCameraProjection;
     cameraComponent.projMatrix = CameraHelpers::CalculateProjMatrix(cameraComponent.projection);
+
+    renderTargets.descriptorSet.values = VulkanContext::descriptorPool->AllocateDescriptorSets(
+            { renderTargets.descriptorSet.layout });
 }
 
 Texture ProbeRenderer::CaptureProbe(const glm::vec3& position)
+{
+    const vk::Image probeImage = CaptureProbes({ position });
+
+    const vk::ImageView probeView = VulkanContext::imageManager->CreateView(
+            probeImage, vk::ImageViewType::eCube, ImageHelpers::kCubeColor);
+
+    return Texture{ probeImage, probeView };
+}
+
+vk::Image ProbeRenderer::CaptureProbes(const std::vector<glm::vec3>& positions)
 {
     EASY_FUNCTION()
 
-    const vk::Image probeImage = Details::CreateProbeImage();
+    Assert(!positions.empty() && positions.size() <= batchSize);
+
+    const uint32_t probeCount = static_cast<uint32_t>(positions.size());
+
+    const vk::Image probesImage = Details::CreateProbesImage(probeCount);
+
+    const vk::ImageSubresourceRange probesRange = Details::GetProbesRange(probeCount);
+
+    const vk::ImageView probesView = VulkanContext::imageManager->CreateView(
+            probesImage, vk::ImageViewType::e2DArray, probesRange);
 
-    const ImageHelpers::CubeFacesViews probeFacesViews
-            = ImageHelpers::CreateCubeFacesViews(probeImage, 0);
+    const DescriptorData descriptorData = DescriptorHelpers::GetStorageData(probesView);
+
+    VulkanContext::descriptorPool->UpdateDescriptorSet(renderTargets.descriptorSet.values.front(),
+            { descriptorData }, 0);
+
+    std::vector<CameraComponent> layerCameras;
+    layerCameras.reserve(probesRange.layerCount);
+
+    for (const glm::vec3& position : positions)
+    {
+        cameraComponent.location.position = position;
+
+        for (uint32_t faceIndex = 0; faceIndex < ImageHelpers::kCubeFaceCount; ++faceIndex)
+        {
+            cameraComponent.location.up = Details::GetCameraUp(faceIndex);
+            cameraComponent.location.direction = Details::GetCameraDirection(faceIndex);
 
-    SetupRenderTargetsDescriptorSet(probeFacesViews);
+            cameraComponent.viewMatrix = CameraHelpers::CalculateViewMatrix(cameraComponent.location);
 
-    cameraComponent.location.position = position;
+            layerCameras.push_back(cameraComponent);
+        }
+    }
 
     VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
         {
@@ -87,19 +129,10 @@ Texture ProbeRenderer::CaptureProbe(const glm::vec3& position)
                     }
                 };
 
-                ImageHelpers::TransitImageLayout(commandBuffer, probeImage,
-                        ImageHelpers::kCubeColor, layoutTransition);
+                ImageHelpers::TransitImageLayout(commandBuffer, probesImage, probesRange, layoutTransition);
             }
 
-            for (uint32_t faceIndex = 0; faceIndex < ImageHelpers::kCubeFaceCount; ++faceIndex)
-            {
-                cameraComponent.location.up = Details::GetCameraUp(faceIndex);
-                cameraComponent.location.direction = Details::GetCameraDirection(faceIndex);
-
-                cameraComponent.viewMatrix = CameraHelpers::CalculateViewMatrix(cameraComponent.location);
-
-                PathTracingRenderer::Render(commandBuffer, faceIndex);
-            }
+            PathTracingRenderer::RenderLayers(commandBuffer, layerCameras);
 
             {
                 const ImageLayoutTransition layoutTransition{
@@ -111,44 +144,11 @@ Texture ProbeRenderer::CaptureProbe(const glm::vec3& position)
                     }
                 };
 
-                ImageHelpers::TransitImageLayout(commandBuffer, probeImage,
-                        ImageHelpers::kCubeColor, layoutTransition);
+                ImageHelpers::TransitImageLayout(commandBuffer, probesImage, probesRange, layoutTransition);
             }
         });
 
-    for (const auto& view : probeFacesViews)
-    {
-        VulkanContext::imageManager->DestroyImageView(probeImage, view);
-    }
-
-    const vk::ImageView probeView = VulkanContext::imageManager->CreateView(
-            probeImage, vk::ImageViewType::eCube, ImageHelpers::kCubeColor);
-
-    return Texture{ probeImage, probeView };
-}
-
-void ProbeRenderer::SetupRenderTargetsDescriptorSet(
-        const ImageHelpers::CubeFacesViews& probeFacesViews)
-{
-    if (!renderTargets.descriptorSet.values.empty())
-    {
-        VulkanContext::descriptorPool->FreeDescriptorSets(renderTargets.descriptorSet.values);
-    }
-
-    const DescriptorPool& descriptorPool = *VulkanContext::descriptorPool;
-
-    renderTargets.descriptorSet.values = descriptorPool.AllocateDescriptorSets(
-            Repeat(renderTargets.descriptorSet.layout, probeFacesViews.size()));
+    VulkanContext::imageManager->DestroyImageView(probesImage, probesView);
 
-    for (size_t i = 0; i < probeFacesViews.size(); ++i)
-    {
-        const DescriptorData descriptorData = DescriptorHelpers::GetStorageData(probeFacesViews[i]);
-
-        descriptorPool.UpdateDescriptorSet(renderTargets.descriptorSet.values[i], { descriptorData, }, 0);
-    }
-}
-
-const CameraComponent& ProbeRenderer::GetCameraComponent() const
-{
-    return cameraComponent;
+    return probesImage;
 }
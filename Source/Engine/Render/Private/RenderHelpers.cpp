@@ -1,35 +1,19 @@
 #include "Engine/Render/RenderHelpers.hpp"
 
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
-#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
 
-CameraData RenderHelpers::CreateCameraData(uint32_t bufferCount,
-        vk::DeviceSize bufferSize, vk::ShaderStageFlags shaderStages)
+DescriptorSet RenderHelpers::CreateTransientDescriptorSet(vk::DeviceSize size, vk::ShaderStageFlags shaderStages)
 {
-    std::vector<vk::Buffer> buffers(bufferCount);
-
     const DescriptorDescription descriptorDescription{
-        1, vk::DescriptorType::eUniformBuffer,
+        1, vk::DescriptorType::eUniformBufferDynamic,
         shaderStages,
         vk::DescriptorBindingFlags()
     };
 
-    std::vector<DescriptorSetData> multiDescriptorSetData(bufferCount);
-
-    for (uint32_t i = 0; i < bufferCount; ++i)
-    {
-        buffers[i] = BufferHelpers::CreateEmptyBuffer(
-                vk::BufferUsageFlagBits::eUniformBuffer, bufferSize);
-
-        const DescriptorData descriptorData = DescriptorHelpers::GetData(buffers[i]);
-
-        multiDescriptorSetData[i] = DescriptorSetData{ descriptorData };
-    }
-
-    const MultiDescriptorSet descriptorSet = DescriptorHelpers::CreateMultiDescriptorSet(
-            { descriptorDescription }, multiDescriptorSetData);
+    const DescriptorData descriptorData = DescriptorHelpers::GetDynamicData(
+            VulkanContext::transientAllocator->GetBuffer(), size);
 
-    return CameraData{ buffers, descriptorSet };
+    return DescriptorHelpers::CreateDescriptorSet({ descriptorDescription }, { descriptorData });
 }
 
 vk::Rect2D RenderHelpers::GetSwapchainRenderArea()
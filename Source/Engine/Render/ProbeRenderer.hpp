@@ -8,15 +8,24 @@ class ProbeRenderer
         : PathTracingRenderer
 {
 public:
-    ProbeRenderer(const Scene* scene_);
+    static constexpr uint32_t kSampleCount = 16;
+
+    static constexpr vk::Extent2D kProbeExtent = vk::Extent2D(32, 32);
+
+    static constexpr vk::Format kProbeFormat = vk::Format::eR16G16B16A16Sfloat;
+
+    ProbeRenderer(const Scene* scene_, uint32_t batchSize_ = 1);
+
+    uint32_t GetBatchSize() const { return batchSize; }
 
     Texture CaptureProbe(const glm::vec3& position);
 
-private:
-    CameraComponent cameraComponent;
+    // Captures up to batchSize probes with a single dispatch and submit into a cube compatible image,
+    // faces of the probe i are stored in layers [i * kCubeFaceCount, (i + 1) * kCubeFaceCount)
+    vk::Image CaptureProbes(const std::vector<glm::vec3>& positions);
 
-    void SetupRenderTargetsDescriptorSet(
-            const ImageHelpers::CubeFacesViews& probeFacesViews);
+private:
+    const uint32_t batchSize;
 
-    const CameraComponent& GetCameraComponent() const override;
+    CameraComponent cameraComponent;
 };
@@ -10,8 +10,8 @@ struct CameraData
 
 namespace RenderHelpers
 {
-    CameraData CreateCameraData(uint32_t bufferCount,
-            vk::DeviceSize bufferSize, vk::ShaderStageFlags shaderStages);
+    // Dynamic uniform buffer in the transient allocator, offsets are provided when binding
+    DescriptorSet CreateTransientDescriptorSet(vk::DeviceSize size, vk::ShaderStageFlags shaderStages);
 
     vk::Rect2D GetSwapchainRenderArea();
 
@@ -55,8 +55,7 @@ private:
     std::unique_ptr<RenderPass> renderPass;
     std::vector<vk::Framebuffer> framebuffers;
 
-    CameraData defaultCameraData;
-    CameraData environmentCameraData;
+    DescriptorSet cameraDescriptorSet;
 
     EnvironmentData environmentData;
     LightVolumeData lightVolumeData;
@@ -70,8 +69,8 @@ private:
     std::vector<vk::DescriptorSetLayout> GetEnvironmentDescriptorSetLayout() const;
     std::vector<vk::DescriptorSetLayout> GetLightVolumeDescriptorSetLayout() const;
 
-    void DrawEnvironment(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
-    void DrawLightVolume(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
+    void DrawEnvironment(vk::CommandBuffer commandBuffer, uint32_t cameraOffset) const;
+    void DrawLightVolume(vk::CommandBuffer commandBuffer, uint32_t cameraOffset) const;
 
     void HandleKeyInputEvent(const KeyInput& keyInput);
 };
@@ -2,8 +2,10 @@
 
 #include "Engine/Render/RenderHelpers.hpp"
 #include "Engine/Scene/Material.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
 
 class Scene;
+class IndirectDrawCuller;
 class RenderPass;
 class GraphicsPipeline;
 struct Texture;
@@ -33,12 +35,14 @@ public:
 
     void RemoveScene();
 
-    void Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
+    void Execute(vk::CommandBuffer commandBuffer);
 
     void Resize();
 
     void ReloadShaders();
 
+    const SceneBVH::CullingStats& GetCullingStats() const { return cullingStats; }
+
 private:
     struct MaterialPipeline
     {
@@ -46,21 +50,43 @@ private:
         std::unique_ptr<GraphicsPipeline> pipeline;
     };
 
+    struct DrawItem
+    {
+        uint32_t item = 0; // index in SceneBVH::GetItems()
+        uint32_t material = 0;
+        uint32_t primitive = 0;
+    };
+
     static std::vector<MaterialPipeline> CreateMaterialPipelines(
             const Scene& scene, const RenderPass& renderPass,
             const std::vector<vk::DescriptorSetLayout>& layouts);
 
+    static std::vector<std::vector<DrawItem>> CreateDrawBuckets(
+            const Scene& scene, const std::vector<MaterialFlags>& bucketFlags);
+
     const Scene* scene = nullptr;
 
     std::unique_ptr<RenderPass> renderPass;
     std::vector<Texture> renderTargets;
     vk::Framebuffer framebuffer;
 
-    CameraData cameraData;
+    DescriptorSet cameraDescriptorSet;
     DescriptorSet materialDescriptorSet;
     std::vector<MaterialPipeline> materialPipelines;
 
+    // Draw items of every material pipeline sorted by material and primitive, CPU draw path only.
+    // Rebuilt whenever the scene BVH is rebuilt, since draw items refer to its items.
+    std::vector<std::vector<DrawItem>> drawBuckets;
+    std::optional<uint32_t> drawBucketsVersion;
+
+    std::unique_ptr<IndirectDrawCuller> indirectDrawCuller;
+
+    SceneBVH::CullingStats cullingStats;
+
     std::vector<vk::DescriptorSetLayout> GetDescriptorSetLayouts() const;
 
-    void DrawScene(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const;
+    void DrawScene(vk::CommandBuffer commandBuffer, uint32_t cameraOffset,
+            const std::vector<uint32_t>& visibleItems) const;
+
+    void DrawSceneIndirect(vk::CommandBuffer commandBuffer, uint32_t cameraOffset) const;
 };
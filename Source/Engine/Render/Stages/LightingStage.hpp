@@ -31,7 +31,7 @@ private:
     DescriptorSet lightingDescriptorSet;
     DescriptorSet rayTracingDescriptorSet;
 
-    CameraData cameraData;
+    DescriptorSet cameraDescriptorSet;
 
     std::unique_ptr<ComputePipeline> pipeline;
 
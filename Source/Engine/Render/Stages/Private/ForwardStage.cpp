@@ -91,15 +91,13 @@ namespace Details
                 extent, { swapchainImageViews }, { depthImageView });
     }
 
-    static CameraData CreateCameraData()
+    static DescriptorSet CreateCameraDescriptorSet()
     {
-        const uint32_t bufferCount = VulkanContext::swapchain->GetImageCount();
-
         constexpr vk::DeviceSize bufferSize = sizeof(glm::mat4);
 
         constexpr vk::ShaderStageFlags shaderStages = vk::ShaderStageFlagBits::eVertex;
 
-        return RenderHelpers::CreateCameraData(bufferCount, bufferSize, shaderStages);
+        return RenderHelpers::CreateTransientDescriptorSet(bufferSize, shaderStages);
     }
 
     static std::unique_ptr<GraphicsPipeline> CreateEnvironmentPipeline(const RenderPass& renderPass,
@@ -239,8 +237,7 @@ ForwardStage::ForwardStage(vk::ImageView depthImageView)
     renderPass = Details::CreateRenderPass();
     framebuffers = Details::CreateFramebuffers(*renderPass, depthImageView);
 
-    defaultCameraData = Details::CreateCameraData();
-    environmentCameraData = Details::CreateCameraData();
+    cameraDescriptorSet = Details::CreateCameraDescriptorSet();
 
     Engine::AddEventHandler<KeyInput>(EventType::eKeyInput,
             MakeFunction(this, &ForwardStage::HandleKeyInputEvent));
@@ -250,17 +247,7 @@ ForwardStage::~ForwardStage()
 {
     RemoveScene();
 
-    DescriptorHelpers::DestroyMultiDescriptorSet(defaultCameraData.descriptorSet);
-    for (const auto& buffer : defaultCameraData.buffers)
-    {
-        VulkanContext::bufferManager->DestroyBuffer(buffer);
-    }
-
-    DescriptorHelpers::DestroyMultiDescriptorSet(environmentCameraData.descriptorSet);
-    for (const auto& buffer : environmentCameraData.buffers)
-    {
-        VulkanContext::bufferManager->DestroyBuffer(buffer);
-    }
+    DescriptorHelpers::DestroyDescriptorSet(cameraDescriptorSet);
 
     for (const auto& framebuffer : framebuffers)
     {
@@ -324,12 +311,11 @@ void ForwardStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
     const glm::mat4& proj = cameraComponent.projMatrix;
 
     const glm::mat4 defaultViewProj = proj * view;
-    BufferHelpers::UpdateBuffer(commandBuffer, defaultCameraData.buffers[imageIndex],
-            ByteView(defaultViewProj), SyncScope::kWaitForNone, SyncScope::kVertexUniformRead);
+    const uint32_t defaultCameraOffset = VulkanContext::transientAllocator->Allocate(ByteView(defaultViewProj));
 
     const glm::mat4 environmentViewProj = proj * glm::mat4(glm::mat3(view));
-    BufferHelpers::UpdateBuffer(commandBuffer, environmentCameraData.buffers[imageIndex],
-            ByteView(environmentViewProj), SyncScope::kWaitForNone, SyncScope::kVertexUniformRead);
+    const uint32_t environmentCameraOffset = VulkanContext::transientAllocator->Allocate(
+            ByteView(environmentViewProj));
 
     const vk::Rect2D renderArea = RenderHelpers::GetSwapchainRenderArea();
     const std::vector<vk::ClearValue> clearValues = Details::GetClearValues();
@@ -342,10 +328,10 @@ void ForwardStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
 
     if (drawLightVolume)
     {
-        DrawLightVolume(commandBuffer, imageIndex);
+        DrawLightVolume(commandBuffer, defaultCameraOffset);
     }
 
-    DrawEnvironment(commandBuffer, imageIndex);
+    DrawEnvironment(commandBuffer, environmentCameraOffset);
 }
 
 void ForwardStage::Resize(vk::ImageView depthImageView)
@@ -453,21 +439,21 @@ ForwardStage::LightVolumeData ForwardStage::CreateLightVolumeData(const Scene& s
 
 std::vector<vk::DescriptorSetLayout> ForwardStage::GetEnvironmentDescriptorSetLayout() const
 {
-    return { environmentCameraData.descriptorSet.layout, environmentData.descriptorSet.layout };
+    return { cameraDescriptorSet.layout, environmentData.descriptorSet.layout };
 }
 
 std::vector<vk::DescriptorSetLayout> ForwardStage::GetLightVolumeDescriptorSetLayout() const
 {
-    return { defaultCameraData.descriptorSet.layout, lightVolumeData.positionsDescriptorSet.layout };
+    return { cameraDescriptorSet.layout, lightVolumeData.positionsDescriptorSet.layout };
 }
 
-void ForwardStage::DrawEnvironment(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+void ForwardStage::DrawEnvironment(vk::CommandBuffer commandBuffer, uint32_t cameraOffset) const
 {
     const vk::Rect2D renderArea = RenderHelpers::GetSwapchainRenderArea();
     const vk::Viewport viewport = RenderHelpers::GetSwapchainViewport();
 
     const std::vector<vk::DescriptorSet> environmentDescriptorSets{
-        environmentCameraData.descriptorSet.values[imageIndex],
+        cameraDescriptorSet.value,
         environmentData.descriptorSet.value
     };
 
@@ -479,14 +465,14 @@ void ForwardStage::DrawEnvironment(vk::CommandBuffer commandBuffer, uint32_t ima
     commandBuffer.bindIndexBuffer(environmentData.indexBuffer, 0, vk::IndexType::eUint16);
 
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-            environmentPipeline->GetLayout(), 0, environmentDescriptorSets, {});
+            environmentPipeline->GetLayout(), 0, environmentDescriptorSets, { cameraOffset });
 
     commandBuffer.drawIndexed(Details::kEnvironmentIndexCount, 1, 0, 0, 0);
 
     commandBuffer.endRenderPass();
 }
 
-void ForwardStage::DrawLightVolume(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+void ForwardStage::DrawLightVolume(vk::CommandBuffer commandBuffer, uint32_t cameraOffset) const
 {
     if (!scene->ctx().contains<LightVolumeComponent>())
     {
@@ -502,7 +488,7 @@ void ForwardStage::DrawLightVolume(vk::CommandBuffer commandBuffer, uint32_t ima
     };
 
     const std::vector<vk::DescriptorSet> positionsDescriptorSets{
-        defaultCameraData.descriptorSet.values[imageIndex],
+        cameraDescriptorSet.value,
         lightVolumeData.positionsDescriptorSet.value
     };
 
@@ -515,13 +501,13 @@ void ForwardStage::DrawLightVolume(vk::CommandBuffer commandBuffer, uint32_t ima
     commandBuffer.bindVertexBuffers(0, positionsVertexBuffers, { 0, 0 });
 
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-            lightVolumePositionsPipeline->GetLayout(), 0, positionsDescriptorSets, {});
+            lightVolumePositionsPipeline->GetLayout(), 0, positionsDescriptorSets, { cameraOffset });
 
     commandBuffer.drawIndexed(lightVolumeData.positionsIndexCount,
             lightVolumeData.positionsInstanceCount, 0, 0, 0);
 
     const std::vector<vk::DescriptorSet> edgesDescriptorSets{
-        defaultCameraData.descriptorSet.values[imageIndex]
+        cameraDescriptorSet.value
     };
 
     commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, lightVolumeEdgesPipeline->Get());
@@ -530,7 +516,7 @@ void ForwardStage::DrawLightVolume(vk::CommandBuffer commandBuffer, uint32_t ima
     commandBuffer.bindVertexBuffers(0, { lightVolumeData.positionsInstanceBuffer }, { 0 });
 
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-            lightVolumePositionsPipeline->GetLayout(), 0, edgesDescriptorSets, {});
+            lightVolumePositionsPipeline->GetLayout(), 0, edgesDescriptorSets, { cameraOffset });
 
     commandBuffer.drawIndexed(lightVolumeData.edgesIndexCount, 1, 0, 0, 0);
 }
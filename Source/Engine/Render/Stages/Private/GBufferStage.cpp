@@ -1,5 +1,7 @@
 #include "Engine/Render/Stages/GBufferStage.hpp"
 
+#include "Engine/Config.hpp"
+#include "Engine/Render/IndirectDrawCuller.hpp"
 #include "Engine/Render/Vulkan/GraphicsPipeline.hpp"
 #include "Engine/Render/Vulkan/RenderPass.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
@@ -131,15 +133,13 @@ namespace Details
         return VulkanHelpers::CreateFramebuffers(device, renderPass.Get(), extent, {}, imageViews).front();
     }
 
-    static CameraData CreateCameraData()
+    static DescriptorSet CreateCameraDescriptorSet()
     {
-        const uint32_t bufferCount = VulkanContext::swapchain->GetImageCount();
-
         constexpr vk::DeviceSize bufferSize = sizeof(glm::mat4);
 
         constexpr vk::ShaderStageFlags shaderStages = vk::ShaderStageFlagBits::eVertex;
 
-        return RenderHelpers::CreateCameraData(bufferCount, bufferSize, shaderStages);
+        return RenderHelpers::CreateTransientDescriptorSet(bufferSize, shaderStages);
     }
 
     static DescriptorSet CreateMaterialDescriptorSet(const Scene& scene)
@@ -176,7 +176,12 @@ namespace Details
             const std::vector<vk::DescriptorSetLayout>& descriptorSetLayouts,
             const MaterialFlags& materialFlags)
     {
-        const ShaderDefines defines = MaterialHelpers::BuildShaderDefines(materialFlags);
+        ShaderDefines defines = MaterialHelpers::BuildShaderDefines(materialFlags);
+
+        if constexpr (Config::kGpuDrivenRendering)
+        {
+            defines.emplace("GPU_DRIVEN", 1);
+        }
 
         const std::vector<ShaderModule> shaderModules{
             VulkanContext::shaderManager->CreateShaderModule(
@@ -227,6 +232,24 @@ namespace Details
         return pipeline;
     }
 
+    // Unique material flags in the order of their first occurrence, one pipeline per entry
+    static std::vector<MaterialFlags> GetUniqueMaterialFlags(const Scene& scene)
+    {
+        const auto& materialComponent = scene.ctx().get<MaterialStorageComponent>();
+
+        std::vector<MaterialFlags> uniqueMaterialFlags;
+
+        for (const auto& material : materialComponent.materials)
+        {
+            if (std::ranges::find(uniqueMaterialFlags, material.flags) == uniqueMaterialFlags.end())
+            {
+                uniqueMaterialFlags.push_back(material.flags);
+            }
+        }
+
+        return uniqueMaterialFlags;
+    }
+
     static std::vector<vk::ClearValue> GetClearValues()
     {
         std::vector<vk::ClearValue> clearValues(GBufferStage::kFormats.size());
@@ -255,19 +278,14 @@ GBufferStage::GBufferStage()
 
     framebuffer = Details::CreateFramebuffer(*renderPass, GetImageViews());
 
-    cameraData = Details::CreateCameraData();
+    cameraDescriptorSet = Details::CreateCameraDescriptorSet();
 }
 
 GBufferStage::~GBufferStage()
 {
     RemoveScene();
 
-    DescriptorHelpers::DestroyMultiDescriptorSet(cameraData.descriptorSet);
-
-    for (const auto& buffer : cameraData.buffers)
-    {
-        VulkanContext::bufferManager->DestroyBuffer(buffer);
-    }
+    DescriptorHelpers::DestroyDescriptorSet(cameraDescriptorSet);
 
     for (const auto& texture : renderTargets)
     {
@@ -295,6 +313,11 @@ void GBufferStage::RegisterScene(const Scene* scene_)
 
     materialDescriptorSet = Details::CreateMaterialDescriptorSet(*scene);
 
+    if constexpr (Config::kGpuDrivenRendering)
+    {
+        indirectDrawCuller = std::make_unique<IndirectDrawCuller>(*scene, Details::GetUniqueMaterialFlags(*scene));
+    }
+
     materialPipelines = CreateMaterialPipelines(*scene, *renderPass, GetDescriptorSetLayouts());
 }
 
@@ -310,19 +333,50 @@ void GBufferStage::RemoveScene()
         pipeline.reset();
     }
 
+    drawBuckets.clear();
+    drawBucketsVersion = std::nullopt;
+
+    indirectDrawCuller.reset();
+
     DescriptorHelpers::DestroyDescriptorSet(materialDescriptorSet);
 
     scene = nullptr;
 }
 
-void GBufferStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+void GBufferStage::Execute(vk::CommandBuffer commandBuffer)
 {
     const auto& cameraComponent = scene->ctx().get<CameraComponent>();
 
     const glm::mat4 viewProj = cameraComponent.projMatrix * cameraComponent.viewMatrix;
 
-    BufferHelpers::UpdateBuffer(commandBuffer, cameraData.buffers[imageIndex],
-            ByteView(viewProj), SyncScope::kWaitForNone, SyncScope::kVertexUniformRead);
+    const SceneBVH& sceneBVH = scene->ctx().get<SceneBVH>();
+
+    std::vector<uint32_t> visibleItems;
+
+    if (indirectDrawCuller)
+    {
+        // Objects follow the scene BVH items, which are reordered by a rebuild
+        if (indirectDrawCuller->GetSceneVersion() != sceneBVH.GetVersion())
+        {
+            VulkanContext::device->WaitIdle();
+
+            indirectDrawCuller = std::make_unique<IndirectDrawCuller>(*scene, Details::GetUniqueMaterialFlags(*scene));
+        }
+
+        indirectDrawCuller->Cull(commandBuffer, viewProj);
+    }
+    else
+    {
+        if (drawBucketsVersion != sceneBVH.GetVersion())
+        {
+            drawBuckets = CreateDrawBuckets(*scene, Details::GetUniqueMaterialFlags(*scene));
+            drawBucketsVersion = sceneBVH.GetVersion();
+        }
+
+        visibleItems = sceneBVH.Cull(viewProj, cullingStats);
+    }
+
+    const uint32_t cameraOffset = VulkanContext::transientAllocator->Allocate(ByteView(viewProj));
 
     const vk::Rect2D renderArea = RenderHelpers::GetSwapchainRenderArea();
     const vk::Viewport viewport = RenderHelpers::GetSwapchainViewport();
@@ -337,7 +391,14 @@ void GBufferStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex)
     commandBuffer.setViewport(0, { viewport });
     commandBuffer.setScissor(0, { renderArea });
 
-    DrawScene(commandBuffer, imageIndex);
+    if (indirectDrawCuller)
+    {
+        DrawSceneIndirect(commandBuffer, cameraOffset);
+    }
+    else
+    {
+        DrawScene(commandBuffer, cameraOffset, visibleItems);
+    }
 
     commandBuffer.endRenderPass();
 }
@@ -358,6 +419,11 @@ void GBufferStage::Resize()
 
 void GBufferStage::ReloadShaders()
 {
+    if (indirectDrawCuller)
+    {
+        indirectDrawCuller->ReloadShaders();
+    }
+
     materialPipelines = CreateMaterialPipelines(*scene, *renderPass, GetDescriptorSetLayouts());
 }
 
@@ -367,80 +433,174 @@ std::vector<GBufferStage::MaterialPipeline> GBufferStage::CreateMaterialPipeline
 {
     std::vector<GBufferStage::MaterialPipeline> pipelines;
 
+    for (const MaterialFlags materialFlags : Details::GetUniqueMaterialFlags(scene))
+    {
+        std::unique_ptr<GraphicsPipeline> pipeline
+                = Details::CreatePipeline(renderPass, layouts, materialFlags);
+
+        pipelines.emplace_back(materialFlags, std::move(pipeline));
+    }
+
+    return pipelines;
+}
+
+std::vector<std::vector<GBufferStage::DrawItem>> GBufferStage::CreateDrawBuckets(
+        const Scene& scene, const std::vector<MaterialFlags>& bucketFlags)
+{
     const auto& materialComponent = scene.ctx().get<MaterialStorageComponent>();
 
-    for (const auto& material : materialComponent.materials)
+    const std::vector<SceneBVH::Item>& items = scene.ctx().get<SceneBVH>().GetItems();
+
+    std::vector<std::vector<DrawItem>> buckets(bucketFlags.size());
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(items.size()); ++i)
     {
-        const auto pred = [&material](const MaterialPipeline& materialPipeline)
-            {
-                return materialPipeline.materialFlags == material.flags;
-            };
+        const SceneBVH::Item& item = items[i];
 
-        const auto it = std::ranges::find_if(pipelines, pred);
+        const auto& ro = scene.get<RenderComponent>(item.entity).renderObjects[item.renderObject];
 
-        if (it == pipelines.end())
-        {
-            std::unique_ptr<GraphicsPipeline> pipeline
-                    = Details::CreatePipeline(renderPass, layouts, material.flags);
+        const auto it = std::ranges::find(bucketFlags, materialComponent.materials[ro.material].flags);
+        Assert(it != bucketFlags.end());
 
-            pipelines.emplace_back(material.flags, std::move(pipeline));
-        }
+        buckets[std::distance(bucketFlags.begin(), it)].push_back(DrawItem{ i, ro.material, ro.primitive });
     }
 
-    return pipelines;
+    for (auto& bucket : buckets)
+    {
+        std::ranges::sort(bucket, [](const DrawItem& a, const DrawItem& b)
+            {
+                return std::tie(a.material, a.primitive, a.item) < std::tie(b.material, b.primitive, b.item);
+            });
+    }
+
+    return buckets;
 }
 
 std::vector<vk::DescriptorSetLayout> GBufferStage::GetDescriptorSetLayouts() const
 {
-    return { cameraData.descriptorSet.layout, materialDescriptorSet.layout };
+    if (indirectDrawCuller)
+    {
+        return {
+            cameraDescriptorSet.layout,
+            materialDescriptorSet.layout,
+            indirectDrawCuller->GetDescriptorSet().layout
+        };
+    }
+
+    return { cameraDescriptorSet.layout, materialDescriptorSet.layout };
 }
 
-void GBufferStage::DrawScene(vk::CommandBuffer commandBuffer, uint32_t imageIndex) const
+void GBufferStage::DrawScene(vk::CommandBuffer commandBuffer, uint32_t cameraOffset,
+        const std::vector<uint32_t>& visibleItems) const
 {
+    EASY_FUNCTION()
+
     const auto& cameraComponent = scene->ctx().get<CameraComponent>();
 
     const glm::vec3& cameraPosition = cameraComponent.location.position;
 
-    const auto sceneRenderView = scene->view<TransformComponent, RenderComponent>();
+    const std::vector<SceneBVH::Item>& items = scene->ctx().get<SceneBVH>().GetItems();
 
-    const auto& materialComponent = scene->ctx().get<MaterialStorageComponent>();
     const auto& geometryComponent = scene->ctx().get<GeometryStorageComponent>();
 
-    for (const auto& [materialFlags, pipeline] : materialPipelines)
+    std::vector<bool> visibility(items.size(), false);
+
+    for (const uint32_t itemIndex : visibleItems)
     {
-        commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->Get());
+        visibility[itemIndex] = true;
+    }
 
-        commandBuffer.pushConstants<glm::vec3>(pipeline->GetLayout(),
+    constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+    for (size_t i = 0; i < materialPipelines.size(); ++i)
+    {
+        const GraphicsPipeline& pipeline = *materialPipelines[i].pipeline;
+
+        const std::vector<DrawItem>& drawBucket = drawBuckets[i];
+
+        if (drawBucket.empty())
+        {
+            continue;
+        }
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.Get());
+
+        commandBuffer.pushConstants<glm::vec3>(pipeline.GetLayout(),
                 vk::ShaderStageFlagBits::eFragment, sizeof(glm::mat4), { cameraPosition });
 
         const std::vector<vk::DescriptorSet> descriptorSets{
-            cameraData.descriptorSet.values[imageIndex],
+            cameraDescriptorSet.value,
             materialDescriptorSet.value
         };
 
         commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                pipeline->GetLayout(), 0, descriptorSets, {});
+                pipeline.GetLayout(), 0, descriptorSets, { cameraOffset });
 
-        for (auto&& [entity, tc, rc] : sceneRenderView.each())
+        uint32_t boundMaterial = kInvalidIndex;
+        uint32_t boundPrimitive = kInvalidIndex;
+
+        for (const DrawItem& drawItem : drawBucket)
         {
-            for (const auto& ro : rc.renderObjects)
+            if (!visibility[drawItem.item])
             {
-                if (materialComponent.materials[ro.material].flags == materialFlags)
-                {
-                    const Primitive& primitive = geometryComponent.primitives[ro.primitive];
+                continue;
+            }
 
-                    commandBuffer.bindIndexBuffer(primitive.indexBuffer, 0, primitive.indexType);
-                    commandBuffer.bindVertexBuffers(0, { primitive.vertexBuffer }, { 0 });
+            const Primitive& primitive = geometryComponent.primitives[drawItem.primitive];
 
-                    commandBuffer.pushConstants<glm::mat4>(pipeline->GetLayout(),
-                            vk::ShaderStageFlagBits::eVertex, 0, { tc.worldTransform.GetMatrix() });
+            if (drawItem.primitive != boundPrimitive)
+            {
+                commandBuffer.bindIndexBuffer(primitive.indexBuffer.buffer,
+                        primitive.indexBuffer.offset, primitive.indexType);
+                commandBuffer.bindVertexBuffers(0,
+                        { primitive.vertexBuffer.buffer }, { primitive.vertexBuffer.offset });
 
-                    commandBuffer.pushConstants<uint32_t>(pipeline->GetLayout(),
-                            vk::ShaderStageFlagBits::eFragment, sizeof(glm::mat4) + sizeof(glm::vec3), { ro.material });
+                boundPrimitive = drawItem.primitive;
+            }
 
-                    commandBuffer.drawIndexed(primitive.indexCount, 1, 0, 0, 0);
-                }
+            if (drawItem.material != boundMaterial)
+            {
+                commandBuffer.pushConstants<uint32_t>(pipeline.GetLayout(), vk::ShaderStageFlagBits::eFragment,
+                        sizeof(glm::mat4) + sizeof(glm::vec3), { drawItem.material });
+
+                boundMaterial = drawItem.material;
             }
+
+            const auto& tc = scene->get<TransformComponent>(items[drawItem.item].entity);
+
+            commandBuffer.pushConstants<glm::mat4>(pipeline.GetLayout(),
+                    vk::ShaderStageFlagBits::eVertex, 0, { tc.worldTransform.GetMatrix() });
+
+            commandBuffer.drawIndexed(primitive.indexCount, 1, 0, 0, 0);
         }
     }
 }
+
+void GBufferStage::DrawSceneIndirect(vk::CommandBuffer commandBuffer, uint32_t cameraOffset) const
+{
+    const auto& cameraComponent = scene->ctx().get<CameraComponent>();
+
+    const glm::vec3& cameraPosition = cameraComponent.location.position;
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(materialPipelines.size()); ++i)
+    {
+        const GraphicsPipeline& pipeline = *materialPipelines[i].pipeline;
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline.Get());
+
+        commandBuffer.pushConstants<glm::vec3>(pipeline.GetLayout(),
+                vk::ShaderStageFlagBits::eFragment, sizeof(glm::mat4), { cameraPosition });
+
+        const std::vector<vk::DescriptorSet> descriptorSets{
+            cameraDescriptorSet.value,
+            materialDescriptorSet.value,
+            indirectDrawCuller->GetDescriptorSet().value
+        };
+
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+                pipeline.GetLayout(), 0, descriptorSets, { cameraOffset });
+
+        // Pipelines and culler buckets share the order of unique material flags
+        indirectDrawCuller->Draw(commandBuffer, i);
+    }
+}
@@ -5,7 +5,6 @@
 #include "Engine/Render/Vulkan/PipelineHelpers.hpp"
 #include "Engine/Render/Vulkan/ComputePipeline.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
-#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
 #include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
 #include "Engine/Scene/GlobalIllumination.hpp"
 #include "Engine/Scene/ImageBasedLighting.hpp"
@@ -73,15 +72,13 @@ namespace Details
         return DescriptorHelpers::CreateMultiDescriptorSet({ descriptorDescription }, multiDescriptorSetData);
     }
 
-    static CameraData CreateCameraData()
+    static DescriptorSet CreateCameraDescriptorSet()
     {
-        const uint32_t bufferCount = VulkanContext::swapchain->GetImageCount();
-
         constexpr vk::DeviceSize bufferSize = sizeof(glm::mat4);
 
         constexpr vk::ShaderStageFlags shaderStages = vk::ShaderStageFlagBits::eCompute;
 
-        return RenderHelpers::CreateCameraData(bufferCount, bufferSize, shaderStages);
+        return RenderHelpers::CreateTransientDescriptorSet(bufferSize, shaderStages);
     }
 
     static DescriptorSet CreateLightingDescriptorSet(const Scene& scene)
@@ -146,10 +143,16 @@ namespace Details
                 vk::ShaderStageFlagBits::eCompute,
                 vk::DescriptorBindingFlags()
             });
+            descriptorSetDescription.push_back(DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                vk::ShaderStageFlagBits::eCompute,
+                vk::DescriptorBindingFlags()
+            });
 
             descriptorSetData.push_back(DescriptorHelpers::GetStorageData(lightVolumeComponent.positionsBuffer));
             descriptorSetData.push_back(DescriptorHelpers::GetStorageData(lightVolumeComponent.tetrahedralBuffer));
             descriptorSetData.push_back(DescriptorHelpers::GetStorageData(lightVolumeComponent.coefficientsBuffer));
+            descriptorSetData.push_back(DescriptorHelpers::GetStorageData(lightVolumeComponent.tetrahedronGridBuffer));
         }
 
         return DescriptorHelpers::CreateDescriptorSet(descriptorSetDescription, descriptorSetData);
@@ -189,6 +192,11 @@ namespace Details
                 primitiveCount, vk::DescriptorType::eStorageBuffer,
                 vk::ShaderStageFlagBits::eCompute,
                 vk::DescriptorBindingFlags()
+            },
+            DescriptorDescription{
+                1, vk::DescriptorType::eStorageBuffer,
+                vk::ShaderStageFlagBits::eCompute,
+                vk::DescriptorBindingFlags()
             }
         };
 
@@ -198,6 +206,7 @@ namespace Details
             DescriptorHelpers::GetData(textureComponent.textures),
             DescriptorHelpers::GetStorageData(rayTracingComponent.indexBuffers),
             DescriptorHelpers::GetStorageData(rayTracingComponent.vertexBuffers),
+            DescriptorHelpers::GetStorageData(renderComponent.instanceBuffer),
         };
 
         return DescriptorHelpers::CreateDescriptorSet(descriptorSetDescription, descriptorSetData);
@@ -246,19 +255,14 @@ LightingStage::LightingStage(const std::vector<vk::ImageView>& gBufferImageViews
 
     swapchainDescriptorSet = Details::CreateSwapchainDescriptorSet();
 
-    cameraData = Details::CreateCameraData();
+    cameraDescriptorSet = Details::CreateCameraDescriptorSet();
 }
 
 LightingStage::~LightingStage()
 {
     RemoveScene();
 
-    DescriptorHelpers::DestroyMultiDescriptorSet(cameraData.descriptorSet);
-    for (const auto& buffer : cameraData.buffers)
-    {
-        VulkanContext::bufferManager->DestroyBuffer(buffer);
-    }
-
+    DescriptorHelpers::DestroyDescriptorSet(cameraDescriptorSet);
     DescriptorHelpers::DestroyDescriptorSet(gBufferDescriptorSet);
     DescriptorHelpers::DestroyMultiDescriptorSet(swapchainDescriptorSet);
 }
@@ -303,8 +307,7 @@ void LightingStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex
 
     const glm::mat4 inverseProjView = glm::inverse(view) * glm::inverse(proj);
 
-    BufferHelpers::UpdateBuffer(commandBuffer, cameraData.buffers[imageIndex],
-            ByteView(inverseProjView), SyncScope::kWaitForNone, SyncScope::kComputeShaderRead);
+    const uint32_t cameraOffset = VulkanContext::transientAllocator->Allocate(ByteView(inverseProjView));
 
     const vk::Image swapchainImage = VulkanContext::swapchain->GetImages()[imageIndex];
     const vk::Extent2D& extent = VulkanContext::swapchain->GetExtent();
@@ -326,7 +329,7 @@ void LightingStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex
         swapchainDescriptorSet.values[imageIndex],
         gBufferDescriptorSet.value,
         lightingDescriptorSet.value,
-        cameraData.descriptorSet.values[imageIndex],
+        cameraDescriptorSet.value,
     };
 
     if constexpr (Config::kRayTracingEnabled)
@@ -340,7 +343,7 @@ void LightingStage::Execute(vk::CommandBuffer commandBuffer, uint32_t imageIndex
             vk::ShaderStageFlagBits::eCompute, 0, { cameraPosition });
 
     commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
-            pipeline->GetLayout(), 0, descriptorSets, {});
+            pipeline->GetLayout(), 0, descriptorSets, { cameraOffset });
 
     const glm::uvec3 groupCount = PipelineHelpers::CalculateWorkGroupCount(extent, Details::kWorkGroupSize);
 
@@ -369,7 +372,7 @@ std::vector<vk::DescriptorSetLayout> LightingStage::GetDescriptorSetLayouts() co
         swapchainDescriptorSet.layout,
         gBufferDescriptorSet.layout,
         lightingDescriptorSet.layout,
-        cameraData.descriptorSet.layout,
+        cameraDescriptorSet.layout,
     };
 
     if constexpr (Config::kRayTracingEnabled)
@@ -1,6 +1,7 @@
 #pragma once
 
 struct SampledTexture;
+struct BufferSlice;
 
 struct DescriptorDescription
 {
@@ -49,6 +50,8 @@ namespace DescriptorHelpers
 
     DescriptorData GetData(vk::Buffer buffer);
 
+    DescriptorData GetDynamicData(vk::Buffer buffer, vk::DeviceSize range);
+
     DescriptorData GetStorageData(vk::ImageView view);
 
     DescriptorData GetStorageData(const std::vector<vk::ImageView>& views);
@@ -57,6 +60,8 @@ namespace DescriptorHelpers
 
     DescriptorData GetStorageData(const std::vector<vk::Buffer>& buffers);
 
+    DescriptorData GetStorageData(const std::vector<BufferSlice>& slices);
+
     DescriptorData GetData(const vk::AccelerationStructureKHR& accelerationStructure);
 
     DescriptorSet CreateDescriptorSet(const DescriptorSetDescription& description,
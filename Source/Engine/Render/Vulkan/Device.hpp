@@ -8,10 +8,21 @@ struct Queues
     {
         uint32_t graphicsFamilyIndex;
         uint32_t presentFamilyIndex;
+        uint32_t transferFamilyIndex;
+        uint32_t computeFamilyIndex;
     };
 
     vk::Queue graphics;
     vk::Queue present;
+    vk::Queue transfer; // aliases graphics queue if there is no dedicated family
+    vk::Queue compute; // aliases graphics queue if there is no dedicated family
+};
+
+// Point on the timeline of a queue, reached once the submitted commands are completed
+struct QueueSubmission
+{
+    QueueType queueType = QueueType::eGraphics;
+    uint64_t value = 0;
 };
 
 class Device
@@ -20,11 +31,14 @@ public:
     struct Features
     {
         bool samplerAnisotropy;
+        bool multiDrawIndirect;
+        bool drawIndirectFirstInstance;
         bool accelerationStructure;
         bool rayTracingPipeline;
         bool descriptorIndexing;
         bool bufferDeviceAddress;
         bool rayQuery;
+        bool timelineSemaphore;
     };
 
     struct RayTracingProperties
@@ -55,15 +69,29 @@ public:
 
     const Queues& GetQueues() const { return queues; }
 
+    vk::Queue GetQueue(QueueType queueType) const;
+
+    uint32_t GetQueueFamilyIndex(QueueType queueType) const;
+
+    QueueFamilyTransfer GetQueueFamilyTransfer(QueueType srcQueueType, QueueType dstQueueType) const;
+
     uint32_t GetMemoryTypeIndex(uint32_t typeBits, vk::MemoryPropertyFlags requiredProperties) const;
 
     vk::DeviceAddress GetAddress(vk::Buffer buffer) const;
 
     vk::DeviceAddress GetAddress(vk::AccelerationStructureKHR accelerationStructure) const;
 
-    void ExecuteOneTimeCommands(DeviceCommands commands) const;
+    void ExecuteOneTimeCommands(DeviceCommands commands, QueueType queueType = QueueType::eGraphics) const;
 
-    vk::CommandBuffer AllocateCommandBuffer(CommandBufferType type) const;
+    vk::CommandBuffer AllocateCommandBuffer(CommandBufferType type, QueueType queueType = QueueType::eGraphics) const;
+
+    // Submits recorded command buffer which waits for the given submissions of any queue
+    QueueSubmission Submit(QueueType queueType, vk::CommandBuffer commandBuffer,
+            const std::vector<QueueSubmission>& waitedSubmissions = {});
+
+    void Wait(const QueueSubmission& submission) const;
+
+    bool IsComplete(const QueueSubmission& submission) const;
 
     void WaitIdle() const;
 
@@ -77,8 +105,15 @@ private:
     Queues::Description queuesDescription;
     Queues queues;
 
+    struct QueueTimeline
+    {
+        vk::Semaphore semaphore;
+        uint64_t value = 0;
+    };
+
     CommandBufferSync oneTimeCommandsSync;
-    std::map<CommandBufferType, vk::CommandPool> commandPools;
+    std::map<std::pair<QueueType, CommandBufferType>, vk::CommandPool> commandPools;
+    std::map<QueueType, QueueTimeline> timelines;
 
     Device(vk::Device device_, vk::PhysicalDevice physicalDevice_, const Queues::Description& queuesDescription_);
 };
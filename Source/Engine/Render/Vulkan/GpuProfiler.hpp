@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Engine/Filesystem/Filepath.hpp"
+
+#include "Utils/TimeHelpers.hpp"
+
+// Measures GPU time of nested command buffer scopes with timestamp queries.
+// Every frame in flight owns a range of queries which is read back when the frame context is reused,
+// so reading the results never stalls the host.
+class GpuProfiler
+{
+public:
+    struct ScopeStats
+    {
+        std::string name;
+        uint32_t depth = 0;
+        float averageMiliseconds = 0.0f;
+    };
+
+    GpuProfiler();
+    ~GpuProfiler();
+
+    // Has to be called once the frame which previously used the context has been completed on the device
+    void BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex_);
+
+    void EndFrame(vk::CommandBuffer commandBuffer);
+
+    uint32_t BeginScope(vk::CommandBuffer commandBuffer, const std::string& name);
+
+    void EndScope(vk::CommandBuffer commandBuffer, uint32_t scopeIndex);
+
+    // Averages over the last kGpuProfilerAverageFrameCount frames, ordered as the scopes were first recorded
+    const std::vector<ScopeStats>& GetScopeStats() const { return scopeStats; }
+
+    // Writes recent frames in Chrome trace event format, GPU timestamps are converted to the host clock
+    void ExportTrace(const Filepath& path) const;
+
+private:
+    struct Scope
+    {
+        std::string name;
+        uint32_t depth = 0;
+        uint32_t firstQuery = 0;
+    };
+
+    struct Frame
+    {
+        std::vector<Scope> scopes;
+        double hostBeginMicroseconds = 0.0;
+        double hostEndMicroseconds = 0.0;
+    };
+
+    struct ScopeSamples
+    {
+        std::vector<float> values;
+        uint32_t nextIndex = 0;
+        float sum = 0.0f;
+    };
+
+    struct TraceEvent
+    {
+        std::string name;
+        bool isDeviceEvent = false;
+        double beginMicroseconds = 0.0;
+        double durationMicroseconds = 0.0;
+    };
+
+    vk::QueryPool queryPool;
+    uint32_t queriesPerFrame = 0;
+
+    TimePoint hostStartTimePoint;
+    double calibrationHostMicroseconds = 0.0;
+    uint64_t calibrationTimestamp = 0;
+
+    std::vector<Frame> frames;
+    uint32_t frameIndex = 0;
+    uint32_t frameScopeIndex = 0;
+    uint32_t depth = 0;
+
+    std::vector<ScopeStats> scopeStats;
+    std::vector<ScopeSamples> scopeSamples;
+
+    std::vector<TraceEvent> traceEvents;
+    uint32_t nextTraceEventIndex = 0;
+
+    double GetHostMicroseconds() const;
+
+    double GetHostMicroseconds(uint64_t timestamp) const;
+
+    void Calibrate();
+
+    void ReadFrame(uint32_t index);
+
+    void AddSample(const Scope& scope, float miliseconds);
+
+    void AddTraceEvent(const TraceEvent& traceEvent);
+};
+
+// Records GPU time of the commands recorded during the lifetime of the object
+class GpuScope
+{
+public:
+    GpuScope(vk::CommandBuffer commandBuffer_, const std::string& name);
+    ~GpuScope();
+
+private:
+    vk::CommandBuffer commandBuffer;
+    uint32_t scopeIndex;
+};
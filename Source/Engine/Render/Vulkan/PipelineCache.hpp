@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Engine/Filesystem/Filepath.hpp"
+
+class PipelineCache
+{
+public:
+    static std::unique_ptr<PipelineCache> Create(const Filepath& path);
+    ~PipelineCache();
+
+    vk::PipelineCache Get() const { return pipelineCache; }
+
+    void Save() const;
+
+private:
+    vk::PipelineCache pipelineCache;
+
+    Filepath path;
+
+    PipelineCache(vk::PipelineCache pipelineCache_, const Filepath& path_);
+};
@@ -15,7 +15,8 @@ std::unique_ptr<ComputePipeline> ComputePipeline::Create(const Description& desc
 
     const vk::ComputePipelineCreateInfo createInfo({}, shaderStageCreateInfo, layout);
 
-    const auto [result, pipeline] = VulkanContext::device->Get().createComputePipeline(nullptr, createInfo);
+    const auto [result, pipeline] = VulkanContext::device->Get().createComputePipeline(
+            VulkanContext::pipelineCache->Get(), createInfo);
     Assert(result == vk::Result::eSuccess);
 
     return std::unique_ptr<ComputePipeline>(new ComputePipeline(pipeline, layout));
@@ -69,6 +69,16 @@ DescriptorData DescriptorHelpers::GetData(vk::Buffer buffer)
     };
 }
 
+DescriptorData DescriptorHelpers::GetDynamicData(vk::Buffer buffer, vk::DeviceSize range)
+{
+    return DescriptorData{
+        vk::DescriptorType::eUniformBufferDynamic,
+        BufferInfo{
+            vk::DescriptorBufferInfo(buffer, 0, range)
+        }
+    };
+}
+
 DescriptorData DescriptorHelpers::GetStorageData(vk::ImageView view)
 {
     if (!view)
@@ -131,6 +141,19 @@ DescriptorData DescriptorHelpers::GetStorageData(const std::vector<vk::Buffer>&
     return DescriptorData{ vk::DescriptorType::eStorageBuffer, bufferInfo };
 }
 
+DescriptorData DescriptorHelpers::GetStorageData(const std::vector<BufferSlice>& slices)
+{
+    BufferInfo bufferInfo;
+    bufferInfo.reserve(slices.size());
+
+    for (const auto& slice : slices)
+    {
+        bufferInfo.emplace_back(slice.buffer, slice.offset, slice.size);
+    }
+
+    return DescriptorData{ vk::DescriptorType::eStorageBuffer, bufferInfo };
+}
+
 DescriptorData DescriptorHelpers::GetData(const vk::AccelerationStructureKHR& accelerationStructure)
 {
     if (!accelerationStructure)
@@ -69,6 +69,51 @@ namespace Details
         return static_cast<uint32_t>(std::distance(queueFamilies.begin(), it));
     }
 
+    static std::optional<uint32_t> FindDedicatedQueueFamilyIndex(vk::PhysicalDevice physicalDevice,
+            vk::QueueFlags requiredFlags, vk::QueueFlags excludedFlags)
+    {
+        const auto queueFamilies = physicalDevice.getQueueFamilyProperties();
+
+        const auto pred = [&](const vk::QueueFamilyProperties& queueFamily)
+            {
+                return queueFamily.queueCount > 0 && (queueFamily.queueFlags & requiredFlags) == requiredFlags
+                        && !(queueFamily.queueFlags & excludedFlags);
+            };
+
+        const auto it = std::ranges::find_if(queueFamilies, pred);
+
+        if (it == queueFamilies.end())
+        {
+            return std::nullopt;
+        }
+
+        return static_cast<uint32_t>(std::distance(queueFamilies.begin(), it));
+    }
+
+    static uint32_t FindTransferQueueFamilyIndex(vk::PhysicalDevice physicalDevice, uint32_t graphicsQueueFamilyIndex)
+    {
+        const std::optional<uint32_t> transferOnlyQueueFamilyIndex = FindDedicatedQueueFamilyIndex(physicalDevice,
+                vk::QueueFlagBits::eTransfer, vk::QueueFlagBits::eGraphics | vk::QueueFlagBits::eCompute);
+
+        if (transferOnlyQueueFamilyIndex.has_value())
+        {
+            return transferOnlyQueueFamilyIndex.value();
+        }
+
+        const std::optional<uint32_t> nonGraphicsQueueFamilyIndex = FindDedicatedQueueFamilyIndex(physicalDevice,
+                vk::QueueFlagBits::eTransfer, vk::QueueFlagBits::eGraphics);
+
+        return nonGraphicsQueueFamilyIndex.value_or(graphicsQueueFamilyIndex);
+    }
+
+    static uint32_t FindComputeQueueFamilyIndex(vk::PhysicalDevice physicalDevice, uint32_t graphicsQueueFamilyIndex)
+    {
+        const std::optional<uint32_t> computeQueueFamilyIndex = FindDedicatedQueueFamilyIndex(physicalDevice,
+                vk::QueueFlagBits::eCompute, vk::QueueFlagBits::eGraphics);
+
+        return computeQueueFamilyIndex.value_or(graphicsQueueFamilyIndex);
+    }
+
     static std::optional<uint32_t> FindCommonQueueFamilyIndex(
             vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface)
     {
@@ -115,12 +160,25 @@ namespace Details
     {
         const uint32_t graphicsQueueFamilyIndex = FindGraphicsQueueFamilyIndex(physicalDevice);
 
+        const uint32_t transferQueueFamilyIndex
+                = FindTransferQueueFamilyIndex(physicalDevice, graphicsQueueFamilyIndex);
+        const uint32_t computeQueueFamilyIndex
+                = FindComputeQueueFamilyIndex(physicalDevice, graphicsQueueFamilyIndex);
+
+        if (!surface)
+        {
+            // Headless device never presents, present queue aliases the graphics one
+            return Queues::Description{ graphicsQueueFamilyIndex, graphicsQueueFamilyIndex,
+                transferQueueFamilyIndex, computeQueueFamilyIndex };
+        }
+
         const auto [result, supportSurface] = physicalDevice.getSurfaceSupportKHR(graphicsQueueFamilyIndex, surface);
         Assert(result == vk::Result::eSuccess);
 
         if (supportSurface)
         {
-            return Queues::Description{ graphicsQueueFamilyIndex, graphicsQueueFamilyIndex };
+            return Queues::Description{ graphicsQueueFamilyIndex, graphicsQueueFamilyIndex,
+                transferQueueFamilyIndex, computeQueueFamilyIndex };
         }
 
         const std::optional<uint32_t> commonQueueFamilyIndex
@@ -128,13 +186,15 @@ namespace Details
 
         if (commonQueueFamilyIndex.has_value())
         {
-            return Queues::Description{ graphicsQueueFamilyIndex, graphicsQueueFamilyIndex };
+            return Queues::Description{ graphicsQueueFamilyIndex, graphicsQueueFamilyIndex,
+                transferQueueFamilyIndex, computeQueueFamilyIndex };
         }
 
         const std::optional<uint32_t> presentQueueFamilyIndex = FindPresentQueueFamilyIndex(physicalDevice, surface);
         Assert(presentQueueFamilyIndex.has_value());
 
-        return Queues::Description{ graphicsQueueFamilyIndex, presentQueueFamilyIndex.value() };
+        return Queues::Description{ graphicsQueueFamilyIndex, presentQueueFamilyIndex.value(),
+            transferQueueFamilyIndex, computeQueueFamilyIndex };
     }
 
     static std::vector<vk::DeviceQueueCreateInfo> CreateQueuesCreateInfo(
@@ -142,14 +202,19 @@ namespace Details
     {
         static constexpr float queuePriority = 0.0;
 
-        std::vector<vk::DeviceQueueCreateInfo> queuesCreateInfo{
-            vk::DeviceQueueCreateInfo({}, queuesDescription.graphicsFamilyIndex, 1, &queuePriority)
+        const std::set<uint32_t> uniqueQueueFamilyIndices{
+            queuesDescription.graphicsFamilyIndex,
+            queuesDescription.presentFamilyIndex,
+            queuesDescription.transferFamilyIndex,
+            queuesDescription.computeFamilyIndex
         };
 
-        if (queuesDescription.graphicsFamilyIndex != queuesDescription.presentFamilyIndex)
+        std::vector<vk::DeviceQueueCreateInfo> queuesCreateInfo;
+        queuesCreateInfo.reserve(uniqueQueueFamilyIndices.size());
+
+        for (const uint32_t queueFamilyIndex : uniqueQueueFamilyIndices)
         {
-            queuesCreateInfo.emplace_back(vk::DeviceQueueCreateFlags(),
-                    queuesDescription.presentFamilyIndex, 1, &queuePriority);
+            queuesCreateInfo.emplace_back(vk::DeviceQueueCreateFlags(), queueFamilyIndex, 1, &queuePriority);
         }
 
         return queuesCreateInfo;
@@ -159,6 +224,8 @@ namespace Details
     {
         vk::PhysicalDeviceFeatures features;
         features.setSamplerAnisotropy(deviceFeatures.samplerAnisotropy);
+        features.setMultiDrawIndirect(deviceFeatures.multiDrawIndirect);
+        features.setDrawIndirectFirstInstance(deviceFeatures.drawIndirectFirstInstance);
 
         vk::PhysicalDeviceAccelerationStructureFeaturesKHR accelerationStructureFeatures;
         accelerationStructureFeatures.setAccelerationStructure(deviceFeatures.accelerationStructure);
@@ -179,12 +246,16 @@ namespace Details
         vk::PhysicalDeviceRayQueryFeaturesKHR rayQueryFeatures;
         rayQueryFeatures.setRayQuery(deviceFeatures.rayQuery);
 
+        vk::PhysicalDeviceTimelineSemaphoreFeatures timelineSemaphoreFeatures;
+        timelineSemaphoreFeatures.setTimelineSemaphore(deviceFeatures.timelineSemaphore);
+
         using FeaturesStructureChain = vk::StructureChain<vk::PhysicalDeviceFeatures2,
             vk::PhysicalDeviceAccelerationStructureFeaturesKHR,
             vk::PhysicalDeviceRayTracingPipelineFeaturesKHR,
             vk::PhysicalDeviceDescriptorIndexingFeatures,
             vk::PhysicalDeviceBufferDeviceAddressFeatures,
-            vk::PhysicalDeviceRayQueryFeaturesKHR>;
+            vk::PhysicalDeviceRayQueryFeaturesKHR,
+            vk::PhysicalDeviceTimelineSemaphoreFeatures>;
 
         static FeaturesStructureChain featuresStructureChain(
                 vk::PhysicalDeviceFeatures2(features),
@@ -192,7 +263,8 @@ namespace Details
                 rayTracingPipelineFeatures,
                 descriptorIndexingFeatures,
                 bufferDeviceAddressFeatures,
-                rayQueryFeatures);
+                rayQueryFeatures,
+                timelineSemaphoreFeatures);
 
         return featuresStructureChain.get<vk::PhysicalDeviceFeatures2>();
     }
@@ -236,8 +308,9 @@ std::unique_ptr<Device> Device::Create(const Features& requiredFeatures,
     const auto physicalDevice = Details::FindSuitablePhysicalDevice(
             VulkanContext::instance->Get(), requiredExtensions);
 
-    const Queues::Description queuesDescription = Details::GetQueuesDescription(physicalDevice,
-            VulkanContext::surface->Get());
+    const vk::SurfaceKHR surface = VulkanContext::surface ? VulkanContext::surface->Get() : vk::SurfaceKHR();
+
+    const Queues::Description queuesDescription = Details::GetQueuesDescription(physicalDevice, surface);
 
     const std::vector<vk::DeviceQueueCreateInfo> queueCreatesInfo
             = Details::CreateQueuesCreateInfo(queuesDescription);
@@ -257,6 +330,11 @@ std::unique_ptr<Device> Device::Create(const Features& requiredFeatures,
     const vk::PhysicalDeviceProperties properties = physicalDevice.getProperties();
     LogI << "GPU selected: " << properties.deviceName << "\n";
 
+    LogI << "Queue families: graphics " << queuesDescription.graphicsFamilyIndex
+            << ", present " << queuesDescription.presentFamilyIndex
+            << ", transfer " << queuesDescription.transferFamilyIndex
+            << ", compute " << queuesDescription.computeFamilyIndex << "\n";
+
     LogD << "Device created" << "\n";
 
     return std::unique_ptr<Device>(new Device(device, physicalDevice, queuesDescription));
@@ -272,14 +350,23 @@ Device::Device(vk::Device device_, vk::PhysicalDevice physicalDevice_, const Que
 
     queues.graphics = device.getQueue(queuesDescription.graphicsFamilyIndex, 0);
     queues.present = device.getQueue(queuesDescription.presentFamilyIndex, 0);
+    queues.transfer = device.getQueue(queuesDescription.transferFamilyIndex, 0);
+    queues.compute = device.getQueue(queuesDescription.computeFamilyIndex, 0);
+
+    for (const QueueType queueType : { QueueType::eGraphics, QueueType::eTransfer, QueueType::eCompute })
+    {
+        const uint32_t queueFamilyIndex = GetQueueFamilyIndex(queueType);
+
+        commandPools[std::make_pair(queueType, CommandBufferType::eOneTime)] = Details::CreateCommandPool(device,
+                vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient,
+                queueFamilyIndex);
 
-    commandPools[CommandBufferType::eOneTime] = Details::CreateCommandPool(device,
-            vk::CommandPoolCreateFlagBits::eResetCommandBuffer | vk::CommandPoolCreateFlagBits::eTransient,
-            queuesDescription.graphicsFamilyIndex);
+        commandPools[std::make_pair(queueType, CommandBufferType::eLongLived)] = Details::CreateCommandPool(device,
+                vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+                queueFamilyIndex);
 
-    commandPools[CommandBufferType::eLongLived] = Details::CreateCommandPool(device,
-            vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
-            queuesDescription.graphicsFamilyIndex);
+        timelines[queueType].semaphore = VulkanHelpers::CreateTimelineSemaphore(device, 0);
+    }
 
     oneTimeCommandsSync.fence = VulkanHelpers::CreateFence(device, vk::FenceCreateFlags());
 }
@@ -291,6 +378,10 @@ Device::~Device()
     {
         device.destroyCommandPool(commandPool);
     }
+    for (const auto& [type, timeline] : timelines)
+    {
+        device.destroySemaphore(timeline.semaphore);
+    }
     device.destroy();
 }
 
@@ -333,6 +424,43 @@ uint32_t Device::GetMemoryTypeIndex(uint32_t typeBits, vk::MemoryPropertyFlags r
     return index.value();
 }
 
+vk::Queue Device::GetQueue(QueueType queueType) const
+{
+    switch (queueType)
+    {
+    case QueueType::eGraphics:
+        return queues.graphics;
+    case QueueType::eTransfer:
+        return queues.transfer;
+    case QueueType::eCompute:
+        return queues.compute;
+    default:
+        Assert(false);
+        return queues.graphics;
+    }
+}
+
+uint32_t Device::GetQueueFamilyIndex(QueueType queueType) const
+{
+    switch (queueType)
+    {
+    case QueueType::eGraphics:
+        return queuesDescription.graphicsFamilyIndex;
+    case QueueType::eTransfer:
+        return queuesDescription.transferFamilyIndex;
+    case QueueType::eCompute:
+        return queuesDescription.computeFamilyIndex;
+    default:
+        Assert(false);
+        return queuesDescription.graphicsFamilyIndex;
+    }
+}
+
+QueueFamilyTransfer Device::GetQueueFamilyTransfer(QueueType srcQueueType, QueueType dstQueueType) const
+{
+    return QueueFamilyTransfer{ GetQueueFamilyIndex(srcQueueType), GetQueueFamilyIndex(dstQueueType) };
+}
+
 vk::DeviceAddress Device::GetAddress(vk::Buffer buffer) const
 {
     return device.getBufferAddress({ buffer });
@@ -343,17 +471,22 @@ vk::DeviceAddress Device::GetAddress(vk::AccelerationStructureKHR accelerationSt
     return device.getAccelerationStructureAddressKHR({ accelerationStructure });
 }
 
-void Device::ExecuteOneTimeCommands(DeviceCommands commands) const
+void Device::ExecuteOneTimeCommands(DeviceCommands commands, QueueType queueType) const
 {
+    if (VulkanContext::uploadManager)
+    {
+        VulkanContext::uploadManager->Submit();
+    }
+
     vk::CommandBuffer commandBuffer;
 
-    const vk::CommandPool commandPool = commandPools.at(CommandBufferType::eOneTime);
+    const vk::CommandPool commandPool = commandPools.at(std::make_pair(queueType, CommandBufferType::eOneTime));
     const vk::CommandBufferAllocateInfo allocateInfo(commandPool, vk::CommandBufferLevel::ePrimary, 1);
 
     vk::Result result = device.allocateCommandBuffers(&allocateInfo, &commandBuffer);
     Assert(result == vk::Result::eSuccess);
 
-    VulkanHelpers::SubmitCommandBuffer(queues.graphics, commandBuffer, commands, oneTimeCommandsSync);
+    VulkanHelpers::SubmitCommandBuffer(GetQueue(queueType), commandBuffer, commands, oneTimeCommandsSync);
 
     VulkanHelpers::WaitForFences(device, { oneTimeCommandsSync.fence });
 
@@ -364,11 +497,12 @@ void Device::ExecuteOneTimeCommands(DeviceCommands commands) const
     Assert(result == vk::Result::eSuccess);
 }
 
-vk::CommandBuffer Device::AllocateCommandBuffer(CommandBufferType type) const
+vk::CommandBuffer Device::AllocateCommandBuffer(CommandBufferType type, QueueType queueType) const
 {
     vk::CommandBuffer commandBuffer;
 
-    const vk::CommandBufferAllocateInfo allocateInfo(commandPools.at(type), vk::CommandBufferLevel::ePrimary, 1);
+    const vk::CommandPool commandPool = commandPools.at(std::make_pair(queueType, type));
+    const vk::CommandBufferAllocateInfo allocateInfo(commandPool, vk::CommandBufferLevel::ePrimary, 1);
 
     const vk::Result result = device.allocateCommandBuffers(&allocateInfo, &commandBuffer);
     Assert(result == vk::Result::eSuccess);
@@ -376,6 +510,55 @@ vk::CommandBuffer Device::AllocateCommandBuffer(CommandBufferType type) const
     return commandBuffer;
 }
 
+QueueSubmission Device::Submit(QueueType queueType, vk::CommandBuffer commandBuffer,
+        const std::vector<QueueSubmission>& waitedSubmissions)
+{
+    std::vector<vk::Semaphore> waitSemaphores;
+    std::vector<uint64_t> waitValues;
+    waitSemaphores.reserve(waitedSubmissions.size());
+    waitValues.reserve(waitedSubmissions.size());
+
+    for (const QueueSubmission& waitedSubmission : waitedSubmissions)
+    {
+        waitSemaphores.push_back(timelines.at(waitedSubmission.queueType).semaphore);
+        waitValues.push_back(waitedSubmission.value);
+    }
+
+    const std::vector<vk::PipelineStageFlags> waitStages(waitedSubmissions.size(),
+            vk::PipelineStageFlagBits::eAllCommands);
+
+    QueueTimeline& timeline = timelines.at(queueType);
+
+    const QueueSubmission submission{ queueType, ++timeline.value };
+
+    const vk::TimelineSemaphoreSubmitInfo timelineSubmitInfo(
+            static_cast<uint32_t>(waitValues.size()), waitValues.data(), 1, &submission.value);
+
+    const vk::SubmitInfo submitInfo(static_cast<uint32_t>(waitSemaphores.size()),
+            waitSemaphores.data(), waitStages.data(), 1, &commandBuffer,
+            1, &timeline.semaphore, &timelineSubmitInfo);
+
+    const vk::Result result = GetQueue(queueType).submit({ submitInfo }, nullptr);
+    Assert(result == vk::Result::eSuccess);
+
+    return submission;
+}
+
+void Device::Wait(const QueueSubmission& submission) const
+{
+    VulkanHelpers::WaitForTimelineSemaphore(device, timelines.at(submission.queueType).semaphore, submission.value);
+}
+
+bool Device::IsComplete(const QueueSubmission& submission) const
+{
+    const vk::Semaphore semaphore = timelines.at(submission.queueType).semaphore;
+
+    const auto [result, completedValue] = device.getSemaphoreCounterValue(semaphore);
+    Assert(result == vk::Result::eSuccess);
+
+    return completedValue >= submission.value;
+}
+
 void Device::WaitIdle() const
 {
     const vk::Result result = device.waitIdle();
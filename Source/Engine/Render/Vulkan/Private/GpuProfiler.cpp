@@ -0,0 +1,294 @@
+#include "Engine/Render/Vulkan/GpuProfiler.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+#include "Engine/Filesystem/Filesystem.hpp"
+
+#include "Utils/Helpers.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kQueriesPerScope = 2;
+
+    static constexpr uint32_t kHostTraceThread = 0;
+    static constexpr uint32_t kDeviceTraceThread = 1;
+
+    static vk::QueryPool CreateTimestampQueryPool(uint32_t queryCount)
+    {
+        const vk::QueryPoolCreateInfo createInfo({}, vk::QueryType::eTimestamp, queryCount);
+
+        const auto [result, queryPool] = VulkanContext::device->Get().createQueryPool(createInfo);
+        Assert(result == vk::Result::eSuccess);
+
+        return queryPool;
+    }
+
+    static double GetMicroseconds(uint64_t timestampDelta)
+    {
+        const float timestampPeriod = VulkanContext::device->GetLimits().timestampPeriod;
+
+        return static_cast<double>(timestampDelta) * static_cast<double>(timestampPeriod) * 0.001;
+    }
+
+    static std::string GetTraceThreadMetadata(uint32_t thread, const char* name)
+    {
+        return Format(R"({"name":"thread_name","ph":"M","pid":0,"tid":%u,"args":{"name":"%s"}})", thread, name);
+    }
+}
+
+GpuProfiler::GpuProfiler()
+{
+    Assert(VulkanContext::device->GetLimits().timestampComputeAndGraphics);
+
+    queriesPerFrame = VulkanConfig::kGpuProfilerMaxScopeCount * Details::kQueriesPerScope;
+
+    queryPool = Details::CreateTimestampQueryPool(queriesPerFrame * VulkanConfig::kMaxFramesInFlight);
+
+    frames.resize(VulkanConfig::kMaxFramesInFlight);
+
+    hostStartTimePoint = std::chrono::high_resolution_clock::now();
+
+    Calibrate();
+}
+
+GpuProfiler::~GpuProfiler()
+{
+    VulkanContext::device->Get().destroyQueryPool(queryPool);
+}
+
+void GpuProfiler::BeginFrame(vk::CommandBuffer commandBuffer, uint32_t frameIndex_)
+{
+    Assert(frameIndex_ < frames.size());
+    Assert(depth == 0);
+
+    frameIndex = frameIndex_;
+
+    ReadFrame(frameIndex);
+
+    Frame& frame = frames[frameIndex];
+
+    frame.scopes.clear();
+    frame.hostBeginMicroseconds = GetHostMicroseconds();
+
+    commandBuffer.resetQueryPool(queryPool, frameIndex * queriesPerFrame, queriesPerFrame);
+
+    frameScopeIndex = BeginScope(commandBuffer, "Frame");
+}
+
+void GpuProfiler::EndFrame(vk::CommandBuffer commandBuffer)
+{
+    EndScope(commandBuffer, frameScopeIndex);
+
+    Assert(depth == 0);
+
+    frames[frameIndex].hostEndMicroseconds = GetHostMicroseconds();
+}
+
+uint32_t GpuProfiler::BeginScope(vk::CommandBuffer commandBuffer, const std::string& name)
+{
+    Frame& frame = frames[frameIndex];
+
+    Assert(frame.scopes.size() < VulkanConfig::kGpuProfilerMaxScopeCount);
+
+    const uint32_t scopeIndex = static_cast<uint32_t>(frame.scopes.size());
+    const uint32_t firstQuery = frameIndex * queriesPerFrame + scopeIndex * Details::kQueriesPerScope;
+
+    frame.scopes.push_back(Scope{ name, depth++, firstQuery });
+
+    if constexpr (VulkanConfig::kValidationEnabled)
+    {
+        commandBuffer.beginDebugUtilsLabelEXT(vk::DebugUtilsLabelEXT(name.c_str()));
+    }
+
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, queryPool, firstQuery);
+
+    return scopeIndex;
+}
+
+void GpuProfiler::EndScope(vk::CommandBuffer commandBuffer, uint32_t scopeIndex)
+{
+    const Scope& scope = frames[frameIndex].scopes[scopeIndex];
+
+    Assert(depth > 0 && scope.depth == depth - 1);
+
+    --depth;
+
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, queryPool, scope.firstQuery + 1);
+
+    if constexpr (VulkanConfig::kValidationEnabled)
+    {
+        commandBuffer.endDebugUtilsLabelEXT();
+    }
+}
+
+void GpuProfiler::ExportTrace(const Filepath& path) const
+{
+    std::vector<std::string> events{
+        Details::GetTraceThreadMetadata(Details::kHostTraceThread, "CPU"),
+        Details::GetTraceThreadMetadata(Details::kDeviceTraceThread, "GPU")
+    };
+
+    events.reserve(events.size() + traceEvents.size());
+
+    for (size_t i = 0; i < traceEvents.size(); ++i)
+    {
+        const TraceEvent& traceEvent = traceEvents[(nextTraceEventIndex + i) % traceEvents.size()];
+
+        const uint32_t thread = traceEvent.isDeviceEvent ? Details::kDeviceTraceThread : Details::kHostTraceThread;
+
+        events.push_back(Format(R"({"name":"%s","ph":"X","pid":0,"tid":%u,"ts":%.3f,"dur":%.3f})",
+                traceEvent.name.c_str(), thread, traceEvent.beginMicroseconds, traceEvent.durationMicroseconds));
+    }
+
+    std::string trace = "{\"traceEvents\":[\n";
+
+    for (size_t i = 0; i < events.size(); ++i)
+    {
+        trace += events[i];
+        trace += i + 1 < events.size() ? ",\n" : "\n";
+    }
+
+    trace += "],\"displayTimeUnit\":\"ms\"}\n";
+
+    Filesystem::WriteBinaryFile(path, ByteView(reinterpret_cast<const uint8_t*>(trace.data()), trace.size()));
+
+    LogI << "GPU trace exported: " << path.GetAbsolute() << "\n";
+}
+
+double GpuProfiler::GetHostMicroseconds() const
+{
+    const TimePoint now = std::chrono::high_resolution_clock::now();
+
+    return std::chrono::duration<double, std::micro>(now - hostStartTimePoint).count();
+}
+
+double GpuProfiler::GetHostMicroseconds(uint64_t timestamp) const
+{
+    if (timestamp >= calibrationTimestamp)
+    {
+        return calibrationHostMicroseconds + Details::GetMicroseconds(timestamp - calibrationTimestamp);
+    }
+
+    return calibrationHostMicroseconds - Details::GetMicroseconds(calibrationTimestamp - timestamp);
+}
+
+void GpuProfiler::Calibrate()
+{
+    // The device timestamp is assumed to be written halfway between the submission and the completion
+    const double hostBeginMicroseconds = GetHostMicroseconds();
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            commandBuffer.resetQueryPool(queryPool, 0, 1);
+
+            commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, queryPool, 0);
+        });
+
+    const double hostEndMicroseconds = GetHostMicroseconds();
+
+    const vk::Result result = VulkanContext::device->Get().getQueryPoolResults(queryPool, 0, 1,
+            sizeof(calibrationTimestamp), &calibrationTimestamp, sizeof(uint64_t),
+            vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+    Assert(result == vk::Result::eSuccess);
+
+    calibrationHostMicroseconds = (hostBeginMicroseconds + hostEndMicroseconds) * 0.5;
+}
+
+void GpuProfiler::ReadFrame(uint32_t index)
+{
+    Frame& frame = frames[index];
+
+    if (frame.scopes.empty())
+    {
+        return;
+    }
+
+    const uint32_t queryCount = static_cast<uint32_t>(frame.scopes.size()) * Details::kQueriesPerScope;
+
+    std::vector<uint64_t> timestamps(queryCount);
+
+    const vk::Result result = VulkanContext::device->Get().getQueryPoolResults(queryPool,
+            index * queriesPerFrame, queryCount, timestamps.size() * sizeof(uint64_t), timestamps.data(),
+            sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+
+    if (result != vk::Result::eSuccess)
+    {
+        return;
+    }
+
+    AddTraceEvent(TraceEvent{ "Frame", false, frame.hostBeginMicroseconds,
+        frame.hostEndMicroseconds - frame.hostBeginMicroseconds });
+
+    for (size_t i = 0; i < frame.scopes.size(); ++i)
+    {
+        const uint64_t beginTimestamp = timestamps[i * Details::kQueriesPerScope];
+        const uint64_t endTimestamp = timestamps[i * Details::kQueriesPerScope + 1];
+
+        const double durationMicroseconds = Details::GetMicroseconds(endTimestamp - beginTimestamp);
+
+        AddSample(frame.scopes[i], static_cast<float>(durationMicroseconds * 0.001));
+
+        AddTraceEvent(TraceEvent{ frame.scopes[i].name, true,
+            GetHostMicroseconds(beginTimestamp), durationMicroseconds });
+    }
+}
+
+void GpuProfiler::AddSample(const Scope& scope, float miliseconds)
+{
+    const auto pred = [&scope](const ScopeStats& stats)
+        {
+            return stats.depth == scope.depth && stats.name == scope.name;
+        };
+
+    const auto it = std::ranges::find_if(scopeStats, pred);
+
+    const size_t index = static_cast<size_t>(std::distance(scopeStats.begin(), it));
+
+    if (it == scopeStats.end())
+    {
+        scopeStats.push_back(ScopeStats{ scope.name, scope.depth, 0.0f });
+        scopeSamples.emplace_back();
+    }
+
+    ScopeSamples& samples = scopeSamples[index];
+
+    if (samples.values.size() < VulkanConfig::kGpuProfilerAverageFrameCount)
+    {
+        samples.values.push_back(miliseconds);
+    }
+    else
+    {
+        samples.sum -= samples.values[samples.nextIndex];
+        samples.values[samples.nextIndex] = miliseconds;
+        samples.nextIndex = (samples.nextIndex + 1) % VulkanConfig::kGpuProfilerAverageFrameCount;
+    }
+
+    samples.sum += miliseconds;
+
+    scopeStats[index].averageMiliseconds = samples.sum / static_cast<float>(samples.values.size());
+}
+
+void GpuProfiler::AddTraceEvent(const TraceEvent& traceEvent)
+{
+    if (traceEvents.size() < VulkanConfig::kGpuProfilerTraceEventCount)
+    {
+        traceEvents.push_back(traceEvent);
+    }
+    else
+    {
+        traceEvents[nextTraceEventIndex] = traceEvent;
+        nextTraceEventIndex = (nextTraceEventIndex + 1) % VulkanConfig::kGpuProfilerTraceEventCount;
+    }
+}
+
+GpuScope::GpuScope(vk::CommandBuffer commandBuffer_, const std::string& name)
+    : commandBuffer(commandBuffer_)
+{
+    scopeIndex = VulkanContext::gpuProfiler->BeginScope(commandBuffer, name);
+}
+
+GpuScope::~GpuScope()
+{
+    VulkanContext::gpuProfiler->EndScope(commandBuffer, scopeIndex);
+}
@@ -202,7 +202,8 @@ std::unique_ptr<GraphicsPipeline> GraphicsPipeline::Create(
             &depthStencilState, &colorBlendState, &dynamicState,
             layout, renderPass, 0, nullptr, 0);
 
-    const auto [result, pipeline] = VulkanContext::device->Get().createGraphicsPipeline(nullptr, createInfo);
+    const auto [result, pipeline] = VulkanContext::device->Get().createGraphicsPipeline(
+            VulkanContext::pipelineCache->Get(), createInfo);
     Assert(result == vk::Result::eSuccess);
 
     return std::unique_ptr<GraphicsPipeline>(new GraphicsPipeline(pipeline, layout));
@@ -0,0 +1,180 @@
+#include "Engine/Render/Vulkan/PipelineCache.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Filesystem/Filesystem.hpp"
+
+#include "Utils/Serialization.hpp"
+#include "Utils/Assert.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kMagic = 0x48435050; // "PPCH"
+
+    static constexpr uint32_t kVersion = 1;
+
+    using Uuid = std::array<uint8_t, VK_UUID_SIZE>;
+
+    struct Header
+    {
+        uint32_t magic = kMagic;
+        uint32_t version = kVersion;
+        uint32_t vendorId = 0;
+        uint32_t deviceId = 0;
+        uint32_t driverVersion = 0;
+        Uuid deviceUuid{};
+        Uuid pipelineCacheUuid{};
+        uint64_t dataSize = 0;
+        uint64_t dataHash = 0;
+    };
+
+    static uint64_t GetDataHash(const ByteView& data)
+    {
+        const std::string_view dataString(reinterpret_cast<const char*>(data.data), data.size);
+
+        return static_cast<uint64_t>(std::hash<std::string_view>()(dataString));
+    }
+
+    // Header is written to disk as is, so its padding bytes are zeroed before the fields are filled
+    static void FillDeviceHeader(Header& header)
+    {
+        const vk::PhysicalDevice physicalDevice = VulkanContext::device->GetPhysicalDevice();
+
+        const auto properties = physicalDevice.getProperties2<
+                vk::PhysicalDeviceProperties2, vk::PhysicalDeviceIDProperties>();
+
+        const vk::PhysicalDeviceProperties& deviceProperties
+                = properties.get<vk::PhysicalDeviceProperties2>().properties;
+
+        const vk::PhysicalDeviceIDProperties& idProperties
+                = properties.get<vk::PhysicalDeviceIDProperties>();
+
+        std::memset(&header, 0, sizeof(Header));
+
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.vendorId = deviceProperties.vendorID;
+        header.deviceId = deviceProperties.deviceID;
+        header.driverVersion = deviceProperties.driverVersion;
+
+        std::ranges::copy(idProperties.deviceUUID, header.deviceUuid.begin());
+        std::ranges::copy(deviceProperties.pipelineCacheUUID, header.pipelineCacheUuid.begin());
+    }
+
+    static Header GetDeviceHeader()
+    {
+        Header header;
+
+        FillDeviceHeader(header);
+
+        return header;
+    }
+
+    static bool IsHeaderValid(const Header& header, const Header& deviceHeader)
+    {
+        return header.magic == deviceHeader.magic
+                && header.version == deviceHeader.version
+                && header.vendorId == deviceHeader.vendorId
+                && header.deviceId == deviceHeader.deviceId
+                && header.driverVersion == deviceHeader.driverVersion
+                && header.deviceUuid == deviceHeader.deviceUuid
+                && header.pipelineCacheUuid == deviceHeader.pipelineCacheUuid;
+    }
+
+    static Bytes LoadPipelineCacheData(const Filepath& path)
+    {
+        if (!path.Exists())
+        {
+            return Bytes();
+        }
+
+        const Bytes bytes = Filesystem::ReadBinaryFile(path);
+
+        BinaryReader reader{ ByteView(bytes) };
+
+        Header header;
+        reader.Read(header);
+
+        if (!reader.IsValid() || !IsHeaderValid(header, GetDeviceHeader()))
+        {
+            LogI << "Pipeline cache is outdated: " << path.GetAbsolute() << "\n";
+            return Bytes();
+        }
+
+        Bytes data;
+        reader.Read(data);
+
+        if (!reader.IsValid() || data.size() != header.dataSize || GetDataHash(ByteView(data)) != header.dataHash)
+        {
+            LogW << "Corrupted pipeline cache: " << path.GetAbsolute() << "\n";
+            return Bytes();
+        }
+
+        return data;
+    }
+}
+
+std::unique_ptr<PipelineCache> PipelineCache::Create(const Filepath& path)
+{
+    EASY_FUNCTION()
+
+    const Bytes data = Details::LoadPipelineCacheData(path);
+
+    const vk::Device device = VulkanContext::device->Get();
+
+    const vk::PipelineCacheCreateInfo createInfo({}, data.size(), data.data());
+
+    const auto [result, pipelineCache] = device.createPipelineCache(createInfo);
+
+    if (result == vk::Result::eSuccess)
+    {
+        LogD << "Pipeline cache created: " << data.size() << " bytes loaded" << "\n";
+
+        return std::unique_ptr<PipelineCache>(new PipelineCache(pipelineCache, path));
+    }
+
+    Assert(!data.empty());
+
+    LogW << "Failed to create pipeline cache from file data, using empty one\n";
+
+    const auto [emptyResult, emptyPipelineCache] = device.createPipelineCache(vk::PipelineCacheCreateInfo());
+    Assert(emptyResult == vk::Result::eSuccess);
+
+    return std::unique_ptr<PipelineCache>(new PipelineCache(emptyPipelineCache, path));
+}
+
+PipelineCache::PipelineCache(vk::PipelineCache pipelineCache_, const Filepath& path_)
+    : pipelineCache(pipelineCache_)
+    , path(path_)
+{}
+
+PipelineCache::~PipelineCache()
+{
+    VulkanContext::device->Get().destroyPipelineCache(pipelineCache);
+}
+
+void PipelineCache::Save() const
+{
+    EASY_FUNCTION()
+
+    const auto [result, data] = VulkanContext::device->Get().getPipelineCacheData(pipelineCache);
+
+    if (result != vk::Result::eSuccess)
+    {
+        LogW << "Failed to retrieve pipeline cache data\n";
+        return;
+    }
+
+    Details::Header header;
+
+    Details::FillDeviceHeader(header);
+
+    header.dataSize = data.size();
+    header.dataHash = Details::GetDataHash(ByteView(data));
+
+    BinaryWriter writer;
+
+    writer.Write(header);
+    writer.Write(data);
+
+    Filesystem::WriteBinaryFile(path, ByteView(writer.GetBytes()));
+}
@@ -7,6 +7,9 @@
 
 namespace Details
 {
+    // Matches rgba8 storage image format of the path tracer and allows readback without conversion
+    static constexpr vk::Format kOffscreenFormat = vk::Format::eR8G8B8A8Unorm;
+
     struct SwapchainData
     {
         vk::SwapchainKHR swapchain;
@@ -162,11 +165,8 @@ namespace Details
         return SwapchainData{ swapchain, format.format, extent };
     }
 
-    static std::vector<vk::Image> RetrieveImages(vk::SwapchainKHR swapchain)
+    static void InitializeImages(const std::vector<vk::Image>& images)
     {
-        const auto [result, images] = VulkanContext::device->Get().getSwapchainImagesKHR(swapchain);
-        Assert(result == vk::Result::eSuccess);
-
         for (const auto& image : images)
         {
             VulkanContext::device->ExecuteOneTimeCommands([&image](vk::CommandBuffer commandBuffer)
@@ -187,6 +187,39 @@ namespace Details
 
             VulkanHelpers::SetObjectName(VulkanContext::device->Get(), images[i], imageName);
         }
+    }
+
+    static std::vector<vk::Image> RetrieveImages(vk::SwapchainKHR swapchain)
+    {
+        const auto [result, images] = VulkanContext::device->Get().getSwapchainImagesKHR(swapchain);
+        Assert(result == vk::Result::eSuccess);
+
+        InitializeImages(images);
+
+        return images;
+    }
+
+    static std::vector<vk::Image> CreateOffscreenImages(const vk::Extent2D& extent)
+    {
+        const ImageDescription imageDescription{
+            ImageType::e2D, kOffscreenFormat,
+            VulkanHelpers::GetExtent3D(extent),
+            1, 1, vk::SampleCountFlagBits::e1,
+            vk::ImageTiling::eOptimal,
+            vk::ImageUsageFlagBits::eColorAttachment
+            | vk::ImageUsageFlagBits::eStorage
+            | vk::ImageUsageFlagBits::eTransferSrc,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        };
+
+        std::vector<vk::Image> images(VulkanConfig::kSwapchainMinImageCount);
+
+        for (auto& image : images)
+        {
+            image = VulkanContext::imageManager->CreateImage(imageDescription, ImageCreateFlags::kNone);
+        }
+
+        InitializeImages(images);
 
         return images;
     }
@@ -215,6 +248,13 @@ namespace Details
 
 std::unique_ptr<Swapchain> Swapchain::Create(const Description& description)
 {
+    if (!VulkanContext::surface)
+    {
+        LogD << "Offscreen swapchain created" << "\n";
+
+        return std::unique_ptr<Swapchain>(new Swapchain(nullptr, Details::kOffscreenFormat, description.surfaceExtent));
+    }
+
     const auto& [swapchain, format, extent] = Details::CreateSwapchain(description);
 
     LogD << "Swapchain created" << "\n";
@@ -227,7 +267,7 @@ Swapchain::Swapchain(vk::SwapchainKHR swapchain_, vk::Format format_, const vk::
     , format(format_)
     , extent(extent_)
 {
-    images = Details::RetrieveImages(swapchain);
+    images = swapchain ? Details::RetrieveImages(swapchain) : Details::CreateOffscreenImages(extent);
     imageViews = Details::CreateImageViews(images, format);
 }
 
@@ -240,6 +280,15 @@ void Swapchain::Recreate(const Description& description)
 {
     Destroy();
 
+    if (IsOffscreen())
+    {
+        extent = description.surfaceExtent;
+        images = Details::CreateOffscreenImages(extent);
+        imageViews = Details::CreateImageViews(images, format);
+
+        return;
+    }
+
     const auto& [swapchain_, format_, extent_] = Details::CreateSwapchain(description);
 
     swapchain = swapchain_;
@@ -256,5 +305,15 @@ void Swapchain::Destroy()
         VulkanContext::device->Get().destroyImageView(imageView);
     }
 
+    if (IsOffscreen())
+    {
+        for (const auto& image : images)
+        {
+            VulkanContext::imageManager->DestroyImage(image);
+        }
+
+        return;
+    }
+
     VulkanContext::device->Get().destroySwapchainKHR(swapchain);
 }
@@ -8,6 +8,10 @@
 
 namespace Details
 {
+    static const Filepath kPipelineCachePath(Config::kCacheDirectory.GetAbsolute() + "PipelineCache.bin");
+
+    static const Filepath kShaderCacheDirectory(Config::kCacheDirectory.GetAbsolute() + "Shaders/");
+
     static void InitializeDefaultDispatcher()
     {
         const vk::DynamicLoader dynamicLoader;
@@ -18,8 +22,13 @@ namespace Details
     }
 
     static std::vector<const char*> UpdateRequiredExtensions(
-            const std::vector<const char*>& requiredExtension)
+            const std::vector<const char*>& requiredExtension, bool headless)
     {
+        if (headless)
+        {
+            return requiredExtension;
+        }
+
         uint32_t count = 0;
         const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&count);
 
@@ -30,6 +39,23 @@ namespace Details
 
         return extensions;
     }
+
+    // Mesh data, rasterization and ray tracing copies share the pool
+    static vk::BufferUsageFlags GetBufferPoolUsage()
+    {
+        vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eIndexBuffer
+                | vk::BufferUsageFlagBits::eVertexBuffer
+                | vk::BufferUsageFlagBits::eStorageBuffer
+                | vk::BufferUsageFlagBits::eTransferSrc;
+
+        if constexpr (Config::kRayTracingEnabled)
+        {
+            usage |= vk::BufferUsageFlagBits::eShaderDeviceAddress
+                    | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+        }
+
+        return usage;
+    }
 }
 
 std::unique_ptr<Instance> VulkanContext::instance;
@@ -37,46 +63,73 @@ std::unique_ptr<Device> VulkanContext::device;
 std::unique_ptr<Surface> VulkanContext::surface;
 std::unique_ptr<Swapchain> VulkanContext::swapchain;
 std::unique_ptr<DescriptorPool> VulkanContext::descriptorPool;
+std::unique_ptr<PipelineCache> VulkanContext::pipelineCache;
 std::unique_ptr<ShaderManager> VulkanContext::shaderManager;
 std::unique_ptr<MemoryManager> VulkanContext::memoryManager;
 std::unique_ptr<BufferManager> VulkanContext::bufferManager;
 std::unique_ptr<ImageManager> VulkanContext::imageManager;
 std::unique_ptr<TextureManager> VulkanContext::textureManager;
 std::unique_ptr<AccelerationStructureManager> VulkanContext::accelerationStructureManager;
+std::unique_ptr<UploadManager> VulkanContext::uploadManager;
+std::unique_ptr<TransientAllocator> VulkanContext::transientAllocator;
+std::unique_ptr<BufferPool> VulkanContext::bufferPool;
+std::unique_ptr<GpuProfiler> VulkanContext::gpuProfiler;
 
-void VulkanContext::Create(const Window& window)
+void VulkanContext::Create(const Window* window)
 {
     EASY_FUNCTION()
 
     Details::InitializeDefaultDispatcher();
 
     const std::vector<const char*> requiredExtensions
-            = Details::UpdateRequiredExtensions(VulkanConfig::kRequiredExtensions);
+            = Details::UpdateRequiredExtensions(VulkanConfig::kRequiredExtensions, window == nullptr);
 
     instance = Instance::Create(requiredExtensions);
-    surface = Surface::Create(window.Get());
+
+    if (window)
+    {
+        surface = Surface::Create(window->Get());
+    }
+
     device = Device::Create(VulkanConfig::kRequiredDeviceFeatures, VulkanConfig::kRequiredDeviceExtensions);
-    swapchain = Swapchain::Create(Swapchain::Description{ window.GetExtent(), Config::kVSyncEnabled });
     descriptorPool = DescriptorPool::Create(VulkanConfig::kMaxDescriptorSetCount, VulkanConfig::kDescriptorPoolSizes);
+    pipelineCache = PipelineCache::Create(Details::kPipelineCachePath);
 
-    shaderManager = std::make_unique<ShaderManager>(Config::kShadersDirectory);
+    shaderManager = std::make_unique<ShaderManager>(Config::kShadersDirectory, Details::kShaderCacheDirectory);
     memoryManager = std::make_unique<MemoryManager>();
     bufferManager = std::make_unique<BufferManager>();
     imageManager = std::make_unique<ImageManager>();
     textureManager = std::make_unique<TextureManager>();
     accelerationStructureManager = std::make_unique<AccelerationStructureManager>();
+    uploadManager = std::make_unique<UploadManager>();
+    transientAllocator = std::make_unique<TransientAllocator>();
+    bufferPool = std::make_unique<BufferPool>(Details::GetBufferPoolUsage());
+    gpuProfiler = std::make_unique<GpuProfiler>();
+
+    // Offscreen swapchain images are allocated by the image manager
+    const vk::Extent2D extent = window ? window->GetExtent() : Config::kExtent;
+    swapchain = Swapchain::Create(Swapchain::Description{ extent, Config::kVSyncEnabled });
 }
 
 void VulkanContext::Destroy()
 {
+    swapchain.reset();
+
+    gpuProfiler.reset();
+    bufferPool.reset();
+    transientAllocator.reset();
+    uploadManager.reset();
     accelerationStructureManager.reset();
     textureManager.reset();
     imageManager.reset();
     bufferManager.reset();
     memoryManager.reset();
     shaderManager.reset();
+
+    pipelineCache->Save();
+    pipelineCache.reset();
+
     descriptorPool.reset();
-    swapchain.reset();
     device.reset();
     surface.reset();
     instance.reset();
@@ -42,11 +42,26 @@ const SyncScope SyncScope::kIndicesRead{
     vk::AccessFlagBits::eIndexRead
 };
 
+const SyncScope SyncScope::kIndirectCommandRead{
+    vk::PipelineStageFlagBits::eDrawIndirect,
+    vk::AccessFlagBits::eIndirectCommandRead
+};
+
 const SyncScope SyncScope::kAccelerationStructureBuild{
     vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
     vk::AccessFlagBits::eAccelerationStructureReadKHR
 };
 
+const SyncScope SyncScope::kAccelerationStructureWrite{
+    vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+    vk::AccessFlagBits::eAccelerationStructureWriteKHR
+};
+
+const SyncScope SyncScope::kAccelerationStructureShaderRead{
+    vk::PipelineStageFlagBits::eRayTracingShaderKHR | vk::PipelineStageFlagBits::eComputeShader,
+    vk::AccessFlagBits::eAccelerationStructureReadKHR
+};
+
 const SyncScope SyncScope::kRayTracingShaderWrite{
     vk::PipelineStageFlagBits::eRayTracingShaderKHR,
     vk::AccessFlagBits::eShaderWrite
@@ -156,6 +171,18 @@ vk::Semaphore VulkanHelpers::CreateSemaphore(vk::Device device)
     return semaphore;
 }
 
+vk::Semaphore VulkanHelpers::CreateTimelineSemaphore(vk::Device device, uint64_t initialValue)
+{
+    const vk::SemaphoreTypeCreateInfo typeCreateInfo(vk::SemaphoreType::eTimeline, initialValue);
+
+    const vk::SemaphoreCreateInfo createInfo({}, &typeCreateInfo);
+
+    const auto [result, semaphore] = device.createSemaphore(createInfo);
+    Assert(result == vk::Result::eSuccess);
+
+    return semaphore;
+}
+
 vk::Fence VulkanHelpers::CreateFence(vk::Device device, vk::FenceCreateFlags flags)
 {
     const vk::FenceCreateInfo createInfo(flags);
@@ -260,3 +287,52 @@ void VulkanHelpers::WaitForFences(vk::Device device, std::vector<vk::Fence> fenc
 {
     while (device.waitForFences(fences, true, Numbers::kMaxUint) == vk::Result::eTimeout) {}
 }
+
+void VulkanHelpers::WaitForTimelineSemaphore(vk::Device device, vk::Semaphore semaphore, uint64_t value)
+{
+    const vk::SemaphoreWaitInfo waitInfo({}, 1, &semaphore, &value);
+
+    while (device.waitSemaphores(waitInfo, Numbers::kMaxUint) == vk::Result::eTimeout) {}
+}
+
+void VulkanHelpers::InsertMemoryBarrier(vk::CommandBuffer commandBuffer, const PipelineBarrier& barrier)
+{
+    const vk::MemoryBarrier memoryBarrier(barrier.waitedScope.access, barrier.blockedScope.access);
+
+    commandBuffer.pipelineBarrier(barrier.waitedScope.stages, barrier.blockedScope.stages,
+            vk::DependencyFlags(), { memoryBarrier }, {}, {});
+}
+
+void VulkanHelpers::ReleaseBufferOwnership(vk::CommandBuffer commandBuffer, vk::Buffer buffer,
+        const QueueFamilyTransfer& transfer, const SyncScope& waitedScope, vk::DeviceSize offset, vk::DeviceSize size)
+{
+    if (!transfer.IsRequired())
+    {
+        return;
+    }
+
+    const vk::BufferMemoryBarrier bufferMemoryBarrier(
+            waitedScope.access, vk::AccessFlags(),
+            transfer.srcFamilyIndex, transfer.dstFamilyIndex,
+            buffer, offset, size);
+
+    commandBuffer.pipelineBarrier(waitedScope.stages, vk::PipelineStageFlagBits::eBottomOfPipe,
+            vk::DependencyFlags(), {}, { bufferMemoryBarrier }, {});
+}
+
+void VulkanHelpers::AcquireBufferOwnership(vk::CommandBuffer commandBuffer, vk::Buffer buffer,
+        const QueueFamilyTransfer& transfer, const SyncScope& blockedScope, vk::DeviceSize offset, vk::DeviceSize size)
+{
+    if (!transfer.IsRequired())
+    {
+        return;
+    }
+
+    const vk::BufferMemoryBarrier bufferMemoryBarrier(
+            vk::AccessFlags(), blockedScope.access,
+            transfer.srcFamilyIndex, transfer.dstFamilyIndex,
+            buffer, offset, size);
+
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, blockedScope.stages,
+            vk::DependencyFlags(), {}, { bufferMemoryBarrier }, {});
+}
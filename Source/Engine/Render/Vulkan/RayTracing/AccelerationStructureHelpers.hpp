@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
+
 #include "Utils/DataHelpers.hpp"
 
 struct BlasGeometryData
@@ -14,6 +16,20 @@ struct BlasGeometryData
     ByteView vertices;
 };
 
+// Geometry which already resides in buffers created with
+// eShaderDeviceAddress and eAccelerationStructureBuildInputReadOnlyKHR usage
+struct BlasGeometryBuffers
+{
+    vk::IndexType indexType;
+    uint32_t indexCount;
+    BufferSlice indexBuffer;
+
+    vk::Format vertexFormat;
+    uint32_t vertexStride;
+    uint32_t vertexCount;
+    BufferSlice vertexBuffer;
+};
+
 struct TlasInstanceData
 {
     vk::AccelerationStructureKHR blas;
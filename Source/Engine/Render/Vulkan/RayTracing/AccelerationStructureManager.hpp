@@ -9,6 +9,10 @@ public:
 
     vk::AccelerationStructureKHR GenerateBlas(const BlasGeometryData& geometryData);
 
+    // Builds are recorded in batches which share one suballocated scratch buffer
+    std::vector<vk::AccelerationStructureKHR> GenerateBlases(
+            const std::vector<BlasGeometryBuffers>& geometries, bool compact);
+
     vk::AccelerationStructureKHR GenerateTlas(const std::vector<TlasInstanceData>& instances);
 
     void DestroyAccelerationStructure(vk::AccelerationStructureKHR accelerationStructure);
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/RayTracing/AccelerationStructureHelpers.hpp"
+
+// TLAS which is refitted in place when instance transforms change
+// and periodically rebuilt when refits are likely to have degraded its trace performance
+class DynamicTlas
+{
+public:
+    struct Stats
+    {
+        uint32_t refitCount = 0;
+        uint32_t rebuildCount = 0;
+        float refitMiliseconds = 0.0f; // GPU time of the last refit
+        float rebuildMiliseconds = 0.0f; // GPU time of the last rebuild
+    };
+
+    explicit DynamicTlas(const std::vector<TlasInstanceData>& instances_);
+
+    ~DynamicTlas();
+
+    vk::AccelerationStructureKHR Get() const { return tlas; }
+
+    const Stats& GetStats() const { return stats; }
+
+    uint32_t GetInstanceCount() const { return static_cast<uint32_t>(instances.size()); }
+
+    void SetInstanceTransform(uint32_t instanceIndex, const glm::mat4& transform);
+
+    // Writes changed instances and records a refit or a rebuild, has to be called at most once per frame
+    void Update(vk::CommandBuffer commandBuffer);
+
+private:
+    // Instance buffers are cycled between frames in flight, so the host never writes data read by the GPU
+    struct Slot
+    {
+        vk::Buffer instanceBuffer;
+        ByteAccess instanceMemory;
+        std::vector<uint32_t> pendingInstances;
+        std::optional<vk::BuildAccelerationStructureModeKHR> measuredMode;
+    };
+
+    vk::AccelerationStructureKHR tlas;
+    vk::Buffer storageBuffer;
+    vk::Buffer scratchBuffer;
+
+    vk::QueryPool queryPool;
+
+    std::vector<vk::AccelerationStructureInstanceKHR> instances;
+
+    std::vector<Slot> slots;
+    uint32_t slotIndex = 0;
+
+    bool dirty = false;
+
+    uint32_t refitsSinceRebuild = 0;
+    uint32_t changedSinceRebuild = 0;
+    std::vector<bool> changedSinceRebuildFlags;
+
+    Stats stats;
+
+    vk::BuildAccelerationStructureModeKHR SelectBuildMode() const;
+
+    void RecordBuild(vk::CommandBuffer commandBuffer, vk::Buffer instanceBuffer,
+            vk::BuildAccelerationStructureModeKHR mode) const;
+
+    void ReadTimestamps(uint32_t index);
+};
@@ -1,6 +1,13 @@
+#include <numeric>
+
 #include "Engine/Render/Vulkan/RayTracing/AccelerationStructureManager.hpp"
 
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+
+#include "Utils/Helpers.hpp"
+#include "Utils/TimeHelpers.hpp"
+#include "Utils/Logger.hpp"
 
 namespace Details
 {
@@ -8,12 +15,27 @@ namespace Details
 
     using AccelerationStructureEntry = std::pair<vk::AccelerationStructureKHR, vk::Buffer>;
 
+    struct BlasBuildInput
+    {
+        vk::AccelerationStructureGeometryKHR geometry;
+        vk::AccelerationStructureBuildRangeInfoKHR rangeInfo;
+        vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo;
+    };
+
+    // Consecutive build inputs whose scratch memory fits into VulkanConfig::kBlasBatchScratchSize
+    struct BlasBatch
+    {
+        size_t begin = 0;
+        size_t end = 0;
+        vk::DeviceSize scratchSize = 0;
+    };
+
     static vk::AccelerationStructureBuildSizesInfoKHR GetBuildSizesInfo(vk::AccelerationStructureTypeKHR type,
-            const vk::AccelerationStructureGeometryKHR& geometry, uint32_t primitiveCount)
+            vk::BuildAccelerationStructureFlagsKHR flags, const vk::AccelerationStructureGeometryKHR& geometry,
+            uint32_t primitiveCount)
     {
         const vk::AccelerationStructureBuildGeometryInfoKHR buildInfo(
-                type, vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace,
-                vk::BuildAccelerationStructureModeKHR::eBuild,
+                type, flags, vk::BuildAccelerationStructureModeKHR::eBuild,
                 vk::AccelerationStructureKHR(), vk::AccelerationStructureKHR(),
                 1, &geometry, nullptr, vk::DeviceOrHostAddressKHR(), nullptr);
 
@@ -76,29 +98,46 @@ namespace Details
         return buffer;
     }
 
-    static AccelerationStructureEntry GenerateAccelerationStructure(vk::AccelerationStructureTypeKHR type,
-            const vk::AccelerationStructureGeometryKHR& geometry, uint32_t primitiveCount)
+    static AccelerationStructureEntry CreateAccelerationStructure(
+            vk::AccelerationStructureTypeKHR type, vk::DeviceSize size)
     {
-        const vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo
-                = Details::GetBuildSizesInfo(type, geometry, primitiveCount);
-
         const vk::Buffer storageBuffer = Details::CreateAccelerationStructureBuffer(
-                buildSizesInfo.accelerationStructureSize, vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR);
-
-        const vk::Buffer buildScratchBuffer = Details::CreateAccelerationStructureBuffer(
-                buildSizesInfo.buildScratchSize, vk::BufferUsageFlagBits::eStorageBuffer);
+                size, vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR);
 
         const vk::AccelerationStructureCreateInfoKHR createInfo({}, storageBuffer, 0,
-                buildSizesInfo.accelerationStructureSize, type, vk::DeviceAddress());
+                size, type, vk::DeviceAddress());
 
         const auto [result, accelerationStructure]
                 = VulkanContext::device->Get().createAccelerationStructureKHR(createInfo);
 
         Assert(result == vk::Result::eSuccess);
 
+        return std::make_pair(accelerationStructure, storageBuffer);
+    }
+
+    static void DestroyAccelerationStructure(const AccelerationStructureEntry& entry)
+    {
+        VulkanContext::device->Get().destroyAccelerationStructureKHR(entry.first);
+        VulkanContext::bufferManager->DestroyBuffer(entry.second);
+    }
+
+    static AccelerationStructureEntry GenerateAccelerationStructure(vk::AccelerationStructureTypeKHR type,
+            const vk::AccelerationStructureGeometryKHR& geometry, uint32_t primitiveCount)
+    {
+        constexpr vk::BuildAccelerationStructureFlagsKHR flags
+                = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
+
+        const vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo
+                = Details::GetBuildSizesInfo(type, flags, geometry, primitiveCount);
+
+        const auto [accelerationStructure, storageBuffer]
+                = Details::CreateAccelerationStructure(type, buildSizesInfo.accelerationStructureSize);
+
+        const vk::Buffer buildScratchBuffer = Details::CreateAccelerationStructureBuffer(
+                buildSizesInfo.buildScratchSize, vk::BufferUsageFlagBits::eStorageBuffer);
+
         const vk::AccelerationStructureBuildGeometryInfoKHR buildInfo(
-                type, vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace,
-                vk::BuildAccelerationStructureModeKHR::eBuild,
+                type, flags, vk::BuildAccelerationStructureModeKHR::eBuild,
                 nullptr, accelerationStructure, 1, &geometry, nullptr,
                 VulkanContext::device->GetAddress(buildScratchBuffer));
 
@@ -114,6 +153,125 @@ namespace Details
 
         return std::make_pair(accelerationStructure, storageBuffer);
     }
+
+    static vk::BuildAccelerationStructureFlagsKHR GetBlasBuildFlags(bool compact)
+    {
+        vk::BuildAccelerationStructureFlagsKHR flags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
+
+        if (compact)
+        {
+            flags |= vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction;
+        }
+
+        return flags;
+    }
+
+    static BlasBuildInput GetBlasBuildInput(const BlasGeometryBuffers& geometryBuffers,
+            vk::BuildAccelerationStructureFlagsKHR flags)
+    {
+        const BufferSlice& vertexBuffer = geometryBuffers.vertexBuffer;
+        const BufferSlice& indexBuffer = geometryBuffers.indexBuffer;
+
+        const vk::DeviceAddress vertexAddress = VulkanContext::device->GetAddress(vertexBuffer.buffer);
+        const vk::DeviceAddress indexAddress = VulkanContext::device->GetAddress(indexBuffer.buffer);
+
+        const vk::AccelerationStructureGeometryTrianglesDataKHR trianglesData(
+                geometryBuffers.vertexFormat, vertexAddress + vertexBuffer.offset,
+                geometryBuffers.vertexStride, geometryBuffers.vertexCount - 1,
+                geometryBuffers.indexType, indexAddress + indexBuffer.offset, nullptr);
+
+        BlasBuildInput buildInput;
+
+        buildInput.geometry = vk::AccelerationStructureGeometryKHR(
+                vk::GeometryTypeKHR::eTriangles, trianglesData,
+                vk::GeometryFlagsKHR());
+
+        buildInput.rangeInfo = vk::AccelerationStructureBuildRangeInfoKHR(geometryBuffers.indexCount / 3, 0, 0, 0);
+
+        buildInput.buildSizesInfo = GetBuildSizesInfo(vk::AccelerationStructureTypeKHR::eBottomLevel,
+                flags, buildInput.geometry, buildInput.rangeInfo.primitiveCount);
+
+        return buildInput;
+    }
+
+    static std::vector<BlasBatch> SplitBlasesIntoBatches(const std::vector<BlasBuildInput>& buildInputs,
+            vk::DeviceSize scratchAlignment)
+    {
+        std::vector<BlasBatch> batches;
+
+        for (size_t i = 0; i < buildInputs.size(); ++i)
+        {
+            const vk::DeviceSize scratchSize
+                    = AlignUp(buildInputs[i].buildSizesInfo.buildScratchSize, scratchAlignment);
+
+            if (batches.empty() || batches.back().scratchSize + scratchSize > VulkanConfig::kBlasBatchScratchSize)
+            {
+                batches.push_back(BlasBatch{ i, i, 0 });
+            }
+
+            batches.back().end = i + 1;
+            batches.back().scratchSize += scratchSize;
+        }
+
+        return batches;
+    }
+
+    static vk::QueryPool CreateCompactedSizeQueryPool(uint32_t queryCount)
+    {
+        const vk::QueryPoolCreateInfo createInfo({},
+                vk::QueryType::eAccelerationStructureCompactedSizeKHR, queryCount);
+
+        const auto [result, queryPool] = VulkanContext::device->Get().createQueryPool(createInfo);
+        Assert(result == vk::Result::eSuccess);
+
+        return queryPool;
+    }
+
+    static std::vector<vk::DeviceSize> ReadCompactedSizes(vk::QueryPool queryPool, uint32_t queryCount)
+    {
+        std::vector<vk::DeviceSize> compactedSizes(queryCount);
+
+        const vk::Result result = VulkanContext::device->Get().getQueryPoolResults(queryPool, 0, queryCount,
+                compactedSizes.size() * sizeof(vk::DeviceSize), compactedSizes.data(), sizeof(vk::DeviceSize),
+                vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+
+        Assert(result == vk::Result::eSuccess);
+
+        return compactedSizes;
+    }
+
+    static std::vector<AccelerationStructureEntry> CompactBlases(const std::vector<AccelerationStructureEntry>& blases,
+            const std::vector<vk::DeviceSize>& compactedSizes)
+    {
+        EASY_FUNCTION()
+
+        std::vector<AccelerationStructureEntry> compactedBlases;
+        compactedBlases.reserve(blases.size());
+
+        for (const vk::DeviceSize compactedSize : compactedSizes)
+        {
+            compactedBlases.push_back(CreateAccelerationStructure(
+                    vk::AccelerationStructureTypeKHR::eBottomLevel, compactedSize));
+        }
+
+        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+            {
+                for (size_t i = 0; i < blases.size(); ++i)
+                {
+                    const vk::CopyAccelerationStructureInfoKHR copyInfo(blases[i].first,
+                            compactedBlases[i].first, vk::CopyAccelerationStructureModeKHR::eCompact);
+
+                    commandBuffer.copyAccelerationStructureKHR(copyInfo);
+                }
+            });
+
+        for (const AccelerationStructureEntry& blas : blases)
+        {
+            DestroyAccelerationStructure(blas);
+        }
+
+        return compactedBlases;
+    }
 }
 
 vk::AccelerationStructureKHR AccelerationStructureManager::GenerateUnitBBoxBlas()
@@ -146,28 +304,20 @@ vk::AccelerationStructureKHR AccelerationStructureManager::GenerateUnitBBoxBlas(
 
 vk::AccelerationStructureKHR AccelerationStructureManager::GenerateBlas(const BlasGeometryData& geometryData)
 {
-    constexpr vk::AccelerationStructureTypeKHR type = vk::AccelerationStructureTypeKHR::eBottomLevel;
-
     constexpr vk::BufferUsageFlags bufferUsage = vk::BufferUsageFlagBits::eShaderDeviceAddressEXT
             | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
 
     const vk::Buffer vertexBuffer = BufferHelpers::CreateBufferWithData(bufferUsage, ByteView(geometryData.vertices));
     const vk::Buffer indexBuffer = BufferHelpers::CreateBufferWithData(bufferUsage, ByteView(geometryData.indices));
 
-    const vk::AccelerationStructureGeometryTrianglesDataKHR trianglesData(
-            geometryData.vertexFormat, VulkanContext::device->GetAddress(vertexBuffer),
-            geometryData.vertexStride, geometryData.vertexCount - 1,
-            geometryData.indexType, VulkanContext::device->GetAddress(indexBuffer), nullptr);
+    const BlasGeometryBuffers geometryBuffers{
+        geometryData.indexType, geometryData.indexCount,
+        BufferSlice{ indexBuffer, 0, geometryData.indices.size },
+        geometryData.vertexFormat, geometryData.vertexStride, geometryData.vertexCount,
+        BufferSlice{ vertexBuffer, 0, geometryData.vertices.size }
+    };
 
-    const vk::AccelerationStructureGeometryKHR geometry(
-            vk::GeometryTypeKHR::eTriangles, trianglesData,
-            vk::GeometryFlagsKHR());
-
-    const uint32_t primitiveCount = geometryData.indexCount / 3;
-
-    const auto [blas, storageBuffer] = Details::GenerateAccelerationStructure(type, geometry, primitiveCount);
-
-    accelerationStructures.emplace(blas, storageBuffer);
+    const vk::AccelerationStructureKHR blas = GenerateBlases({ geometryBuffers }, false).front();
 
     VulkanContext::bufferManager->DestroyBuffer(vertexBuffer);
     VulkanContext::bufferManager->DestroyBuffer(indexBuffer);
@@ -175,6 +325,136 @@ vk::AccelerationStructureKHR AccelerationStructureManager::GenerateBlas(const Bl
     return blas;
 }
 
+std::vector<vk::AccelerationStructureKHR> AccelerationStructureManager::GenerateBlases(
+        const std::vector<BlasGeometryBuffers>& geometries, bool compact)
+{
+    EASY_FUNCTION()
+
+    constexpr vk::AccelerationStructureTypeKHR type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+
+    const vk::BuildAccelerationStructureFlagsKHR flags = Details::GetBlasBuildFlags(compact);
+
+    const vk::DeviceSize scratchAlignment = VulkanContext::device->GetRayTracingProperties().minScratchOffsetAlignment;
+
+    std::vector<Details::BlasBuildInput> buildInputs;
+    buildInputs.reserve(geometries.size());
+
+    for (const BlasGeometryBuffers& geometryBuffers : geometries)
+    {
+        buildInputs.push_back(Details::GetBlasBuildInput(geometryBuffers, flags));
+    }
+
+    const std::vector<Details::BlasBatch> batches = Details::SplitBlasesIntoBatches(buildInputs, scratchAlignment);
+
+    if (batches.empty())
+    {
+        return {};
+    }
+
+    const auto pred = [](const Details::BlasBatch& a, const Details::BlasBatch& b)
+        {
+            return a.scratchSize < b.scratchSize;
+        };
+
+    const vk::DeviceSize scratchSize = std::ranges::max_element(batches, pred)->scratchSize;
+
+    const vk::Buffer scratchBuffer = Details::CreateAccelerationStructureBuffer(
+            scratchSize, vk::BufferUsageFlagBits::eStorageBuffer);
+
+    const vk::DeviceAddress scratchAddress = VulkanContext::device->GetAddress(scratchBuffer);
+
+    std::vector<vk::AccelerationStructureKHR> blases;
+    blases.reserve(geometries.size());
+
+    for (size_t batchIndex = 0; batchIndex < batches.size(); ++batchIndex)
+    {
+        const Details::BlasBatch& batch = batches[batchIndex];
+
+        const float startSeconds = Timer::GetGlobalSeconds();
+
+        std::vector<Details::AccelerationStructureEntry> batchBlases;
+        std::vector<vk::AccelerationStructureKHR> batchBlasHandles;
+        std::vector<vk::AccelerationStructureBuildGeometryInfoKHR> buildInfos;
+        std::vector<const vk::AccelerationStructureBuildRangeInfoKHR*> rangeInfos;
+
+        vk::DeviceSize scratchOffset = 0;
+        vk::DeviceSize originalSize = 0;
+
+        for (size_t i = batch.begin; i < batch.end; ++i)
+        {
+            const Details::BlasBuildInput& buildInput = buildInputs[i];
+
+            const vk::DeviceSize blasSize = buildInput.buildSizesInfo.accelerationStructureSize;
+
+            batchBlases.push_back(Details::CreateAccelerationStructure(type, blasSize));
+            batchBlasHandles.push_back(batchBlases.back().first);
+
+            buildInfos.emplace_back(type, flags, vk::BuildAccelerationStructureModeKHR::eBuild,
+                    nullptr, batchBlases.back().first, 1, &buildInput.geometry, nullptr,
+                    scratchAddress + scratchOffset);
+
+            rangeInfos.push_back(&buildInput.rangeInfo);
+
+            scratchOffset += AlignUp(buildInput.buildSizesInfo.buildScratchSize, scratchAlignment);
+            originalSize += blasSize;
+        }
+
+        const uint32_t blasCount = static_cast<uint32_t>(batchBlases.size());
+
+        const vk::QueryPool queryPool = compact ? Details::CreateCompactedSizeQueryPool(blasCount) : nullptr;
+
+        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+            {
+                commandBuffer.buildAccelerationStructuresKHR(buildInfos, rangeInfos);
+
+                if (compact)
+                {
+                    const PipelineBarrier barrier{
+                        SyncScope::kAccelerationStructureWrite,
+                        SyncScope::kAccelerationStructureBuild
+                    };
+
+                    VulkanHelpers::InsertMemoryBarrier(commandBuffer, barrier);
+
+                    commandBuffer.resetQueryPool(queryPool, 0, blasCount);
+
+                    commandBuffer.writeAccelerationStructuresPropertiesKHR(batchBlasHandles,
+                            vk::QueryType::eAccelerationStructureCompactedSizeKHR, queryPool, 0);
+                }
+            });
+
+        vk::DeviceSize finalSize = originalSize;
+
+        if (compact)
+        {
+            const std::vector<vk::DeviceSize> compactedSizes = Details::ReadCompactedSizes(queryPool, blasCount);
+
+            batchBlases = Details::CompactBlases(batchBlases, compactedSizes);
+
+            finalSize = std::accumulate(compactedSizes.begin(), compactedSizes.end(), vk::DeviceSize(0));
+
+            VulkanContext::device->Get().destroyQueryPool(queryPool);
+        }
+
+        for (const auto& [blas, storageBuffer] : batchBlases)
+        {
+            accelerationStructures.emplace(blas, storageBuffer);
+
+            blases.push_back(blas);
+        }
+
+        const float buildMiliseconds = (Timer::GetGlobalSeconds() - startSeconds) / Numbers::kMili;
+
+        LogI << "BLAS batch " << batchIndex << ": " << blasCount << " BLASes built in " << buildMiliseconds
+                << " ms, memory " << originalSize / Numbers::kKilobyte << " KB -> "
+                << finalSize / Numbers::kKilobyte << " KB" << "\n";
+    }
+
+    VulkanContext::bufferManager->DestroyBuffer(scratchBuffer);
+
+    return blases;
+}
+
 vk::AccelerationStructureKHR AccelerationStructureManager::GenerateTlas(const std::vector<TlasInstanceData>& instances)
 {
     constexpr vk::AccelerationStructureTypeKHR type = vk::AccelerationStructureTypeKHR::eTopLevel;
@@ -206,8 +486,7 @@ void AccelerationStructureManager::DestroyAccelerationStructure(vk::Acceleration
     const auto it = accelerationStructures.find(accelerationStructure);
     Assert(it != accelerationStructures.end());
 
-    VulkanContext::device->Get().destroyAccelerationStructureKHR(accelerationStructure);
-    VulkanContext::bufferManager->DestroyBuffer(it->second);
+    Details::DestroyAccelerationStructure(*it);
 
     accelerationStructures.erase(it);
 }
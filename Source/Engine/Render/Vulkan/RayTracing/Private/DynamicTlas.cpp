@@ -0,0 +1,341 @@
+#include "Engine/Render/Vulkan/RayTracing/DynamicTlas.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+
+#include "Utils/Helpers.hpp"
+#include "Utils/Logger.hpp"
+#include "Utils/TimeHelpers.hpp"
+
+namespace Details
+{
+    static constexpr vk::BuildAccelerationStructureFlagsKHR kBuildFlags
+            = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace
+            | vk::BuildAccelerationStructureFlagBitsKHR::eAllowUpdate;
+
+    static constexpr uint32_t kTimestampsPerSlot = 2;
+
+    static vk::TransformMatrixKHR GetInstanceTransformMatrix(const glm::mat4& transform)
+    {
+        const glm::mat4 transposedTransform = glm::transpose(transform);
+
+        std::array<std::array<float, 4>, 3> transposedData;
+
+        std::memcpy(&transposedData, &transposedTransform, sizeof(vk::TransformMatrixKHR));
+
+        return vk::TransformMatrixKHR(transposedData);
+    }
+
+    static vk::AccelerationStructureGeometryKHR GetGeometry(vk::Buffer instanceBuffer)
+    {
+        const vk::AccelerationStructureGeometryInstancesDataKHR instancesData(
+                false, VulkanContext::device->GetAddress(instanceBuffer));
+
+        const vk::AccelerationStructureGeometryDataKHR geometryData(instancesData);
+
+        return vk::AccelerationStructureGeometryKHR(
+                vk::GeometryTypeKHR::eInstances, geometryData,
+                vk::GeometryFlagBitsKHR::eOpaque);
+    }
+
+    static vk::Buffer CreateInstanceBuffer(uint32_t instanceCount)
+    {
+        const Queues::Description& queuesDescription = VulkanContext::device->GetQueuesDescription();
+
+        const vk::DeviceSize size = std::max(instanceCount, 1u) * sizeof(vk::AccelerationStructureInstanceKHR);
+
+        const vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eShaderDeviceAddress
+                | vk::BufferUsageFlagBits::eAccelerationStructureBuildInputReadOnlyKHR;
+
+        const vk::BufferCreateInfo createInfo({}, size, usage,
+                vk::SharingMode::eExclusive, 0, &queuesDescription.graphicsFamilyIndex);
+
+        const vk::MemoryPropertyFlags memoryProperties
+                = vk::MemoryPropertyFlagBits::eHostVisible
+                | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+        return VulkanContext::memoryManager->CreatePersistentlyMappedBuffer(createInfo, memoryProperties);
+    }
+
+    static vk::Buffer CreateDeviceBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage,
+            BufferCreateFlags createFlags)
+    {
+        const BufferDescription bufferDescription{
+            size, usage | vk::BufferUsageFlagBits::eShaderDeviceAddress,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        };
+
+        return VulkanContext::bufferManager->CreateBuffer(bufferDescription, createFlags);
+    }
+
+    static vk::QueryPool CreateTimestampQueryPool(uint32_t queryCount)
+    {
+        const vk::QueryPoolCreateInfo createInfo({}, vk::QueryType::eTimestamp, queryCount);
+
+        const auto [result, queryPool] = VulkanContext::device->Get().createQueryPool(createInfo);
+        Assert(result == vk::Result::eSuccess);
+
+        return queryPool;
+    }
+}
+
+DynamicTlas::DynamicTlas(const std::vector<TlasInstanceData>& instances_)
+{
+    EASY_FUNCTION()
+
+    instances.reserve(instances_.size());
+
+    for (const auto& instance : instances_)
+    {
+        instances.emplace_back(Details::GetInstanceTransformMatrix(instance.transform),
+                instance.customIndex, instance.mask, instance.sbtRecordOffset, instance.flags,
+                VulkanContext::device->GetAddress(instance.blas));
+    }
+
+    const uint32_t instanceCount = static_cast<uint32_t>(instances.size());
+
+    slots.resize(VulkanConfig::kMaxFramesInFlight);
+
+    for (Slot& slot : slots)
+    {
+        slot.instanceBuffer = Details::CreateInstanceBuffer(instanceCount);
+        slot.instanceMemory = VulkanContext::memoryManager->GetPersistentMapping(slot.instanceBuffer);
+
+        ByteView(instances).CopyTo(slot.instanceMemory);
+    }
+
+    changedSinceRebuildFlags.resize(instances.size(), false);
+
+    const vk::AccelerationStructureGeometryKHR geometry = Details::GetGeometry(slots.front().instanceBuffer);
+
+    const vk::AccelerationStructureBuildGeometryInfoKHR buildInfo(
+            vk::AccelerationStructureTypeKHR::eTopLevel, Details::kBuildFlags,
+            vk::BuildAccelerationStructureModeKHR::eBuild,
+            nullptr, nullptr, 1, &geometry);
+
+    const vk::AccelerationStructureBuildSizesInfoKHR buildSizesInfo
+            = VulkanContext::device->Get().getAccelerationStructureBuildSizesKHR(
+                    vk::AccelerationStructureBuildTypeKHR::eDevice, buildInfo, { instanceCount });
+
+    storageBuffer = Details::CreateDeviceBuffer(buildSizesInfo.accelerationStructureSize,
+            vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR, BufferCreateFlags());
+
+    scratchBuffer = Details::CreateDeviceBuffer(
+            std::max(buildSizesInfo.buildScratchSize, buildSizesInfo.updateScratchSize),
+            vk::BufferUsageFlagBits::eStorageBuffer, BufferCreateFlagBits::eScratchBuffer);
+
+    const vk::AccelerationStructureCreateInfoKHR createInfo({}, storageBuffer, 0,
+            buildSizesInfo.accelerationStructureSize, vk::AccelerationStructureTypeKHR::eTopLevel);
+
+    vk::Result result;
+    std::tie(result, tlas) = VulkanContext::device->Get().createAccelerationStructureKHR(createInfo);
+    Assert(result == vk::Result::eSuccess);
+
+    const uint32_t queryCount = static_cast<uint32_t>(slots.size()) * Details::kTimestampsPerSlot;
+
+    queryPool = Details::CreateTimestampQueryPool(queryCount);
+
+    const float buildStartSeconds = Timer::GetGlobalSeconds();
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            commandBuffer.resetQueryPool(queryPool, 0, queryCount);
+
+            RecordBuild(commandBuffer, slots.front().instanceBuffer, vk::BuildAccelerationStructureModeKHR::eBuild);
+        });
+
+    const float buildSeconds = Timer::GetGlobalSeconds() - buildStartSeconds;
+
+    LogI << "TLAS built: " << instanceCount << " instances, "
+            << static_cast<float>(buildSizesInfo.accelerationStructureSize) / static_cast<float>(Numbers::kMegabyte)
+            << " MB in " << buildSeconds / Numbers::kMili << " ms including submission\n";
+}
+
+DynamicTlas::~DynamicTlas()
+{
+    VulkanContext::device->Get().destroyQueryPool(queryPool);
+
+    VulkanContext::device->Get().destroyAccelerationStructureKHR(tlas);
+
+    VulkanContext::bufferManager->DestroyBuffer(storageBuffer);
+    VulkanContext::bufferManager->DestroyBuffer(scratchBuffer);
+
+    for (const Slot& slot : slots)
+    {
+        VulkanContext::memoryManager->DestroyBuffer(slot.instanceBuffer);
+    }
+}
+
+void DynamicTlas::SetInstanceTransform(uint32_t instanceIndex, const glm::mat4& transform)
+{
+    Assert(instanceIndex < instances.size());
+
+    const vk::TransformMatrixKHR transformMatrix = Details::GetInstanceTransformMatrix(transform);
+
+    vk::AccelerationStructureInstanceKHR& instance = instances[instanceIndex];
+
+    if (instance.transform == transformMatrix)
+    {
+        return;
+    }
+
+    instance.transform = transformMatrix;
+
+    for (Slot& slot : slots)
+    {
+        slot.pendingInstances.push_back(instanceIndex);
+    }
+
+    if (!changedSinceRebuildFlags[instanceIndex])
+    {
+        changedSinceRebuildFlags[instanceIndex] = true;
+
+        ++changedSinceRebuild;
+    }
+
+    dirty = true;
+}
+
+void DynamicTlas::Update(vk::CommandBuffer commandBuffer)
+{
+    EASY_FUNCTION()
+
+    if (!dirty)
+    {
+        return;
+    }
+
+    slotIndex = (slotIndex + 1) % static_cast<uint32_t>(slots.size());
+
+    Slot& slot = slots[slotIndex];
+
+    // The slot was used frames in flight ago, so both its instances and timestamps are no longer in use
+    ReadTimestamps(slotIndex);
+
+    for (const uint32_t instanceIndex : slot.pendingInstances)
+    {
+        const ByteView instanceData(instances[instanceIndex]);
+
+        std::memcpy(slot.instanceMemory.data + instanceIndex * sizeof(vk::AccelerationStructureInstanceKHR),
+                instanceData.data, instanceData.size);
+    }
+
+    slot.pendingInstances.clear();
+
+    const vk::BuildAccelerationStructureModeKHR mode = SelectBuildMode();
+
+    if (mode == vk::BuildAccelerationStructureModeKHR::eBuild)
+    {
+        std::ranges::fill(changedSinceRebuildFlags, false);
+
+        changedSinceRebuild = 0;
+        refitsSinceRebuild = 0;
+
+        ++stats.rebuildCount;
+    }
+    else
+    {
+        ++refitsSinceRebuild;
+
+        ++stats.refitCount;
+    }
+
+    const uint32_t firstQuery = slotIndex * Details::kTimestampsPerSlot;
+
+    commandBuffer.resetQueryPool(queryPool, firstQuery, Details::kTimestampsPerSlot);
+
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, queryPool, firstQuery);
+
+    RecordBuild(commandBuffer, slot.instanceBuffer, mode);
+
+    commandBuffer.writeTimestamp(vk::PipelineStageFlagBits::eAccelerationStructureBuildKHR,
+            queryPool, firstQuery + 1);
+
+    slot.measuredMode = mode;
+
+    // Other slots receive pending instances when they are used for the next build
+    dirty = false;
+}
+
+vk::BuildAccelerationStructureModeKHR DynamicTlas::SelectBuildMode() const
+{
+    const float changedRatio = static_cast<float>(changedSinceRebuild) / static_cast<float>(instances.size());
+
+    if (refitsSinceRebuild >= VulkanConfig::kTlasMaxRefitCount
+            || changedRatio >= VulkanConfig::kTlasRebuildInstanceRatio)
+    {
+        return vk::BuildAccelerationStructureModeKHR::eBuild;
+    }
+
+    return vk::BuildAccelerationStructureModeKHR::eUpdate;
+}
+
+void DynamicTlas::RecordBuild(vk::CommandBuffer commandBuffer, vk::Buffer instanceBuffer,
+        vk::BuildAccelerationStructureModeKHR mode) const
+{
+    const PipelineBarrier previousUsageBarrier{
+        SyncScope::kAccelerationStructureShaderRead | SyncScope::kAccelerationStructureWrite,
+        SyncScope::kAccelerationStructureWrite
+    };
+
+    VulkanHelpers::InsertMemoryBarrier(commandBuffer, previousUsageBarrier);
+
+    const vk::AccelerationStructureGeometryKHR geometry = Details::GetGeometry(instanceBuffer);
+
+    const vk::AccelerationStructureKHR srcTlas = mode == vk::BuildAccelerationStructureModeKHR::eUpdate
+            ? tlas : vk::AccelerationStructureKHR();
+
+    const vk::AccelerationStructureBuildGeometryInfoKHR buildInfo(
+            vk::AccelerationStructureTypeKHR::eTopLevel, Details::kBuildFlags, mode,
+            srcTlas, tlas, 1, &geometry, nullptr,
+            VulkanContext::device->GetAddress(scratchBuffer));
+
+    const vk::AccelerationStructureBuildRangeInfoKHR rangeInfo(static_cast<uint32_t>(instances.size()), 0, 0, 0);
+    const vk::AccelerationStructureBuildRangeInfoKHR* pRangeInfo = &rangeInfo;
+
+    commandBuffer.buildAccelerationStructuresKHR({ buildInfo }, { pRangeInfo });
+
+    const PipelineBarrier buildBarrier{
+        SyncScope::kAccelerationStructureWrite,
+        SyncScope::kAccelerationStructureShaderRead
+    };
+
+    VulkanHelpers::InsertMemoryBarrier(commandBuffer, buildBarrier);
+}
+
+void DynamicTlas::ReadTimestamps(uint32_t index)
+{
+    Slot& slot = slots[index];
+
+    if (!slot.measuredMode.has_value())
+    {
+        return;
+    }
+
+    const uint32_t firstQuery = index * Details::kTimestampsPerSlot;
+
+    std::array<uint64_t, Details::kTimestampsPerSlot> timestamps{};
+
+    const vk::Result result = VulkanContext::device->Get().getQueryPoolResults(queryPool,
+            firstQuery, Details::kTimestampsPerSlot, sizeof(timestamps), timestamps.data(), sizeof(uint64_t),
+            vk::QueryResultFlagBits::e64);
+
+    if (result == vk::Result::eSuccess)
+    {
+        const float timestampPeriod = VulkanContext::device->GetLimits().timestampPeriod;
+
+        const float miliseconds = static_cast<float>(timestamps[1] - timestamps[0])
+                * timestampPeriod * Numbers::kNano / Numbers::kMili;
+
+        if (slot.measuredMode == vk::BuildAccelerationStructureModeKHR::eBuild)
+        {
+            stats.rebuildMiliseconds = miliseconds;
+        }
+        else
+        {
+            stats.refitMiliseconds = miliseconds;
+        }
+    }
+
+    slot.measuredMode.reset();
+}
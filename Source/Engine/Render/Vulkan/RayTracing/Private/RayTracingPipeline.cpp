@@ -130,7 +130,7 @@ std::unique_ptr<RayTracingPipeline> RayTracingPipeline::Create(const Description
             8, nullptr, nullptr, nullptr, layout);
 
     const auto [result, pipeline] = device.createRayTracingPipelineKHR(
-            vk::DeferredOperationKHR(), vk::PipelineCache(), createInfo);
+            vk::DeferredOperationKHR(), VulkanContext::pipelineCache->Get(), createInfo);
 
     Assert(result == vk::Result::eSuccess);
 
@@ -12,6 +12,14 @@ struct BufferDescription
     vk::MemoryPropertyFlags memoryProperties;
 };
 
+// Range of a larger buffer, owned by BufferPool
+struct BufferSlice
+{
+    vk::Buffer buffer;
+    vk::DeviceSize offset = 0;
+    vk::DeviceSize size = 0;
+};
+
 enum class BufferCreateFlagBits
 {
     eStagingBuffer,
@@ -41,4 +49,6 @@ namespace BufferHelpers
     vk::Buffer CreateBufferWithData(vk::BufferUsageFlags usage, const ByteView& data);
 
     vk::Buffer CreateEmptyBuffer(vk::BufferUsageFlags usage, size_t size);
+
+    BufferSlice CreateSliceWithData(const ByteView& data);
 }
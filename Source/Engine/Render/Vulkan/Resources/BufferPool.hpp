@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
+
+// Suballocates device local buffer slices from large arenas which share the same usage.
+// Every arena keeps free ranges ordered by offset for coalescing and by size for best fit search.
+// Arenas are released as soon as their last slice is freed.
+class BufferPool
+{
+public:
+    struct Stats
+    {
+        uint32_t arenaCount = 0;
+        uint32_t allocationCount = 0;
+        vk::DeviceSize reservedSize = 0;
+        vk::DeviceSize usedSize = 0;
+        float fragmentation = 0.0f;
+    };
+
+    explicit BufferPool(vk::BufferUsageFlags usage_);
+    ~BufferPool();
+
+    BufferSlice Allocate(vk::DeviceSize size);
+
+    void Free(const BufferSlice& slice);
+
+    Stats GetStats() const;
+
+private:
+    struct Arena
+    {
+        vk::Buffer buffer;
+        vk::DeviceSize size = 0;
+        uint32_t allocationCount = 0;
+
+        std::map<vk::DeviceSize, vk::DeviceSize> freeRangesByOffset;
+        std::multimap<vk::DeviceSize, vk::DeviceSize> freeRangesBySize;
+
+        void AddFreeRange(vk::DeviceSize offset, vk::DeviceSize rangeSize);
+        void RemoveFreeRange(vk::DeviceSize offset, vk::DeviceSize rangeSize);
+    };
+
+    vk::BufferUsageFlags usage;
+    vk::DeviceSize alignment = 0;
+
+    std::list<Arena> arenas;
+
+    Arena& CreateArena(vk::DeviceSize minSize);
+};
@@ -121,6 +121,12 @@ namespace ImageHelpers
 
     vk::DeviceSize CalculateMipLevelSize(const ImageDescription& description, uint32_t mipLevel);
 
+    // Mip levels are tightly packed one after another, each of them contains all layers
+    vk::DeviceSize CalculateImageSize(const ImageDescription& description);
+
+    std::vector<vk::BufferImageCopy> GetImageCopyRegions(const ImageDescription& description,
+            vk::DeviceSize bufferOffset);
+
     Texture CreateRenderTarget(vk::Format format, const vk::Extent2D& extent,
             vk::SampleCountFlagBits sampleCount, vk::ImageUsageFlags usage);
 
@@ -133,4 +139,9 @@ namespace ImageHelpers
 
     void ReplaceMipLevels(vk::CommandBuffer commandBuffer, vk::Image image,
             const vk::ImageSubresourceRange& subresourceRange);
+
+    Bytes ReadImage(vk::Image image, vk::ImageLayout layout);
+
+    // Reads all images with a single submit, their data is tightly packed in the given order
+    Bytes ReadImages(const std::vector<vk::Image>& images, vk::ImageLayout layout);
 }
@@ -23,6 +23,10 @@ public:
     vk::Buffer CreateBuffer(const vk::BufferCreateInfo& createInfo, vk::MemoryPropertyFlags memoryProperties,
             vk::DeviceSize minMemoryAlignment);
 
+    // Host visible buffers stay mapped until destruction, this one also gets dedicated memory
+    vk::Buffer CreatePersistentlyMappedBuffer(const vk::BufferCreateInfo& createInfo,
+            vk::MemoryPropertyFlags memoryProperties);
+
     void DestroyBuffer(vk::Buffer buffer);
 
     vk::Image CreateImage(const vk::ImageCreateInfo& createInfo, vk::MemoryPropertyFlags memoryProperties);
@@ -35,10 +39,13 @@ public:
 
     MemoryBlock GetAccelerationStructureMemoryBlock(vk::AccelerationStructureKHR accelerationStructure) const;
 
+    // Only for memory allocated with AllocateMemory, host visible buffers are persistently mapped
     ByteAccess MapMemory(const MemoryBlock& memoryBlock) const;
 
     void UnmapMemory(const MemoryBlock& memoryBlock) const;
 
+    ByteAccess GetPersistentMapping(vk::Buffer buffer) const;
+
 private:
     VmaAllocator allocator = nullptr;
 
@@ -84,12 +84,9 @@ vk::Buffer BufferHelpers::CreateBufferWithData(vk::BufferUsageFlags usage, const
     };
 
     const vk::Buffer buffer = VulkanContext::bufferManager->CreateBuffer(
-            bufferDescription, BufferCreateFlagBits::eStagingBuffer);
+            bufferDescription, BufferCreateFlags::kNone);
 
-    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
-        {
-            VulkanContext::bufferManager->UpdateBuffer(commandBuffer, buffer, data);
-        });
+    VulkanContext::uploadManager->UploadBuffer(buffer, data);
 
     return buffer;
 }
@@ -107,3 +104,12 @@ vk::Buffer BufferHelpers::CreateEmptyBuffer(vk::BufferUsageFlags usage, size_t s
 
     return buffer;
 }
+
+BufferSlice BufferHelpers::CreateSliceWithData(const ByteView& data)
+{
+    const BufferSlice slice = VulkanContext::bufferPool->Allocate(data.size);
+
+    VulkanContext::uploadManager->UploadBuffer(slice.buffer, slice.offset, data);
+
+    return slice;
+}
@@ -67,13 +67,12 @@ void BufferManager::UpdateBuffer(vk::CommandBuffer commandBuffer,
 
     if (memoryProperties & vk::MemoryPropertyFlagBits::eHostVisible)
     {
-        const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(buffer);
-
-        data.CopyTo(VulkanContext::memoryManager->MapMemory(memoryBlock));
-        VulkanContext::memoryManager->UnmapMemory(memoryBlock);
+        data.CopyTo(VulkanContext::memoryManager->GetPersistentMapping(buffer));
 
         if (!(memoryProperties & vk::MemoryPropertyFlagBits::eHostCoherent))
         {
+            const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(buffer);
+
             const vk::MappedMemoryRange memoryRange(
                     memoryBlock.memory, memoryBlock.offset, memoryBlock.size);
 
@@ -86,10 +85,7 @@ void BufferManager::UpdateBuffer(vk::CommandBuffer commandBuffer,
         Assert(commandBuffer && stagingBuffer);
         Assert(description.usage & vk::BufferUsageFlagBits::eTransferDst);
 
-        const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(stagingBuffer);
-
-        data.CopyTo(VulkanContext::memoryManager->MapMemory(memoryBlock));
-        VulkanContext::memoryManager->UnmapMemory(memoryBlock);
+        data.CopyTo(VulkanContext::memoryManager->GetPersistentMapping(stagingBuffer));
 
         const vk::BufferCopy region(0, 0, data.size);
 
@@ -106,13 +102,12 @@ void BufferManager::UpdateBuffer(vk::CommandBuffer commandBuffer,
 
     if (memoryProperties & vk::MemoryPropertyFlagBits::eHostVisible)
     {
-        const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(buffer);
-
-        updater(VulkanContext::memoryManager->MapMemory(memoryBlock));
-        VulkanContext::memoryManager->UnmapMemory(memoryBlock);
+        updater(VulkanContext::memoryManager->GetPersistentMapping(buffer));
 
         if (!(memoryProperties & vk::MemoryPropertyFlagBits::eHostCoherent))
         {
+            const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(buffer);
+
             const vk::MappedMemoryRange memoryRange(
                     memoryBlock.memory, memoryBlock.offset, memoryBlock.size);
 
@@ -125,10 +120,7 @@ void BufferManager::UpdateBuffer(vk::CommandBuffer commandBuffer,
         Assert(commandBuffer && stagingBuffer);
         Assert(description.usage & vk::BufferUsageFlagBits::eTransferDst);
 
-        const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(stagingBuffer);
-
-        updater(VulkanContext::memoryManager->MapMemory(memoryBlock));
-        VulkanContext::memoryManager->UnmapMemory(memoryBlock);
+        updater(VulkanContext::memoryManager->GetPersistentMapping(stagingBuffer));
 
         const vk::BufferCopy region(0, 0, description.size);
 
@@ -145,11 +137,7 @@ void BufferManager::ReadBuffer(vk::CommandBuffer commandBuffer,
 
     if (memoryProperties & vk::MemoryPropertyFlagBits::eHostVisible)
     {
-        const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(buffer);
-
-        reader(VulkanContext::memoryManager->MapMemory(memoryBlock));
-
-        VulkanContext::memoryManager->UnmapMemory(memoryBlock);
+        reader(VulkanContext::memoryManager->GetPersistentMapping(buffer));
     }
     else
     {
@@ -160,11 +148,7 @@ void BufferManager::ReadBuffer(vk::CommandBuffer commandBuffer,
 
         commandBuffer.copyBuffer(buffer, stagingBuffer, { region });
 
-        const MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(stagingBuffer);
-
-        reader(VulkanContext::memoryManager->MapMemory(memoryBlock));
-
-        VulkanContext::memoryManager->UnmapMemory(memoryBlock);
+        reader(VulkanContext::memoryManager->GetPersistentMapping(stagingBuffer));
     }
 }
 
@@ -0,0 +1,190 @@
+#include "Engine/Render/Vulkan/Resources/BufferPool.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+
+#include "Utils/Helpers.hpp"
+
+namespace Details
+{
+    static constexpr vk::DeviceSize kMinSliceAlignment = 16;
+
+    static vk::DeviceSize GetSliceAlignment()
+    {
+        const vk::PhysicalDeviceLimits& limits = VulkanContext::device->GetLimits();
+
+        return std::max(kMinSliceAlignment, limits.minStorageBufferOffsetAlignment);
+    }
+}
+
+void BufferPool::Arena::AddFreeRange(vk::DeviceSize offset, vk::DeviceSize rangeSize)
+{
+    freeRangesByOffset.emplace(offset, rangeSize);
+    freeRangesBySize.emplace(rangeSize, offset);
+}
+
+void BufferPool::Arena::RemoveFreeRange(vk::DeviceSize offset, vk::DeviceSize rangeSize)
+{
+    freeRangesByOffset.erase(offset);
+
+    const auto [begin, end] = freeRangesBySize.equal_range(rangeSize);
+
+    const auto it = std::find_if(begin, end, [&](const auto& range) { return range.second == offset; });
+    Assert(it != end);
+
+    freeRangesBySize.erase(it);
+}
+
+BufferPool::BufferPool(vk::BufferUsageFlags usage_)
+    : usage(usage_)
+{
+    alignment = Details::GetSliceAlignment();
+}
+
+BufferPool::~BufferPool()
+{
+    for (const Arena& arena : arenas)
+    {
+        VulkanContext::bufferManager->DestroyBuffer(arena.buffer);
+    }
+}
+
+BufferSlice BufferPool::Allocate(vk::DeviceSize size)
+{
+    const vk::DeviceSize alignedSize = AlignUp(std::max(size, vk::DeviceSize(1)), alignment);
+
+    Arena* targetArena = nullptr;
+
+    for (Arena& arena : arenas)
+    {
+        if (arena.freeRangesBySize.lower_bound(alignedSize) != arena.freeRangesBySize.end())
+        {
+            targetArena = &arena;
+            break;
+        }
+    }
+
+    if (!targetArena)
+    {
+        targetArena = &CreateArena(alignedSize);
+    }
+
+    const auto it = targetArena->freeRangesBySize.lower_bound(alignedSize);
+
+    const auto [rangeSize, offset] = *it;
+
+    targetArena->RemoveFreeRange(offset, rangeSize);
+
+    if (rangeSize > alignedSize)
+    {
+        targetArena->AddFreeRange(offset + alignedSize, rangeSize - alignedSize);
+    }
+
+    ++targetArena->allocationCount;
+
+    return BufferSlice{ targetArena->buffer, offset, size };
+}
+
+void BufferPool::Free(const BufferSlice& slice)
+{
+    const auto arenaIt = std::ranges::find_if(arenas,
+            [&](const Arena& arena) { return arena.buffer == slice.buffer; });
+
+    Assert(arenaIt != arenas.end());
+
+    Arena& arena = *arenaIt;
+
+    vk::DeviceSize offset = slice.offset;
+    vk::DeviceSize rangeSize = AlignUp(std::max(slice.size, vk::DeviceSize(1)), alignment);
+
+    const auto nextIt = arena.freeRangesByOffset.find(offset + rangeSize);
+
+    if (nextIt != arena.freeRangesByOffset.end())
+    {
+        const vk::DeviceSize nextSize = nextIt->second;
+
+        arena.RemoveFreeRange(offset + rangeSize, nextSize);
+
+        rangeSize += nextSize;
+    }
+
+    const auto prevIt = arena.freeRangesByOffset.lower_bound(offset);
+
+    if (prevIt != arena.freeRangesByOffset.begin())
+    {
+        const auto [prevOffset, prevSize] = *std::prev(prevIt);
+
+        if (prevOffset + prevSize == offset)
+        {
+            arena.RemoveFreeRange(prevOffset, prevSize);
+
+            offset = prevOffset;
+            rangeSize += prevSize;
+        }
+    }
+
+    arena.AddFreeRange(offset, rangeSize);
+
+    Assert(arena.allocationCount > 0);
+
+    if (--arena.allocationCount == 0)
+    {
+        VulkanContext::bufferManager->DestroyBuffer(arena.buffer);
+
+        arenas.erase(arenaIt);
+    }
+}
+
+BufferPool::Stats BufferPool::GetStats() const
+{
+    Stats stats;
+
+    vk::DeviceSize freeSize = 0;
+    vk::DeviceSize largestFreeSize = 0;
+
+    for (const Arena& arena : arenas)
+    {
+        ++stats.arenaCount;
+
+        stats.allocationCount += arena.allocationCount;
+        stats.reservedSize += arena.size;
+
+        for (const auto& range : arena.freeRangesByOffset)
+        {
+            freeSize += range.second;
+        }
+
+        if (!arena.freeRangesBySize.empty())
+        {
+            largestFreeSize = std::max(largestFreeSize, arena.freeRangesBySize.rbegin()->first);
+        }
+    }
+
+    stats.usedSize = stats.reservedSize - freeSize;
+
+    if (freeSize > 0)
+    {
+        stats.fragmentation = 1.0f - static_cast<float>(largestFreeSize) / static_cast<float>(freeSize);
+    }
+
+    return stats;
+}
+
+BufferPool::Arena& BufferPool::CreateArena(vk::DeviceSize minSize)
+{
+    Arena& arena = arenas.emplace_back();
+
+    arena.size = std::max(VulkanConfig::kBufferPoolArenaSize, minSize);
+
+    const BufferDescription description{
+        arena.size,
+        usage | vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    arena.buffer = VulkanContext::bufferManager->CreateBuffer(description, BufferCreateFlags::kNone);
+
+    arena.AddFreeRange(0, arena.size);
+
+    return arena;
+}
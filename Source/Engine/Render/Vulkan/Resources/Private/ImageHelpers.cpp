@@ -1,6 +1,7 @@
 #include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
 
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
 
 #include "Utils/Assert.hpp"
 
@@ -331,6 +332,41 @@ vk::DeviceSize ImageHelpers::CalculateMipLevelSize(const ImageDescription& descr
     return CalculateMipLevelTexelCount(description, mipLevel) * GetTexelSize(description.format);
 }
 
+vk::DeviceSize ImageHelpers::CalculateImageSize(const ImageDescription& description)
+{
+    vk::DeviceSize size = 0;
+
+    for (uint32_t mipLevel = 0; mipLevel < description.mipLevelCount; ++mipLevel)
+    {
+        size += CalculateMipLevelSize(description, mipLevel);
+    }
+
+    return size;
+}
+
+std::vector<vk::BufferImageCopy> ImageHelpers::GetImageCopyRegions(const ImageDescription& description,
+        vk::DeviceSize bufferOffset)
+{
+    const vk::ImageSubresourceRange fullImage(GetImageAspect(description.format),
+            0, description.mipLevelCount, 0, description.layerCount);
+
+    std::vector<vk::BufferImageCopy> regions;
+    regions.reserve(description.mipLevelCount);
+
+    for (uint32_t mipLevel = 0; mipLevel < description.mipLevelCount; ++mipLevel)
+    {
+        const vk::BufferImageCopy region(bufferOffset, 0, 0,
+                GetSubresourceLayers(fullImage, mipLevel), vk::Offset3D(0, 0, 0),
+                CalculateMipLevelExtent(description.extent, mipLevel));
+
+        regions.push_back(region);
+
+        bufferOffset += CalculateMipLevelSize(description, mipLevel);
+    }
+
+    return regions;
+}
+
 Texture ImageHelpers::CreateRenderTarget(vk::Format format, const vk::Extent2D& extent,
         vk::SampleCountFlagBits sampleCount, vk::ImageUsageFlags usage)
 {
@@ -467,3 +503,97 @@ void ImageHelpers::ReplaceMipLevels(vk::CommandBuffer commandBuffer, vk::Image i
 
     imageManager.UpdateImage(commandBuffer, image, imageUpdates);
 }
+
+Bytes ImageHelpers::ReadImage(vk::Image image, vk::ImageLayout layout)
+{
+    return ReadImages({ image }, layout);
+}
+
+Bytes ImageHelpers::ReadImages(const std::vector<vk::Image>& images, vk::ImageLayout layout)
+{
+    EASY_FUNCTION()
+
+    std::vector<vk::DeviceSize> offsets;
+    offsets.reserve(images.size());
+
+    vk::DeviceSize size = 0;
+
+    for (const vk::Image image : images)
+    {
+        const ImageDescription& description = VulkanContext::imageManager->GetImageDescription(image);
+
+        Assert(description.usage & vk::ImageUsageFlagBits::eTransferSrc);
+
+        offsets.push_back(size);
+
+        size += CalculateImageSize(description);
+    }
+
+    const BufferDescription bufferDescription{
+        size, vk::BufferUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+    };
+
+    const vk::Buffer readbackBuffer = VulkanContext::bufferManager->CreateBuffer(
+            bufferDescription, BufferCreateFlags::kNone);
+
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
+            for (size_t i = 0; i < images.size(); ++i)
+            {
+                const ImageDescription& description = VulkanContext::imageManager->GetImageDescription(images[i]);
+
+                const vk::ImageSubresourceRange fullImage(GetImageAspect(description.format),
+                        0, description.mipLevelCount, 0, description.layerCount);
+
+                {
+                    const ImageLayoutTransition layoutTransition{
+                        layout,
+                        vk::ImageLayout::eTransferSrcOptimal,
+                        PipelineBarrier{
+                            SyncScope{ vk::PipelineStageFlagBits::eAllCommands, vk::AccessFlagBits::eMemoryWrite },
+                            SyncScope::kTransferRead
+                        }
+                    };
+
+                    TransitImageLayout(commandBuffer, images[i], fullImage, layoutTransition);
+                }
+
+                commandBuffer.copyImageToBuffer(images[i], vk::ImageLayout::eTransferSrcOptimal,
+                        readbackBuffer, GetImageCopyRegions(description, offsets[i]));
+
+                {
+                    const ImageLayoutTransition layoutTransition{
+                        vk::ImageLayout::eTransferSrcOptimal,
+                        layout,
+                        PipelineBarrier{
+                            SyncScope::kTransferRead,
+                            SyncScope::kBlockNone
+                        }
+                    };
+
+                    TransitImageLayout(commandBuffer, images[i], fullImage, layoutTransition);
+                }
+            }
+
+            {
+                const PipelineBarrier barrier{
+                    SyncScope::kTransferWrite,
+                    SyncScope{ vk::PipelineStageFlagBits::eHost, vk::AccessFlagBits::eHostRead }
+                };
+
+                BufferHelpers::InsertPipelineBarrier(commandBuffer, readbackBuffer, barrier);
+            }
+        });
+
+    Bytes data(size);
+
+    VulkanContext::bufferManager->ReadBuffer(nullptr, readbackBuffer, [&](const ByteView& bufferData)
+        {
+            std::memcpy(data.data(), bufferData.data, data.size());
+        });
+
+    VulkanContext::bufferManager->DestroyBuffer(readbackBuffer);
+
+    return data;
+}
@@ -164,10 +164,10 @@ void ImageManager::UpdateImage(vk::CommandBuffer commandBuffer, vk::Image image,
         std::vector<vk::BufferImageCopy> copyRegions;
         copyRegions.reserve(imageUpdates.size());
 
-        MemoryBlock memoryBlock = VulkanContext::memoryManager->GetBufferMemoryBlock(stagingBuffer);
+        const ByteAccess stagingMemory = VulkanContext::memoryManager->GetPersistentMapping(stagingBuffer);
 
         vk::DeviceSize stagingBufferOffset = 0;
-        const vk::DeviceSize stagingBufferSize = memoryBlock.size;
+        const vk::DeviceSize stagingBufferSize = stagingMemory.size;
 
         for (const auto& imageUpdate : imageUpdates)
         {
@@ -179,15 +179,11 @@ void ImageManager::UpdateImage(vk::CommandBuffer commandBuffer, vk::Image image,
             Assert(data.size == expectedSize);
             Assert(stagingBufferOffset + data.size <= stagingBufferSize);
 
-            memoryBlock.size = data.size;
-
-            data.CopyTo(VulkanContext::memoryManager->MapMemory(memoryBlock));
-            VulkanContext::memoryManager->UnmapMemory(memoryBlock);
+            data.CopyTo(ByteAccess(stagingMemory.data + stagingBufferOffset, data.size));
 
             copyRegions.emplace_back(stagingBufferOffset, 0, 0,
                     imageUpdate.layers, imageUpdate.offset, imageUpdate.extent);
 
-            memoryBlock.offset += data.size;
             stagingBufferOffset += data.size;
         }
 
@@ -13,6 +13,19 @@ namespace Details
 
         return allocationCreateInfo;
     }
+
+    // Host visible buffers are mapped once on creation, updates and readbacks access the mapping directly
+    static VmaAllocationCreateInfo GetBufferAllocationCreateInfo(vk::MemoryPropertyFlags memoryProperties)
+    {
+        VmaAllocationCreateInfo allocationCreateInfo = GetAllocationCreateInfo(memoryProperties);
+
+        if (memoryProperties & vk::MemoryPropertyFlagBits::eHostVisible)
+        {
+            allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        }
+
+        return allocationCreateInfo;
+    }
 }
 
 MemoryManager::MemoryManager()
@@ -65,7 +78,7 @@ void MemoryManager::FreeMemory(const MemoryBlock& memoryBlock)
 
 vk::Buffer MemoryManager::CreateBuffer(const vk::BufferCreateInfo& createInfo, vk::MemoryPropertyFlags memoryProperties)
 {
-    const VmaAllocationCreateInfo allocationCreateInfo = Details::GetAllocationCreateInfo(memoryProperties);
+    const VmaAllocationCreateInfo allocationCreateInfo = Details::GetBufferAllocationCreateInfo(memoryProperties);
 
     VkBuffer buffer;
     VmaAllocation allocation;
@@ -89,7 +102,7 @@ vk::Buffer MemoryManager::CreateBuffer(const vk::BufferCreateInfo& createInfo, v
     vk::MemoryRequirements memoryRequirements = VulkanContext::device->Get().getBufferMemoryRequirements(buffer);
     memoryRequirements.alignment = std::max(memoryRequirements.alignment, minMemoryAlignment);
 
-    const VmaAllocationCreateInfo allocationCreateInfo = Details::GetAllocationCreateInfo(memoryProperties);
+    const VmaAllocationCreateInfo allocationCreateInfo = Details::GetBufferAllocationCreateInfo(memoryProperties);
 
     VmaAllocation allocation;
     VmaAllocationInfo allocationInfo;
@@ -105,6 +118,27 @@ vk::Buffer MemoryManager::CreateBuffer(const vk::BufferCreateInfo& createInfo, v
     return buffer;
 }
 
+vk::Buffer MemoryManager::CreatePersistentlyMappedBuffer(const vk::BufferCreateInfo& createInfo,
+        vk::MemoryPropertyFlags memoryProperties)
+{
+    Assert(memoryProperties & vk::MemoryPropertyFlagBits::eHostVisible);
+
+    VmaAllocationCreateInfo allocationCreateInfo = Details::GetBufferAllocationCreateInfo(memoryProperties);
+    allocationCreateInfo.flags |= VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+
+    VkBuffer buffer;
+    VmaAllocation allocation;
+
+    const VkResult result = vmaCreateBuffer(allocator, &createInfo.operator VkBufferCreateInfo const&(),
+            &allocationCreateInfo, &buffer, &allocation, nullptr);
+
+    Assert(result == VK_SUCCESS);
+
+    bufferAllocations.emplace(buffer, allocation);
+
+    return buffer;
+}
+
 void MemoryManager::DestroyBuffer(vk::Buffer buffer)
 {
     const auto it = bufferAllocations.find(buffer);
@@ -173,3 +207,16 @@ void MemoryManager::UnmapMemory(const MemoryBlock& memoryBlock) const
 {
     VulkanContext::device->Get().unmapMemory(memoryBlock.memory);
 }
+
+ByteAccess MemoryManager::GetPersistentMapping(vk::Buffer buffer) const
+{
+    const auto it = bufferAllocations.find(buffer);
+    Assert(it != bufferAllocations.end());
+
+    VmaAllocationInfo allocationInfo;
+    vmaGetAllocationInfo(allocator, it->second, &allocationInfo);
+
+    Assert(allocationInfo.pMappedData);
+
+    return ByteAccess(static_cast<uint8_t*>(allocationInfo.pMappedData), allocationInfo.size);
+}
@@ -13,20 +13,13 @@ namespace Details
     static constexpr vk::Format kHdrFormat = vk::Format::eR32G32B32A32Sfloat;
 
     static void UpdateImage(vk::CommandBuffer commandBuffer, vk::Image image,
-            const ImageDescription& description, const ByteView& data)
+            const ImageDescription& description, vk::Buffer stagingBuffer, vk::DeviceSize stagingOffset)
     {
-        Assert(data.size == ImageHelpers::CalculateMipLevelSize(description, 0));
-
         const vk::ImageSubresourceRange fullImage(vk::ImageAspectFlagBits::eColor,
                 0, description.mipLevelCount, 0, description.layerCount);
 
         const vk::ImageSubresourceLayers baseMipLevel = ImageHelpers::GetSubresourceLayers(fullImage, 0);
 
-        const ImageUpdate imageUpdate{
-            baseMipLevel, { 0, 0, 0 },
-            description.extent, data
-        };
-
         const ImageLayoutTransition layoutTransition{
             vk::ImageLayout::eUndefined,
             vk::ImageLayout::eTransferDstOptimal,
@@ -38,7 +31,10 @@ namespace Details
 
         ImageHelpers::TransitImageLayout(commandBuffer, image, fullImage, layoutTransition);
 
-        VulkanContext::imageManager->UpdateImage(commandBuffer, image, { imageUpdate });
+        const vk::BufferImageCopy region(stagingOffset, 0, 0,
+                baseMipLevel, vk::Offset3D(0, 0, 0), description.extent);
+
+        commandBuffer.copyBufferToImage(stagingBuffer, image, vk::ImageLayout::eTransferDstOptimal, { region });
     }
 
     static void TransitImageLayoutAfterMipLevelsGenerating(vk::CommandBuffer commandBuffer,
@@ -130,15 +126,17 @@ Texture TextureManager::CreateTexture(vk::Format format, const vk::Extent2D& ext
         vk::MemoryPropertyFlagBits::eDeviceLocal
     };
 
-    const vk::Image image = VulkanContext::imageManager->CreateImage(imageDescription,
-            ImageCreateFlagBits::eStagingBuffer);
+    Assert(data.size == ImageHelpers::CalculateMipLevelSize(imageDescription, 0));
+
+    const vk::Image image = VulkanContext::imageManager->CreateImage(imageDescription, ImageCreateFlags::kNone);
 
     const vk::ImageSubresourceRange fullImage(vk::ImageAspectFlagBits::eColor,
             0, imageDescription.mipLevelCount, 0, imageDescription.layerCount);
 
-    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+    VulkanContext::uploadManager->Upload(data, [&](vk::CommandBuffer commandBuffer,
+            vk::Buffer stagingBuffer, vk::DeviceSize stagingOffset)
         {
-            Details::UpdateImage(commandBuffer, image, imageDescription, data);
+            Details::UpdateImage(commandBuffer, image, imageDescription, stagingBuffer, stagingOffset);
 
             if (imageDescription.mipLevelCount > 1)
             {
@@ -180,6 +178,59 @@ Texture TextureManager::CreateTexture(vk::Format format, const vk::Extent2D& ext
     return Texture{ image, view };
 }
 
+Texture TextureManager::CreateTexture(const ImageDescription& description, const ByteView& data) const
+{
+    EASY_FUNCTION()
+
+    Assert(description.usage & vk::ImageUsageFlagBits::eTransferDst);
+    Assert(data.size == ImageHelpers::CalculateImageSize(description));
+
+    const vk::Image image = VulkanContext::imageManager->CreateImage(description, ImageCreateFlags::kNone);
+
+    const vk::ImageSubresourceRange fullImage(vk::ImageAspectFlagBits::eColor,
+            0, description.mipLevelCount, 0, description.layerCount);
+
+    VulkanContext::uploadManager->Upload(data, [&](vk::CommandBuffer commandBuffer,
+            vk::Buffer stagingBuffer, vk::DeviceSize stagingOffset)
+        {
+            {
+                const ImageLayoutTransition layoutTransition{
+                    vk::ImageLayout::eUndefined,
+                    vk::ImageLayout::eTransferDstOptimal,
+                    PipelineBarrier{
+                        SyncScope::kWaitForNone,
+                        SyncScope::kTransferWrite
+                    }
+                };
+
+                ImageHelpers::TransitImageLayout(commandBuffer, image, fullImage, layoutTransition);
+            }
+
+            commandBuffer.copyBufferToImage(stagingBuffer, image, vk::ImageLayout::eTransferDstOptimal,
+                    ImageHelpers::GetImageCopyRegions(description, stagingOffset));
+
+            {
+                const ImageLayoutTransition layoutTransition{
+                    vk::ImageLayout::eTransferDstOptimal,
+                    vk::ImageLayout::eShaderReadOnlyOptimal,
+                    PipelineBarrier{
+                        SyncScope::kTransferWrite,
+                        SyncScope::kBlockNone
+                    }
+                };
+
+                ImageHelpers::TransitImageLayout(commandBuffer, image, fullImage, layoutTransition);
+            }
+        });
+
+    const vk::ImageViewType viewType = description.type == ImageType::eCube
+            ? vk::ImageViewType::eCube : vk::ImageViewType::e2D;
+
+    const vk::ImageView view = VulkanContext::imageManager->CreateView(image, viewType, fullImage);
+
+    return Texture{ image, view };
+}
+
 Texture TextureManager::CreateCubeTexture(const Texture& panoramaTexture, const vk::Extent2D& extent) const
 {
     EASY_FUNCTION()
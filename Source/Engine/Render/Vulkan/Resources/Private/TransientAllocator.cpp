@@ -0,0 +1,66 @@
+#include "Engine/Render/Vulkan/Resources/TransientAllocator.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+
+#include "Utils/Helpers.hpp"
+
+namespace Details
+{
+    static vk::Buffer CreateBuffer(vk::DeviceSize size)
+    {
+        const Queues::Description& queuesDescription = VulkanContext::device->GetQueuesDescription();
+
+        const vk::BufferCreateInfo createInfo({}, size, vk::BufferUsageFlagBits::eUniformBuffer,
+                vk::SharingMode::eExclusive, 0, &queuesDescription.graphicsFamilyIndex);
+
+        const vk::MemoryPropertyFlags memoryProperties
+                = vk::MemoryPropertyFlagBits::eHostVisible
+                | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+        return VulkanContext::memoryManager->CreatePersistentlyMappedBuffer(createInfo, memoryProperties);
+    }
+}
+
+TransientAllocator::TransientAllocator()
+{
+    alignment = VulkanContext::device->GetLimits().minUniformBufferOffsetAlignment;
+
+    regionSize = AlignUp(VulkanConfig::kTransientRegionSize, alignment);
+    regionCount = VulkanConfig::kMaxFramesInFlight;
+
+    buffer = Details::CreateBuffer(regionSize * regionCount);
+
+    stats.regionSize = regionSize;
+
+    memory = VulkanContext::memoryManager->GetPersistentMapping(buffer);
+}
+
+TransientAllocator::~TransientAllocator()
+{
+    VulkanContext::memoryManager->DestroyBuffer(buffer);
+}
+
+void TransientAllocator::BeginFrame(uint32_t frameIndex)
+{
+    Assert(frameIndex < regionCount);
+
+    stats.lastFrameSize = head;
+    stats.peakFrameSize = std::max(stats.peakFrameSize, head);
+
+    regionOffset = frameIndex * regionSize;
+    head = 0;
+}
+
+uint32_t TransientAllocator::Allocate(const ByteView& data)
+{
+    Assert(head + data.size <= regionSize);
+
+    const vk::DeviceSize offset = regionOffset + head;
+
+    std::memcpy(memory.data + offset, data.data, data.size);
+
+    head = AlignUp(head + data.size, alignment);
+
+    return static_cast<uint32_t>(offset);
+}
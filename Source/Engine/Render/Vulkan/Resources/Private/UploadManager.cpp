@@ -0,0 +1,381 @@
+#include "Engine/Render/Vulkan/Resources/UploadManager.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/VulkanConfig.hpp"
+#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
+
+#include "Utils/Helpers.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    static constexpr vk::DeviceSize kMinStagingAlignment = 16;
+
+    static const SyncScope kAllCommandsWrite{
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::AccessFlagBits::eMemoryWrite
+    };
+
+    static const SyncScope kAllCommandsAccess{
+        vk::PipelineStageFlagBits::eAllCommands,
+        vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite
+    };
+
+    // Ring is read by both graphics and transfer queues
+    static vk::Buffer CreateRingBuffer(vk::DeviceSize size, const QueueFamilyTransfer& queueFamilyTransfer)
+    {
+        const std::array<uint32_t, 2> queueFamilyIndices{
+            queueFamilyTransfer.srcFamilyIndex,
+            queueFamilyTransfer.dstFamilyIndex
+        };
+
+        const vk::SharingMode sharingMode = queueFamilyTransfer.IsRequired()
+                ? vk::SharingMode::eConcurrent : vk::SharingMode::eExclusive;
+
+        const vk::BufferCreateInfo createInfo({}, size, vk::BufferUsageFlagBits::eTransferSrc, sharingMode,
+                queueFamilyTransfer.IsRequired() ? 2 : 1, queueFamilyIndices.data());
+
+        const vk::MemoryPropertyFlags memoryProperties
+                = vk::MemoryPropertyFlagBits::eHostVisible
+                | vk::MemoryPropertyFlagBits::eHostCoherent;
+
+        return VulkanContext::memoryManager->CreatePersistentlyMappedBuffer(createInfo, memoryProperties);
+    }
+}
+
+bool UploadManager::StagingRange::Overlaps(const StagingRange& other) const
+{
+    return begin < other.end && other.begin < end;
+}
+
+UploadManager::UploadManager()
+{
+    queueFamilyTransfer = VulkanContext::device->GetQueueFamilyTransfer(QueueType::eTransfer, QueueType::eGraphics);
+
+    ringBuffer = Details::CreateRingBuffer(VulkanConfig::kUploadRingSize, queueFamilyTransfer);
+    ringMemory = ByteAccess(VulkanContext::memoryManager->GetPersistentMapping(ringBuffer).data,
+            VulkanConfig::kUploadRingSize);
+
+    ringAlignment = std::max(Details::kMinStagingAlignment,
+            VulkanContext::device->GetLimits().optimalBufferCopyOffsetAlignment);
+
+    pendingBatch.value = 1;
+}
+
+UploadManager::~UploadManager()
+{
+    Flush();
+
+    Assert(submittedBatches.empty());
+
+    VulkanContext::memoryManager->DestroyBuffer(ringBuffer);
+}
+
+UploadTicket UploadManager::Upload(const ByteView& data, const UploadCommands& commands)
+{
+    EASY_FUNCTION()
+
+    const auto [stagingBuffer, stagingOffset] = StageData(data);
+
+    if (!pendingBatch.commandBuffer)
+    {
+        pendingBatch.commandBuffer = GetCommandBuffer(QueueType::eGraphics);
+    }
+
+    commands(pendingBatch.commandBuffer, stagingBuffer, stagingOffset);
+
+    pendingBatch.size += data.size;
+    ++pendingBatch.uploadCount;
+
+    return UploadTicket{ pendingBatch.value };
+}
+
+UploadTicket UploadManager::UploadBuffer(vk::Buffer buffer, const ByteView& data)
+{
+    return UploadBuffer(buffer, 0, data);
+}
+
+UploadTicket UploadManager::UploadBuffer(vk::Buffer buffer, vk::DeviceSize offset, const ByteView& data)
+{
+    const auto commands = [&](vk::CommandBuffer commandBuffer, vk::Buffer stagingBuffer, vk::DeviceSize stagingOffset)
+        {
+            const vk::BufferCopy region(stagingOffset, offset, data.size);
+
+            commandBuffer.copyBuffer(stagingBuffer, buffer, { region });
+        };
+
+    if (!queueFamilyTransfer.IsRequired())
+    {
+        return Upload(data, commands);
+    }
+
+    EASY_FUNCTION()
+
+    const auto [stagingBuffer, stagingOffset] = StageData(data);
+
+    if (!pendingBatch.transferCommandBuffer)
+    {
+        pendingBatch.transferCommandBuffer = GetCommandBuffer(QueueType::eTransfer);
+    }
+
+    commands(pendingBatch.transferCommandBuffer, stagingBuffer, stagingOffset);
+
+    VulkanHelpers::ReleaseBufferOwnership(pendingBatch.transferCommandBuffer, buffer,
+            queueFamilyTransfer, SyncScope::kTransferWrite, offset, data.size);
+
+    pendingBatch.transferredRanges.push_back(TransferredRange{ buffer, offset, data.size });
+
+    pendingBatch.size += data.size;
+    ++pendingBatch.uploadCount;
+
+    return UploadTicket{ pendingBatch.value };
+}
+
+void UploadManager::Submit()
+{
+    if (!pendingBatch.commandBuffer && !pendingBatch.transferCommandBuffer)
+    {
+        return;
+    }
+
+    EASY_FUNCTION()
+
+    std::vector<QueueSubmission> waitedSubmissions;
+
+    if (pendingBatch.transferCommandBuffer)
+    {
+        const vk::Result result = pendingBatch.transferCommandBuffer.end();
+        Assert(result == vk::Result::eSuccess);
+
+        waitedSubmissions.push_back(VulkanContext::device->Submit(
+                QueueType::eTransfer, pendingBatch.transferCommandBuffer));
+
+        if (!pendingBatch.commandBuffer)
+        {
+            pendingBatch.commandBuffer = GetCommandBuffer(QueueType::eGraphics);
+        }
+
+        for (const auto& [buffer, offset, size] : pendingBatch.transferredRanges)
+        {
+            VulkanHelpers::AcquireBufferOwnership(pendingBatch.commandBuffer, buffer,
+                    queueFamilyTransfer, Details::kAllCommandsAccess, offset, size);
+        }
+    }
+
+    const vk::CommandBuffer commandBuffer = pendingBatch.commandBuffer;
+
+    const PipelineBarrier barrier{
+        Details::kAllCommandsWrite,
+        Details::kAllCommandsAccess
+    };
+
+    VulkanHelpers::InsertMemoryBarrier(commandBuffer, barrier);
+
+    const vk::Result result = commandBuffer.end();
+    Assert(result == vk::Result::eSuccess);
+
+    pendingBatch.submission = VulkanContext::device->Submit(QueueType::eGraphics, commandBuffer, waitedSubmissions);
+
+    LogD << "Upload batch " << pendingBatch.value << " submitted: " << pendingBatch.uploadCount
+            << " uploads, " << pendingBatch.size << " bytes, " << pendingBatch.transferredRanges.size()
+            << " on transfer queue" << "\n";
+
+    const uint64_t nextValue = pendingBatch.value + 1;
+
+    submittedBatches.push_back(std::move(pendingBatch));
+
+    pendingBatch = Batch{};
+    pendingBatch.value = nextValue;
+
+    ReleaseCompletedBatches();
+}
+
+void UploadManager::Wait(UploadTicket ticket)
+{
+    if (ticket.value >= pendingBatch.value)
+    {
+        Submit();
+    }
+
+    if (const Batch* batch = FindSubmittedBatch(ticket))
+    {
+        VulkanContext::device->Wait(batch->submission);
+    }
+
+    ReleaseCompletedBatches();
+}
+
+void UploadManager::Flush()
+{
+    EASY_FUNCTION()
+
+    Submit();
+
+    Wait(UploadTicket{ pendingBatch.value - 1 });
+}
+
+bool UploadManager::IsComplete(UploadTicket ticket) const
+{
+    if (ticket.value >= pendingBatch.value)
+    {
+        return false;
+    }
+
+    const Batch* batch = FindSubmittedBatch(ticket);
+
+    return !batch || VulkanContext::device->IsComplete(batch->submission);
+}
+
+std::pair<vk::Buffer, vk::DeviceSize> UploadManager::StageData(const ByteView& data)
+{
+    Assert(data.size > 0);
+
+    if (data.size <= ringMemory.size)
+    {
+        const vk::DeviceSize stagingOffset = AllocateRange(data.size);
+
+        std::memcpy(ringMemory.data + stagingOffset, data.data, data.size);
+
+        return std::make_pair(ringBuffer, stagingOffset);
+    }
+
+    const vk::Buffer stagingBuffer = BufferHelpers::CreateStagingBuffer(data.size);
+
+    data.CopyTo(VulkanContext::memoryManager->GetPersistentMapping(stagingBuffer));
+
+    pendingBatch.stagingBuffers.push_back(stagingBuffer);
+
+    return std::make_pair(stagingBuffer, 0);
+}
+
+vk::CommandBuffer UploadManager::GetCommandBuffer(QueueType queueType)
+{
+    vk::CommandBuffer commandBuffer;
+
+    std::vector<vk::CommandBuffer>& queueCommandBuffers = freeCommandBuffers[queueType];
+
+    if (queueCommandBuffers.empty())
+    {
+        commandBuffer = VulkanContext::device->AllocateCommandBuffer(CommandBufferType::eLongLived, queueType);
+    }
+    else
+    {
+        commandBuffer = queueCommandBuffers.back();
+        queueCommandBuffers.pop_back();
+    }
+
+    const vk::CommandBufferBeginInfo beginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    const vk::Result result = commandBuffer.begin(beginInfo);
+    Assert(result == vk::Result::eSuccess);
+
+    const PipelineBarrier barrier{
+        Details::kAllCommandsWrite,
+        SyncScope::kTransferWrite
+    };
+
+    VulkanHelpers::InsertMemoryBarrier(commandBuffer, barrier);
+
+    return commandBuffer;
+}
+
+// Released batches are complete
+const UploadManager::Batch* UploadManager::FindSubmittedBatch(UploadTicket ticket) const
+{
+    const auto it = std::ranges::find_if(submittedBatches, [&ticket](const Batch& batch)
+        {
+            return batch.value == ticket.value;
+        });
+
+    return it != submittedBatches.end() ? &*it : nullptr;
+}
+
+vk::DeviceSize UploadManager::AllocateRange(vk::DeviceSize size)
+{
+    StagingRange range;
+    range.begin = AlignUp(ringHead, ringAlignment);
+
+    if (range.begin + size > ringMemory.size)
+    {
+        range.begin = 0;
+    }
+
+    range.end = range.begin + size;
+
+    const auto pred = [&range](const StagingRange& other)
+        {
+            return range.Overlaps(other);
+        };
+
+    if (std::ranges::any_of(pendingBatch.ranges, pred))
+    {
+        Submit();
+    }
+
+    WaitForRange(range);
+
+    if (!pendingBatch.ranges.empty() && pendingBatch.ranges.back().end <= range.begin
+            && range.begin - pendingBatch.ranges.back().end < ringAlignment)
+    {
+        pendingBatch.ranges.back().end = range.end;
+    }
+    else
+    {
+        pendingBatch.ranges.push_back(range);
+    }
+
+    ringHead = range.end;
+
+    return range.begin;
+}
+
+void UploadManager::WaitForRange(const StagingRange& range)
+{
+    uint64_t value = 0;
+
+    for (const Batch& batch : submittedBatches)
+    {
+        for (const StagingRange& batchRange : batch.ranges)
+        {
+            if (range.Overlaps(batchRange))
+            {
+                value = batch.value;
+            }
+        }
+    }
+
+    if (value > 0)
+    {
+        EASY_BLOCK("UploadManager::WaitForRange")
+
+        Wait(UploadTicket{ value });
+    }
+}
+
+void UploadManager::ReleaseCompletedBatches()
+{
+    while (!submittedBatches.empty() && VulkanContext::device->IsComplete(submittedBatches.front().submission))
+    {
+        const Batch& batch = submittedBatches.front();
+
+        for (const vk::Buffer stagingBuffer : batch.stagingBuffers)
+        {
+            VulkanContext::memoryManager->DestroyBuffer(stagingBuffer);
+        }
+
+        const vk::Result resetResult = batch.commandBuffer.reset(vk::CommandBufferResetFlags());
+        Assert(resetResult == vk::Result::eSuccess);
+
+        freeCommandBuffers[QueueType::eGraphics].push_back(batch.commandBuffer);
+
+        if (batch.transferCommandBuffer)
+        {
+            const vk::Result transferResetResult = batch.transferCommandBuffer.reset(vk::CommandBufferResetFlags());
+            Assert(transferResetResult == vk::Result::eSuccess);
+
+            freeCommandBuffers[QueueType::eTransfer].push_back(batch.transferCommandBuffer);
+        }
+
+        submittedBatches.pop_front();
+    }
+}
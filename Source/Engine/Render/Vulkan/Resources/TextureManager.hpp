@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
+#include "Engine/Render/Vulkan/Resources/ImageHelpers.hpp"
 #include "Engine/Filesystem/Filepath.hpp"
 
 #include "Utils/DataHelpers.hpp"
@@ -16,6 +17,9 @@ public:
 
     Texture CreateTexture(vk::Format format, const vk::Extent2D& extent, const ByteView& data) const;
 
+    // Data contains all mip levels and layers packed as ImageHelpers::GetImageCopyRegions describes
+    Texture CreateTexture(const ImageDescription& description, const ByteView& data) const;
+
     Texture CreateCubeTexture(const Texture& panoramaTexture, const vk::Extent2D& extent) const;
 
     Texture CreateColorTexture(const glm::vec4& color) const;
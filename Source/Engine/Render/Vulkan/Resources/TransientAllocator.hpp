@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Utils/DataHelpers.hpp"
+
+// Linear allocator of per-frame constants in a persistently mapped uniform buffer.
+// The buffer is split into one region per frame in flight, a region is reset when its frame begins.
+// Allocations are bound as dynamic uniform buffers, writing them is a plain copy without barriers.
+class TransientAllocator
+{
+public:
+    struct Stats
+    {
+        vk::DeviceSize regionSize = 0;
+        vk::DeviceSize lastFrameSize = 0;
+        vk::DeviceSize peakFrameSize = 0;
+    };
+
+    TransientAllocator();
+    ~TransientAllocator();
+
+    vk::Buffer GetBuffer() const { return buffer; }
+
+    const Stats& GetStats() const { return stats; }
+
+    // Has to be called once the frame which previously used the region has been completed on the device
+    void BeginFrame(uint32_t frameIndex);
+
+    // Returns dynamic offset of the copied data, valid until the end of the current frame
+    uint32_t Allocate(const ByteView& data);
+
+private:
+    vk::Buffer buffer;
+    ByteAccess memory;
+
+    vk::DeviceSize alignment = 0;
+    vk::DeviceSize regionSize = 0;
+    uint32_t regionCount = 0;
+
+    vk::DeviceSize regionOffset = 0;
+    vk::DeviceSize head = 0;
+
+    Stats stats;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/Device.hpp"
+
+#include "Utils/DataHelpers.hpp"
+
+// Handle of an upload batch, batches are submitted and completed in the order of their values
+struct UploadTicket
+{
+    uint64_t value = 0;
+};
+
+// Records commands consuming the data which is placed in the staging buffer at the given offset
+using UploadCommands = std::function<void(vk::CommandBuffer, vk::Buffer, vk::DeviceSize)>;
+
+// Buffer uploads are recorded for the transfer queue when it has a dedicated family, ownership of the uploaded
+// ranges is then released to the graphics family. Other uploads and the acquisition are recorded for the graphics
+// queue, its submission waits for the transfer one, so later graphics submissions observe all uploads of a batch.
+class UploadManager
+{
+public:
+    UploadManager();
+    ~UploadManager();
+
+    UploadTicket Upload(const ByteView& data, const UploadCommands& commands);
+
+    // Buffer range must not be in use by the device, the copy is not ordered with graphics work in flight
+    UploadTicket UploadBuffer(vk::Buffer buffer, const ByteView& data);
+
+    UploadTicket UploadBuffer(vk::Buffer buffer, vk::DeviceSize offset, const ByteView& data);
+
+    void Submit();
+
+    void Wait(UploadTicket ticket);
+
+    void Flush();
+
+    bool IsComplete(UploadTicket ticket) const;
+
+private:
+    struct StagingRange
+    {
+        vk::DeviceSize begin = 0;
+        vk::DeviceSize end = 0;
+
+        bool Overlaps(const StagingRange& other) const;
+    };
+
+    struct TransferredRange
+    {
+        vk::Buffer buffer;
+        vk::DeviceSize offset = 0;
+        vk::DeviceSize size = 0;
+    };
+
+    struct Batch
+    {
+        uint64_t value = 0;
+        vk::CommandBuffer commandBuffer;
+        vk::CommandBuffer transferCommandBuffer;
+        std::vector<TransferredRange> transferredRanges;
+        std::vector<StagingRange> ranges;
+        std::vector<vk::Buffer> stagingBuffers;
+        vk::DeviceSize size = 0;
+        uint32_t uploadCount = 0;
+        QueueSubmission submission;
+    };
+
+    QueueFamilyTransfer queueFamilyTransfer;
+
+    std::map<QueueType, std::vector<vk::CommandBuffer>> freeCommandBuffers;
+
+    vk::Buffer ringBuffer;
+    ByteAccess ringMemory;
+    vk::DeviceSize ringHead = 0;
+    vk::DeviceSize ringAlignment = 0;
+
+    Batch pendingBatch;
+    std::list<Batch> submittedBatches;
+
+    std::pair<vk::Buffer, vk::DeviceSize> StageData(const ByteView& data);
+
+    vk::CommandBuffer GetCommandBuffer(QueueType queueType);
+
+    const Batch* FindSubmittedBatch(UploadTicket ticket) const;
+
+    vk::DeviceSize AllocateRange(vk::DeviceSize size);
+
+    void WaitForRange(const StagingRange& range);
+
+    void ReleaseCompletedBatches();
+};
@@ -8,6 +8,7 @@
 #include "Engine/Render/Vulkan/Shaders/ShaderCompiler.hpp"
 
 #include "Utils/Assert.hpp"
+#include "Utils/Helpers.hpp"
 
 namespace Details
 {
@@ -169,6 +170,19 @@ void ShaderCompiler::Finalize()
     }
 }
 
+size_t ShaderCompiler::GetTargetHash()
+{
+    size_t hash = 0;
+
+    CombineHash(hash, static_cast<int32_t>(Details::kClientVersion));
+    CombineHash(hash, static_cast<int32_t>(Details::kTargetVersion));
+    CombineHash(hash, Details::kInputVersion);
+    CombineHash(hash, Details::kDefaultVersion);
+    CombineHash(hash, static_cast<int32_t>(Details::kDefaultMessages));
+
+    return hash;
+}
+
 std::vector<uint32_t> ShaderCompiler::Compile(const std::string& glslCode,
         vk::ShaderStageFlagBits shaderStage, const std::string& folder)
 {
@@ -195,6 +209,7 @@ std::vector<uint32_t> ShaderCompiler::Compile(const std::string& glslCode,
     {
         LogE << "Failed to parse shader:\n" << shader.getInfoLog() << shader.getInfoDebugLog() << "\n";
         Assert(false);
+        return {};
     }
 
     glslang::TProgram program;
@@ -204,6 +219,7 @@ std::vector<uint32_t> ShaderCompiler::Compile(const std::string& glslCode,
     {
         LogE << "Failed to link shader:\n" << shader.getInfoLog() << shader.getInfoDebugLog() << "\n";
         Assert(false);
+        return {};
     }
 
     std::vector<uint32_t> spirv;
@@ -5,9 +5,12 @@
 #include "Engine/Filesystem/Filesystem.hpp"
 
 #include "Utils/Assert.hpp"
+#include "Utils/Helpers.hpp"
 
 namespace Details
 {
+    static constexpr uint32_t kSpirvMagic = 0x07230203;
+
     std::string PreprocessCode(const std::string& code, const ShaderDefines& defines)
     {
         std::istringstream stream(code);
@@ -40,10 +43,130 @@ namespace Details
 
         return result;
     }
+
+    static std::optional<std::string> ParseInclude(const std::string& line)
+    {
+        const size_t directive = line.find("#include");
+        if (directive == std::string::npos)
+        {
+            return std::nullopt;
+        }
+
+        const size_t begin = line.find('"', directive);
+        if (begin == std::string::npos)
+        {
+            return std::nullopt;
+        }
+
+        const size_t end = line.find('"', begin + 1);
+        if (end == std::string::npos)
+        {
+            return std::nullopt;
+        }
+
+        return line.substr(begin + 1, end - begin - 1);
+    }
+
+    static void HashIncludes(const std::string& code, const Filepath& directory,
+            const Filepath& baseDirectory, std::set<std::string>& visitedIncludes, size_t& hash)
+    {
+        std::istringstream stream(code);
+
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            const std::optional<std::string> include = ParseInclude(line);
+
+            if (!include.has_value())
+            {
+                continue;
+            }
+
+            Filepath includePath(directory.GetAbsolute() + include.value());
+
+            if (!includePath.Exists())
+            {
+                includePath = Filepath(baseDirectory.GetAbsolute() + include.value());
+            }
+
+            if (!includePath.Exists())
+            {
+                CombineHash(hash, include.value());
+                continue;
+            }
+
+            if (!visitedIncludes.insert(includePath.GetAbsolute()).second)
+            {
+                continue;
+            }
+
+            const std::string includeCode = Filesystem::ReadFile(includePath);
+
+            CombineHash(hash, includePath.GetAbsolute());
+            CombineHash(hash, includeCode);
+
+            HashIncludes(includeCode, Filepath(includePath.GetDirectory()), baseDirectory, visitedIncludes, hash);
+        }
+    }
+
+    static size_t CalculateHash(vk::ShaderStageFlagBits stage, const std::string& glslCode,
+            const ShaderDefines& defines, const Filepath& baseDirectory)
+    {
+        size_t hash = ShaderCompiler::GetTargetHash();
+
+        CombineHash(hash, static_cast<uint32_t>(stage));
+        CombineHash(hash, glslCode);
+
+        for (const auto& [name, value] : defines)
+        {
+            CombineHash(hash, name);
+            CombineHash(hash, value);
+        }
+
+        std::set<std::string> visitedIncludes;
+
+        HashIncludes(glslCode, baseDirectory, baseDirectory, visitedIncludes, hash);
+
+        return hash;
+    }
+
+    static const std::vector<uint32_t> kEmptySpirvCode;
+
+    static Filepath GetCachePath(const Filepath& cacheDirectory, size_t hash)
+    {
+        return Filepath(cacheDirectory.GetAbsolute() + Format("%016zx.spv", hash));
+    }
+
+    static std::vector<uint32_t> LoadSpirvCode(const Filepath& path)
+    {
+        if (!path.Exists())
+        {
+            return {};
+        }
+
+        const Bytes bytes = Filesystem::ReadBinaryFile(path);
+
+        if (bytes.size() < sizeof(uint32_t) || bytes.size() % sizeof(uint32_t) != 0)
+        {
+            return {};
+        }
+
+        std::vector<uint32_t> spirvCode(bytes.size() / sizeof(uint32_t));
+
+        std::memcpy(spirvCode.data(), bytes.data(), bytes.size());
+
+        if (spirvCode.front() != kSpirvMagic)
+        {
+            return {};
+        }
+
+        return spirvCode;
+    }
 }
 
-ShaderManager::ShaderManager(const Filepath& baseDirectory_)
+ShaderManager::ShaderManager(const Filepath& baseDirectory_, const Filepath& cacheDirectory_)
     : baseDirectory(baseDirectory_)
+    , cacheDirectory(cacheDirectory_)
 {
     Assert(baseDirectory.IsDirectory());
 
@@ -62,7 +185,10 @@ ShaderModule ShaderManager::CreateShaderModule(vk::ShaderStageFlagBits stage,
 
     const std::string glslCode = Details::PreprocessCode(Filesystem::ReadFile(filepath), defines);
 
-    const std::vector<uint32_t> spirvCode = ShaderCompiler::Compile(glslCode, stage, baseDirectory.GetAbsolute());
+    const size_t hash = Details::CalculateHash(stage, glslCode, defines, baseDirectory);
+
+    const std::vector<uint32_t>& spirvCode = RetrieveSpirvCode(stage, filepath, glslCode, hash);
+    Assert(!spirvCode.empty());
 
     const vk::ShaderModuleCreateInfo createInfo({}, spirvCode.size() * sizeof(uint32_t), spirvCode.data());
     const auto [result, module] = VulkanContext::device->Get().createShaderModule(createInfo);
@@ -75,3 +201,38 @@ void ShaderManager::DestroyShaderModule(const ShaderModule& shaderModule) const
 {
     VulkanContext::device->Get().destroyShaderModule(shaderModule.module);
 }
+
+const std::vector<uint32_t>& ShaderManager::RetrieveSpirvCode(vk::ShaderStageFlagBits stage,
+        const Filepath& filepath, const std::string& glslCode, size_t hash) const
+{
+    const auto it = spirvCache.find(hash);
+
+    if (it != spirvCache.end())
+    {
+        return it->second;
+    }
+
+    const Filepath cachePath = Details::GetCachePath(cacheDirectory, hash);
+
+    std::vector<uint32_t> spirvCode = Details::LoadSpirvCode(cachePath);
+
+    if (spirvCode.empty())
+    {
+        EASY_BLOCK("ShaderManager::CompileShader")
+
+        spirvCode = ShaderCompiler::Compile(glslCode, stage, baseDirectory.GetAbsolute());
+
+        if (spirvCode.empty())
+        {
+            // Failed compilation is not cached, so the shader is compiled again on the next request
+            LogE << "Shader compilation failed: " << filepath.GetFilename() << "\n";
+            return Details::kEmptySpirvCode;
+        }
+
+        LogD << "Shader compiled: " << filepath.GetFilename() << "\n";
+
+        Filesystem::WriteBinaryFile(cachePath, ByteView(spirvCode));
+    }
+
+    return spirvCache.emplace(hash, std::move(spirvCode)).first->second;
+}
@@ -5,6 +5,8 @@ namespace ShaderCompiler
     void Initialize();
     void Finalize();
 
+    size_t GetTargetHash();
+
     std::vector<uint32_t> Compile(const std::string& glslCode,
             vk::ShaderStageFlagBits shaderStage, const std::string& folder);
 }
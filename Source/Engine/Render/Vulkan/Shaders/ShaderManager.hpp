@@ -8,7 +8,7 @@ using ShaderDefines = std::map<std::string, uint32_t>;
 class ShaderManager
 {
 public:
-    ShaderManager(const Filepath& baseDirectory_);
+    ShaderManager(const Filepath& baseDirectory_, const Filepath& cacheDirectory_);
     ~ShaderManager();
 
     ShaderModule CreateShaderModule(vk::ShaderStageFlagBits stage, const Filepath& filepath,
@@ -22,6 +22,12 @@ public:
 
 private:
     Filepath baseDirectory;
+    Filepath cacheDirectory;
+
+    mutable std::map<size_t, std::vector<uint32_t>> spirvCache;
+
+    const std::vector<uint32_t>& RetrieveSpirvCode(vk::ShaderStageFlagBits stage,
+            const Filepath& filepath, const std::string& glslCode, size_t hash) const;
 };
 
 template <class... Types>
@@ -16,6 +16,9 @@ public:
 
     vk::SwapchainKHR Get() const { return swapchain; }
 
+    // Created without surface, the images are never presented and can be read back
+    bool IsOffscreen() const { return !swapchain; }
+
     vk::Format GetFormat() const { return format; }
 
     uint32_t GetImageCount() const { return static_cast<uint32_t>(images.size()); }
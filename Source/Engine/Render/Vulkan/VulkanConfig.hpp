@@ -19,27 +19,61 @@ namespace VulkanConfig
         VK_KHR_RAY_TRACING_PIPELINE_EXTENSION_NAME,
         VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME,
         VK_KHR_RAY_QUERY_EXTENSION_NAME,
+        VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME,
     };
 
     constexpr Device::Features kRequiredDeviceFeatures{
         .samplerAnisotropy = true,
+        .multiDrawIndirect = true,
+        .drawIndirectFirstInstance = true,
         .accelerationStructure = true,
         .rayTracingPipeline = true,
         .descriptorIndexing = true,
         .bufferDeviceAddress = true,
-        .rayQuery = true
+        .rayQuery = true,
+        .timelineSemaphore = true
     };
 
     const std::vector<vk::DescriptorPoolSize> kDescriptorPoolSizes{
         { vk::DescriptorType::eUniformBuffer, 2048 },
+        { vk::DescriptorType::eUniformBufferDynamic, 64 },
         { vk::DescriptorType::eCombinedImageSampler, 2048 },
         { vk::DescriptorType::eStorageImage, 2048 },
+        { vk::DescriptorType::eStorageBuffer, 2048 },
         { vk::DescriptorType::eAccelerationStructureKHR, 512 }
     };
 
     constexpr uint32_t kSwapchainMinImageCount = 3;
 
+    // Frames recorded by the host ahead of the device, independent of the swapchain image count
+    constexpr uint32_t kMaxFramesInFlight = 2;
+
     constexpr uint32_t kMaxDescriptorSetCount = 512;
 
     constexpr std::optional<float> kMaxAnisotropy = 16.0f;
+
+    constexpr vk::DeviceSize kUploadRingSize = 64 * Numbers::kMegabyte;
+
+    constexpr vk::DeviceSize kBufferPoolArenaSize = 64 * Numbers::kMegabyte;
+
+    // Per-frame constants, one region per frame in flight
+    constexpr vk::DeviceSize kTransientRegionSize = 1 * Numbers::kMegabyte;
+
+    // Timestamp scopes recorded per frame, including the root frame scope
+    constexpr uint32_t kGpuProfilerMaxScopeCount = 64;
+
+    constexpr uint32_t kGpuProfilerAverageFrameCount = 64;
+
+    // Host and device events of the recent frames kept for the trace export
+    constexpr uint32_t kGpuProfilerTraceEventCount = 16384;
+
+    constexpr vk::DeviceSize kBlasBatchScratchSize = 128 * Numbers::kMegabyte;
+
+    constexpr bool kBlasCompactionEnabled = true;
+
+    // Dynamic TLAS is rebuilt instead of refitted after this many refits
+    constexpr uint32_t kTlasMaxRefitCount = 64;
+
+    // or when this fraction of its instances has changed since the last rebuild
+    constexpr float kTlasRebuildInstanceRatio = 0.25f;
 }
@@ -5,10 +5,15 @@
 #include "Engine/Render/Vulkan/Surface.hpp"
 #include "Engine/Render/Vulkan/Swapchain.hpp"
 #include "Engine/Render/Vulkan/DescriptorPool.hpp"
+#include "Engine/Render/Vulkan/PipelineCache.hpp"
+#include "Engine/Render/Vulkan/GpuProfiler.hpp"
 #include "Engine/Render/Vulkan/Resources/MemoryManager.hpp"
 #include "Engine/Render/Vulkan/Resources/BufferManager.hpp"
+#include "Engine/Render/Vulkan/Resources/BufferPool.hpp"
 #include "Engine/Render/Vulkan/Resources/ImageManager.hpp"
 #include "Engine/Render/Vulkan/Resources/TextureManager.hpp"
+#include "Engine/Render/Vulkan/Resources/UploadManager.hpp"
+#include "Engine/Render/Vulkan/Resources/TransientAllocator.hpp"
 #include "Engine/Render/Vulkan/Shaders/ShaderManager.hpp"
 #include "Engine/Render/Vulkan/RayTracing/AccelerationStructureManager.hpp"
 
@@ -17,7 +22,8 @@ class Window;
 class VulkanContext
 {
 public:
-    static void Create(const Window& window);
+    // Headless context is created without window, it has no surface and renders to offscreen images
+    static void Create(const Window* window);
     static void Destroy();
 
     static std::unique_ptr<Instance> instance;
@@ -25,6 +31,7 @@ public:
     static std::unique_ptr<Surface> surface;
     static std::unique_ptr<Swapchain> swapchain;
     static std::unique_ptr<DescriptorPool> descriptorPool;
+    static std::unique_ptr<PipelineCache> pipelineCache;
 
     static std::unique_ptr<ShaderManager> shaderManager;
     static std::unique_ptr<MemoryManager> memoryManager;
@@ -32,4 +39,8 @@ public:
     static std::unique_ptr<ImageManager> imageManager;
     static std::unique_ptr<TextureManager> textureManager;
     static std::unique_ptr<AccelerationStructureManager> accelerationStructureManager;
+    static std::unique_ptr<UploadManager> uploadManager;
+    static std::unique_ptr<TransientAllocator> transientAllocator;
+    static std::unique_ptr<BufferPool> bufferPool;
+    static std::unique_ptr<GpuProfiler> gpuProfiler;
 };
@@ -14,7 +14,10 @@ struct SyncScope
     static const SyncScope kTransferRead;
     static const SyncScope kVerticesRead;
     static const SyncScope kIndicesRead;
+    static const SyncScope kIndirectCommandRead;
     static const SyncScope kAccelerationStructureBuild;
+    static const SyncScope kAccelerationStructureWrite;
+    static const SyncScope kAccelerationStructureShaderRead;
     static const SyncScope kRayTracingShaderWrite;
     static const SyncScope kRayTracingShaderRead;
     static const SyncScope kRayTracingUniformRead;
@@ -57,6 +60,21 @@ enum class CommandBufferType
     eLongLived
 };
 
+enum class QueueType
+{
+    eGraphics,
+    eTransfer,
+    eCompute
+};
+
+struct QueueFamilyTransfer
+{
+    uint32_t srcFamilyIndex;
+    uint32_t dstFamilyIndex;
+
+    bool IsRequired() const { return srcFamilyIndex != dstFamilyIndex; }
+};
+
 struct CommandBufferSync
 {
     std::vector<vk::Semaphore> waitSemaphores;
@@ -81,6 +99,8 @@ namespace VulkanHelpers
 
     vk::Semaphore CreateSemaphore(vk::Device device);
 
+    vk::Semaphore CreateTimelineSemaphore(vk::Device device, uint64_t initialValue);
+
     vk::Fence CreateFence(vk::Device device, vk::FenceCreateFlags flags);
 
     void DestroyCommandBufferSync(vk::Device device, const CommandBufferSync& sync);
@@ -99,6 +119,19 @@ namespace VulkanHelpers
 
     void WaitForFences(vk::Device device, std::vector<vk::Fence> fences);
 
+    void WaitForTimelineSemaphore(vk::Device device, vk::Semaphore semaphore, uint64_t value);
+
+    void InsertMemoryBarrier(vk::CommandBuffer commandBuffer, const PipelineBarrier& barrier);
+
+    // Has to be paired with AcquireBufferOwnership recorded for the queue of the destination family
+    void ReleaseBufferOwnership(vk::CommandBuffer commandBuffer, vk::Buffer buffer,
+            const QueueFamilyTransfer& transfer, const SyncScope& waitedScope,
+            vk::DeviceSize offset = 0, vk::DeviceSize size = VK_WHOLE_SIZE);
+
+    void AcquireBufferOwnership(vk::CommandBuffer commandBuffer, vk::Buffer buffer,
+            const QueueFamilyTransfer& transfer, const SyncScope& blockedScope,
+            vk::DeviceSize offset = 0, vk::DeviceSize size = VK_WHOLE_SIZE);
+
     template <class T>
     vk::Extent2D GetExtent(T width, T height)
     {
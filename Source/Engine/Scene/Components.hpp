@@ -16,6 +16,7 @@ struct TransformComponent
 {
     Transform localTransform;
     Transform worldTransform;
+    bool dirty = true; // worldTransform is recalculated by TransformHierarchy::Update
 };
 
 struct RenderObject
@@ -43,7 +44,5 @@ struct LightComponent
 
 namespace ComponentHelpers
 {
-    void AccumulateTransform(Scene& scene, entt::entity entity);
-
     std::vector<gpu::Light> CollectLights(const Scene& scene);
 }
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Engine/Scene/Environment.hpp"
+
+namespace EnvironmentCache
+{
+    std::optional<EnvironmentComponent> Load(size_t panoramaHash, size_t configHash);
+
+    void Save(size_t panoramaHash, size_t configHash, const EnvironmentComponent& environment);
+
+    std::optional<Texture> LoadSpecularBRDF(size_t configHash);
+
+    void SaveSpecularBRDF(size_t configHash, const Texture& specularBRDF);
+}
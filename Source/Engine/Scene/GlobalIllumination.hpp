@@ -3,12 +3,15 @@
 #include "Engine/Scene/StorageComponents.hpp"
 
 class Scene;
+class AABBox;
 class ComputePipeline;
+class ProbeRenderer;
 
 struct LightVolumeComponent
 {
     vk::Buffer positionsBuffer;
     vk::Buffer tetrahedralBuffer;
+    vk::Buffer tetrahedronGridBuffer;
     vk::Buffer coefficientsBuffer;
     std::vector<glm::vec3> positions;
     std::vector<uint32_t> edgeIndices;
@@ -20,6 +23,8 @@ public:
     GlobalIllumination();
     ~GlobalIllumination();
 
+    std::optional<LightVolumeComponent> LoadLightVolume(const Scene& scene) const;
+
     LightVolumeComponent GenerateLightVolume(const Scene& scene) const;
 
 private:
@@ -27,4 +32,13 @@ private:
     vk::DescriptorSetLayout coefficientsLayout;
 
     std::unique_ptr<ComputePipeline> lightVolumePipeline;
+
+    Bytes ProjectProbesOnGpu(ProbeRenderer& probeRenderer, const std::vector<glm::vec3>& positions) const;
 };
+
+namespace GlobalIlluminationHelpers
+{
+    // Subdivides the volume into octree cells while they contain geometry, returns the deduplicated cell corners
+    std::vector<glm::vec3> GenerateLightVolumePositions(
+            const AABBox& volumeBBox, const std::function<bool(const AABBox&)>& geometryPredicate);
+}
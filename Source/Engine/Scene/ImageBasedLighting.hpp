@@ -18,6 +18,9 @@ public:
 
     const Samplers& GetSamplers() const { return samplers; }
 
+    // Parameters which affect the generated textures, used to validate cached environments
+    size_t GetConfigHash() const;
+
     Texture GenerateIrradianceTexture(const Texture& cubemapTexture) const;
 
     Texture GenerateReflectionTexture(const Texture& cubemapTexture) const;
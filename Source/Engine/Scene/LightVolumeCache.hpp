@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Shaders/Common/Common.h"
+
+#include "Utils/DataHelpers.hpp"
+
+// CPU side copy of a generated light volume, SH coefficients are stored in the GPU buffer layout
+struct LightVolumeData
+{
+    std::vector<glm::vec3> positions;
+    std::vector<gpu::Tetrahedron> tetrahedral;
+    std::vector<uint32_t> edgeIndices;
+    Bytes coefficients;
+};
+
+namespace LightVolumeCache
+{
+    std::optional<LightVolumeData> Load(size_t sceneHash, size_t configHash);
+
+    void Save(size_t sceneHash, size_t configHash, const LightVolumeData& lightVolumeData);
+}
@@ -14,6 +14,20 @@ struct TetrahedralData
     std::vector<uint32_t> edgesIndices;
 };
 
+// Uniform grid over the tetrahedral bbox, each cell stores a tetrahedron close to its center to start walks from
+struct TetrahedronGridData
+{
+    gpu::TetrahedronGrid grid;
+    std::vector<int32_t> cells;
+};
+
+struct TetrahedronWalk
+{
+    int32_t tetrahedron = -1; // last visited tetrahedron, the containing one unless the walk left the tetrahedral
+    uint32_t stepCount = 0;
+    bool outside = false;
+};
+
 namespace MeshHelpers
 {
     Mesh GenerateSphere(float radius, uint32_t sectorCount, uint32_t stackCount);
@@ -21,4 +35,13 @@ namespace MeshHelpers
     Mesh GenerateSphere(float radius);
 
     TetrahedralData GenerateTetrahedral(const std::vector<glm::vec3>& vertices);
+
+    TetrahedronGridData GenerateTetrahedronGrid(const std::vector<glm::vec3>& vertices,
+            const std::vector<gpu::Tetrahedron>& tetrahedral);
+
+    int32_t GetStartTetrahedron(const TetrahedronGridData& gridData, const glm::vec3& position);
+
+    // CPU reference of the walk performed by SampleLightVolume in LightVolume.glsl
+    TetrahedronWalk FindTetrahedron(const std::vector<glm::vec3>& vertices,
+            const std::vector<gpu::Tetrahedron>& tetrahedral, const glm::vec3& position, int32_t startTetrahedron);
 }
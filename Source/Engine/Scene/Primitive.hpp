@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Engine/Render/Vulkan/Resources/BufferHelpers.hpp"
+
 #include "Utils/AABBox.hpp"
 #include "Utils/DataHelpers.hpp"
 
@@ -18,9 +20,10 @@ struct Primitive
 
     vk::IndexType indexType;
     uint32_t indexCount;
+    uint32_t vertexCount;
 
-    vk::Buffer indexBuffer;
-    vk::Buffer vertexBuffer;
+    BufferSlice indexBuffer;
+    BufferSlice vertexBuffer;
 
     AABBox bbox;
 };
@@ -4,27 +4,6 @@
 
 #include "Utils/Helpers.hpp"
 
-void ComponentHelpers::AccumulateTransform(Scene& scene, entt::entity entity)
-{
-    TransformComponent& tc = scene.get<TransformComponent>(entity);
-
-    const HierarchyComponent& hc = scene.get<HierarchyComponent>(entity);
-
-    tc.worldTransform = tc.localTransform;
-
-    entt::entity parent = hc.parent;
-
-    while (parent != entt::null)
-    {
-        const TransformComponent& parentTc = scene.get<TransformComponent>(parent);
-        const HierarchyComponent& parentHc = scene.get<HierarchyComponent>(parent);
-
-        tc.worldTransform *= parentTc.localTransform;
-
-        parent = parentHc.parent;
-    }
-}
-
 std::vector<gpu::Light> ComponentHelpers::CollectLights(const Scene& scene)
 {
     const auto sceneLightsView = scene.view<TransformComponent, LightComponent>();
@@ -273,15 +273,10 @@ namespace Details
 
     static gpu::Light RetrieveDirectLight(vk::Buffer parametersBuffer)
     {
-        const MemoryManager& memoryManager = *VulkanContext::memoryManager;
-
-        const MemoryBlock memoryBlock = memoryManager.GetBufferMemoryBlock(parametersBuffer);
-        const ByteAccess parameters = memoryManager.MapMemory(memoryBlock);
+        const ByteAccess parameters = VulkanContext::memoryManager->GetPersistentMapping(parametersBuffer);
 
         gpu::Light directLight = *reinterpret_cast<gpu::Light*>(parameters.data);
 
-        memoryManager.UnmapMemory(memoryBlock);
-
         const float luminance = GetLuminance(directLight.color);
         directLight.color /= glm::max(luminance / Config::kMaxEnvironmentLuminance, 1.0f);
 
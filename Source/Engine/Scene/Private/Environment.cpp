@@ -3,6 +3,9 @@
 #include "Engine/Render/RenderContext.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Scene/ImageBasedLighting.hpp"
+#include "Engine/Scene/EnvironmentCache.hpp"
+#include "Engine/Filesystem/Filesystem.hpp"
+#include "Engine/Config.hpp"
 
 namespace Details
 {
@@ -33,20 +36,68 @@ namespace Details
 
         return VulkanContext::textureManager->CreateCubeTexture(panoramaTexture, environmentExtent);
     }
+
+    static size_t CalculatePanoramaHash(const Filepath& panoramaPath)
+    {
+        EASY_FUNCTION()
+
+        const Bytes bytes = Filesystem::ReadBinaryFile(panoramaPath);
+
+        const std::string_view data(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+
+        return std::hash<std::string_view>()(data);
+    }
+
+    static size_t CalculateConfigHash()
+    {
+        size_t hash = RenderContext::imageBasedLighting->GetConfigHash();
+
+        CombineHash(hash, kMaxCubemapExtent.width);
+        CombineHash(hash, kMaxCubemapExtent.height);
+
+        return hash;
+    }
+
+    static EnvironmentComponent GenerateEnvironment(const Filepath& panoramaPath)
+    {
+        EASY_FUNCTION()
+
+        const Texture panoramaTexture = VulkanContext::textureManager->CreateTexture(panoramaPath);
+
+        const Texture cubemapTexture = CreateCubemapTexture(panoramaTexture);
+
+        const Texture irradianceTexture = RenderContext::imageBasedLighting->GenerateIrradianceTexture(cubemapTexture);
+        const Texture reflectionTexture = RenderContext::imageBasedLighting->GenerateReflectionTexture(cubemapTexture);
+
+        VulkanContext::textureManager->DestroyTexture(panoramaTexture);
+
+        return EnvironmentComponent{ cubemapTexture, irradianceTexture, reflectionTexture };
+    }
 }
 
 EnvironmentComponent EnvironmentHelpers::LoadEnvironment(const Filepath& panoramaPath)
 {
     EASY_FUNCTION()
 
-    const Texture panoramaTexture = VulkanContext::textureManager->CreateTexture(panoramaPath);
+    if constexpr (Config::kEnvironmentCacheEnabled)
+    {
+        const size_t panoramaHash = Details::CalculatePanoramaHash(panoramaPath);
+        const size_t configHash = Details::CalculateConfigHash();
+
+        const std::optional<EnvironmentComponent> cachedEnvironment
+                = EnvironmentCache::Load(panoramaHash, configHash);
+
+        if (cachedEnvironment.has_value())
+        {
+            return cachedEnvironment.value();
+        }
 
-    const Texture cubemapTexture = Details::CreateCubemapTexture(panoramaTexture);
+        const EnvironmentComponent environment = Details::GenerateEnvironment(panoramaPath);
 
-    const Texture irradianceTexture = RenderContext::imageBasedLighting->GenerateIrradianceTexture(cubemapTexture);
-    const Texture reflectionTexture = RenderContext::imageBasedLighting->GenerateReflectionTexture(cubemapTexture);
+        EnvironmentCache::Save(panoramaHash, configHash, environment);
 
-    VulkanContext::textureManager->DestroyTexture(panoramaTexture);
+        return environment;
+    }
 
-    return EnvironmentComponent{ cubemapTexture, irradianceTexture, reflectionTexture };
+    return Details::GenerateEnvironment(panoramaPath);
 }
@@ -0,0 +1,225 @@
+#include "Engine/Scene/EnvironmentCache.hpp"
+
+#include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Filesystem/Filesystem.hpp"
+#include "Engine/Config.hpp"
+
+#include "Utils/Serialization.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kMagic = 0x564E4553; // "SENV"
+
+    static constexpr uint32_t kVersion = 1;
+
+    static constexpr vk::ImageUsageFlags kTextureUsage = vk::ImageUsageFlagBits::eSampled
+            | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst;
+
+    struct Header
+    {
+        uint32_t magic = kMagic;
+        uint32_t version = kVersion;
+        uint32_t textureCount = 0;
+        uint64_t sourceHash = 0;
+        uint64_t configHash = 0;
+    };
+
+    struct TextureData
+    {
+        ImageDescription description;
+        Bytes data;
+    };
+
+    static Filepath GetCachePath(size_t panoramaHash)
+    {
+        const std::string filename = Format("%016zx.environment", panoramaHash);
+
+        return Filepath(Config::kCacheDirectory.GetAbsolute() + "Environments/" + filename);
+    }
+
+    static Filepath GetSpecularBRDFCachePath()
+    {
+        return Filepath(Config::kCacheDirectory.GetAbsolute() + "Environments/SpecularBRDF.texture");
+    }
+
+    static bool IsHeaderValid(const Header& header, const Header& expectedHeader)
+    {
+        return header.magic == expectedHeader.magic
+                && header.version == expectedHeader.version
+                && header.textureCount == expectedHeader.textureCount
+                && header.sourceHash == expectedHeader.sourceHash
+                && header.configHash == expectedHeader.configHash;
+    }
+
+    static void WriteTexture(BinaryWriter& writer, const Texture& texture)
+    {
+        const ImageDescription& description = VulkanContext::imageManager->GetImageDescription(texture.image);
+
+        writer.Write(description.type);
+        writer.Write(description.format);
+        writer.Write(description.extent);
+        writer.Write(description.mipLevelCount);
+        writer.Write(description.layerCount);
+        writer.Write(ImageHelpers::ReadImage(texture.image, vk::ImageLayout::eShaderReadOnlyOptimal));
+    }
+
+    static void ReadTexture(BinaryReader& reader, TextureData& textureData)
+    {
+        ImageDescription& description = textureData.description;
+
+        description.sampleCount = vk::SampleCountFlagBits::e1;
+        description.tiling = vk::ImageTiling::eOptimal;
+        description.usage = kTextureUsage;
+        description.memoryProperties = vk::MemoryPropertyFlagBits::eDeviceLocal;
+
+        reader.Read(description.type);
+        reader.Read(description.format);
+        reader.Read(description.extent);
+        reader.Read(description.mipLevelCount);
+        reader.Read(description.layerCount);
+        reader.Read(textureData.data);
+    }
+
+    static bool IsTextureDataValid(const TextureData& textureData)
+    {
+        const ImageDescription& description = textureData.description;
+
+        return ImageHelpers::GetTexelSize(description.format) > 0
+                && description.mipLevelCount > 0
+                && description.mipLevelCount <= ImageHelpers::CalculateMipLevelCount(description.extent)
+                && description.layerCount > 0
+                && textureData.data.size() == ImageHelpers::CalculateImageSize(description);
+    }
+
+    static void WriteCacheFile(const Filepath& cachePath, const Header& header, const std::vector<Texture>& textures)
+    {
+        BinaryWriter writer;
+
+        writer.Write(header);
+
+        for (const Texture& texture : textures)
+        {
+            WriteTexture(writer, texture);
+        }
+
+        Filesystem::WriteBinaryFile(cachePath, ByteView(writer.GetBytes()));
+    }
+
+    static std::optional<std::vector<Texture>> ReadCacheFile(const Filepath& cachePath, const Header& expectedHeader)
+    {
+        if (!cachePath.Exists())
+        {
+            return std::nullopt;
+        }
+
+        const Bytes bytes = Filesystem::ReadBinaryFile(cachePath);
+
+        BinaryReader reader{ ByteView(bytes) };
+
+        Header header;
+        reader.Read(header);
+
+        if (!reader.IsValid() || !IsHeaderValid(header, expectedHeader))
+        {
+            return std::nullopt;
+        }
+
+        std::vector<TextureData> texturesData(header.textureCount);
+
+        for (TextureData& textureData : texturesData)
+        {
+            ReadTexture(reader, textureData);
+        }
+
+        const auto pred = [](const TextureData& textureData)
+            {
+                return IsTextureDataValid(textureData);
+            };
+
+        if (!reader.IsValid() || !reader.IsEnd() || !std::ranges::all_of(texturesData, pred))
+        {
+            LogW << "Corrupted environment cache: " << cachePath.GetAbsolute() << "\n";
+            return std::nullopt;
+        }
+
+        std::vector<Texture> textures;
+        textures.reserve(texturesData.size());
+
+        for (const TextureData& textureData : texturesData)
+        {
+            textures.push_back(VulkanContext::textureManager->CreateTexture(
+                    textureData.description, ByteView(textureData.data)));
+        }
+
+        return textures;
+    }
+}
+
+std::optional<EnvironmentComponent> EnvironmentCache::Load(size_t panoramaHash, size_t configHash)
+{
+    EASY_FUNCTION()
+
+    Details::Header expectedHeader;
+    expectedHeader.textureCount = 3;
+    expectedHeader.sourceHash = panoramaHash;
+    expectedHeader.configHash = configHash;
+
+    const std::optional<std::vector<Texture>> textures
+            = Details::ReadCacheFile(Details::GetCachePath(panoramaHash), expectedHeader);
+
+    if (!textures.has_value())
+    {
+        return std::nullopt;
+    }
+
+    return EnvironmentComponent{ textures.value()[0], textures.value()[1], textures.value()[2] };
+}
+
+void EnvironmentCache::Save(size_t panoramaHash, size_t configHash, const EnvironmentComponent& environment)
+{
+    EASY_FUNCTION()
+
+    Details::Header header;
+    header.textureCount = 3;
+    header.sourceHash = panoramaHash;
+    header.configHash = configHash;
+
+    const std::vector<Texture> textures{
+        environment.cubemapTexture,
+        environment.irradianceTexture,
+        environment.reflectionTexture
+    };
+
+    Details::WriteCacheFile(Details::GetCachePath(panoramaHash), header, textures);
+}
+
+std::optional<Texture> EnvironmentCache::LoadSpecularBRDF(size_t configHash)
+{
+    EASY_FUNCTION()
+
+    Details::Header expectedHeader;
+    expectedHeader.textureCount = 1;
+    expectedHeader.configHash = configHash;
+
+    const std::optional<std::vector<Texture>> textures
+            = Details::ReadCacheFile(Details::GetSpecularBRDFCachePath(), expectedHeader);
+
+    if (!textures.has_value())
+    {
+        return std::nullopt;
+    }
+
+    return textures.value().front();
+}
+
+void EnvironmentCache::SaveSpecularBRDF(size_t configHash, const Texture& specularBRDF)
+{
+    EASY_FUNCTION()
+
+    Details::Header header;
+    header.textureCount = 1;
+    header.configHash = configHash;
+
+    Details::WriteCacheFile(Details::GetSpecularBRDFCachePath(), header, { specularBRDF });
+}
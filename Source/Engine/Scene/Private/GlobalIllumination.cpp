@@ -1,11 +1,18 @@
+#include <unordered_map>
+
 #include "Engine/Scene/GlobalIllumination.hpp"
 
 #include "Engine/Render/OcclusionRenderer.hpp"
 #include "Engine/Render/ProbeRenderer.hpp"
 #include "Engine/Render/RenderContext.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/LightVolumeCache.hpp"
 #include "Engine/Scene/MeshHelpers.hpp"
 #include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/SphericalHarmonics.hpp"
+#include "Engine/Config.hpp"
+#include "Engine/JobSystem.hpp"
 
 #include "Utils/AABBox.hpp"
 #include "Utils/TimeHelpers.hpp"
@@ -26,6 +33,23 @@ namespace Details
         bool containsGeometry;
     };
 
+    using GridKey = glm::vec<3, int64_t>;
+
+    struct GridKeyHash
+    {
+        size_t operator()(const GridKey& key) const noexcept
+        {
+            size_t result = 0;
+
+            CombineHash(result, key.x);
+            CombineHash(result, key.y);
+            CombineHash(result, key.z);
+
+            return result;
+        }
+    };
+
+    // Probe positions are quantized to a grid of this step, so shared cell corners map to the same key
     static constexpr float kEps = 0.000001f;
 
     static constexpr float kMinBBoxSize = 0.4f;
@@ -34,12 +58,12 @@ namespace Details
 
     static constexpr uint32_t kCoefficientCount = COEFFICIENT_COUNT;
 
-    static const Filepath kLightVolumeShaderPath("~/Shaders/Compute/GlobalIllumination/LightVolume.comp");
+    // Probes captured with a single dispatch and read back together
+    static constexpr uint32_t kProbeBatchSize = 64;
 
-    static glm::vec3 Round(const glm::vec3& value)
-    {
-        return glm::round(value / kEps) * kEps;
-    }
+    static constexpr float kProjectionTimeProbeCount = 1000.0f;
+
+    static const Filepath kLightVolumeShaderPath("~/Shaders/Compute/GlobalIllumination/LightVolume.comp");
 
     static vk::DescriptorSetLayout CreateProbeLayout()
     {
@@ -111,91 +135,262 @@ namespace Details
         return bboxes;
     }
 
-    static void ProcessBBox(const OcclusionRenderer& renderer,
-            const AABBox& bbox, std::vector<BBoxInfo>& result)
+    static std::vector<BBoxInfo> ProcessBBox(const BBoxPredicate& containsGeometry, const AABBox& rootBBox)
     {
-        if (renderer.ContainsGeometry(bbox))
+        EASY_FUNCTION()
+
+        std::vector<BBoxInfo> result;
+
+        std::vector<AABBox> stack{ rootBBox };
+
+        while (!stack.empty())
         {
-            if (bbox.GetShortestEdge() * 0.5f > kMinBBoxSize)
+            const AABBox bbox = stack.back();
+            stack.pop_back();
+
+            if (containsGeometry(bbox))
             {
-                for (const AABBox& b : SplitBBox(bbox))
+                if (bbox.GetShortestEdge() * 0.5f > kMinBBoxSize)
+                {
+                    const std::array<AABBox, 8> bboxes = SplitBBox(bbox);
+
+                    stack.insert(stack.end(), bboxes.rbegin(), bboxes.rend());
+                }
+                else
                 {
-                    ProcessBBox(renderer, b, result);
+                    result.push_back(BBoxInfo{ bbox, true });
                 }
             }
             else
             {
-                result.push_back(BBoxInfo{ bbox, true });
+                result.push_back(BBoxInfo{ bbox, false });
             }
         }
-        else
-        {
-            result.push_back(BBoxInfo{ bbox, false });
-        }
+
+        return result;
     }
 
-    static std::vector<glm::vec3> GenerateLightVolumePositions(
-            const Scene* scene, const AABBox& sceneBBox)
+    static GridKey GetGridKey(const glm::vec3& position)
     {
-        EASY_FUNCTION()
+        return GridKey(glm::round(glm::dvec3(position) / static_cast<double>(kEps)));
+    }
 
-        const OcclusionRenderer occlusionRenderer(scene);
+    static glm::vec3 GetGridPosition(const GridKey& key)
+    {
+        return glm::vec3(glm::dvec3(key) * static_cast<double>(kEps));
+    }
 
-        std::vector<BBoxInfo> bboxesInfo;
-        for (const AABBox& bbox : SplitBBox(sceneBBox))
-        {
-            ProcessBBox(occlusionRenderer, bbox, bboxesInfo);
-        }
+    static vk::Buffer CreateLightVolumeCoefficientsBuffer(uint32_t probeCount)
+    {
+        const uint32_t size = probeCount * kCoefficientCount * sizeof(glm::vec3);
 
-        std::vector<PositionInfo> positionsInfo;
-        for (const auto& [bbox, containsGeometry] : bboxesInfo)
-        {
-            const std::array<glm::vec3, 8> corners = bbox.GetCorners();
+        const BufferDescription description{
+            size, vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc,
+            vk::MemoryPropertyFlagBits::eDeviceLocal
+        };
 
-            for (const auto& corner : corners)
-            {
-                const glm::vec3 position = Round(corner);
+        return VulkanContext::bufferManager->CreateBuffer(description, BufferCreateFlags::kNone);
+    }
 
-                const auto pred = [&](const PositionInfo& info)
-                    {
-                        return info.position == position;
-                    };
+    static Bytes ReadCoefficients(vk::Buffer coefficientsBuffer)
+    {
+        EASY_FUNCTION()
+
+        const vk::DeviceSize size = VulkanContext::bufferManager->GetBufferDescription(coefficientsBuffer).size;
+
+        const BufferDescription description{
+            size, vk::BufferUsageFlagBits::eTransferDst,
+            vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent
+        };
 
-                const auto it = std::ranges::find_if(positionsInfo, pred);
+        const vk::Buffer readbackBuffer = VulkanContext::bufferManager->CreateBuffer(
+                description, BufferCreateFlags::kNone);
 
-                if (it != positionsInfo.end())
+        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+            {
                 {
-                    it->containsGeometry |= containsGeometry;
+                    const PipelineBarrier barrier{
+                        SyncScope::kComputeShaderWrite,
+                        SyncScope::kTransferRead
+                    };
+
+                    BufferHelpers::InsertPipelineBarrier(commandBuffer, coefficientsBuffer, barrier);
                 }
-                else
+
+                const vk::BufferCopy region(0, 0, size);
+
+                commandBuffer.copyBuffer(coefficientsBuffer, readbackBuffer, { region });
+
                 {
-                    positionsInfo.push_back(PositionInfo{ position, containsGeometry });
+                    const PipelineBarrier barrier{
+                        SyncScope::kTransferWrite,
+                        SyncScope{ vk::PipelineStageFlagBits::eHost, vk::AccessFlagBits::eHostRead }
+                    };
+
+                    BufferHelpers::InsertPipelineBarrier(commandBuffer, readbackBuffer, barrier);
                 }
-            }
+            });
+
+        Bytes coefficients(size);
+
+        VulkanContext::bufferManager->ReadBuffer(nullptr, readbackBuffer, [&](const ByteView& data)
+            {
+                std::memcpy(coefficients.data(), data.data, coefficients.size());
+            });
+
+        VulkanContext::bufferManager->DestroyBuffer(readbackBuffer);
+
+        return coefficients;
+    }
+
+    template <class T>
+    static void CombineDataHash(size_t& hash, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        CombineHash(hash, std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
+    }
+
+    static size_t CalculateSceneHash(const Scene& scene)
+    {
+        EASY_FUNCTION()
+
+        size_t hash = 0;
+
+        const auto& gsc = scene.ctx().get<GeometryStorageComponent>();
+        const auto& msc = scene.ctx().get<MaterialStorageComponent>();
+
+        for (const Primitive& primitive : gsc.primitives)
+        {
+            CombineHash(hash, primitive.indexCount);
+            CombineDataHash(hash, primitive.bbox.GetMin());
+            CombineDataHash(hash, primitive.bbox.GetMax());
         }
 
-        std::vector<glm::vec3> positions;
-        for (const auto& [position, containsGeometry] : positionsInfo)
+        for (const Material& material : msc.materials)
         {
-            if (containsGeometry)
+            const std::string_view materialData(reinterpret_cast<const char*>(&material.data),
+                    offsetof(gpu::Material, padding));
+
+            CombineHash(hash, materialData);
+        }
+
+        for (auto&& [entity, tc, rc] : scene.view<TransformComponent, RenderComponent>().each())
+        {
+            CombineDataHash(hash, tc.worldTransform.GetMatrix());
+
+            for (const RenderObject& ro : rc.renderObjects)
             {
-                positions.push_back(position);
+                CombineHash(hash, ro.primitive);
+                CombineHash(hash, ro.material);
             }
         }
 
-        return positions;
+        for (auto&& [entity, tc, lc] : scene.view<TransformComponent, LightComponent>().each())
+        {
+            CombineDataHash(hash, tc.worldTransform.GetMatrix());
+            CombineHash(hash, static_cast<uint32_t>(lc.type));
+            CombineDataHash(hash, lc.color);
+        }
+
+        return hash;
     }
 
-    static vk::Buffer CreateLightVolumeCoefficientsBuffer(uint32_t probeCount)
+    static size_t CalculateConfigHash()
     {
-        const uint32_t size = probeCount * kCoefficientCount * sizeof(glm::vec3);
+        size_t hash = 0;
+
+        CombineHash(hash, kEps);
+        CombineHash(hash, kMinBBoxSize);
+        CombineHash(hash, kBBoxExtension);
+        CombineHash(hash, kCoefficientCount);
+        CombineHash(hash, ProbeRenderer::kSampleCount);
+        CombineHash(hash, ProbeRenderer::kProbeExtent.width);
+        CombineHash(hash, ProbeRenderer::kProbeExtent.height);
+        CombineHash(hash, Config::kLightVolumeCpuProjection);
+
+        return hash;
+    }
 
-        const BufferDescription description{
-            size, vk::BufferUsageFlagBits::eStorageBuffer,
-            vk::MemoryPropertyFlagBits::eDeviceLocal
-        };
+    static Bytes GetTetrahedronGridBytes(const TetrahedronGridData& gridData)
+    {
+        const size_t cellsSize = gridData.cells.size() * sizeof(int32_t);
 
-        return VulkanContext::bufferManager->CreateBuffer(description, BufferCreateFlags::kNone);
+        Bytes bytes(sizeof(gpu::TetrahedronGrid) + cellsSize);
+
+        std::memcpy(bytes.data(), &gridData.grid, sizeof(gpu::TetrahedronGrid));
+        std::memcpy(bytes.data() + sizeof(gpu::TetrahedronGrid), gridData.cells.data(), cellsSize);
+
+        return bytes;
+    }
+
+    // Compares walks to tetrahedra centroids started from the grid with ones started from the first tetrahedron
+    static void LogTetrahedronWalkStatistics(const LightVolumeData& lightVolumeData,
+            const TetrahedronGridData& gridData)
+    {
+        EASY_FUNCTION()
+
+        const std::vector<glm::vec3>& positions = lightVolumeData.positions;
+        const std::vector<gpu::Tetrahedron>& tetrahedral = lightVolumeData.tetrahedral;
+
+        if (tetrahedral.empty())
+        {
+            return;
+        }
+
+        uint64_t gridStepCount = 0;
+        uint64_t firstStepCount = 0;
+        uint32_t gridMaxStepCount = 0;
+        uint32_t firstMaxStepCount = 0;
+
+        for (const gpu::Tetrahedron& tetrahedron : tetrahedral)
+        {
+            glm::vec3 centroid(0.0f);
+
+            for (const int32_t vertex : tetrahedron.vertices)
+            {
+                centroid += positions[vertex] / static_cast<float>(TET_VERTEX_COUNT);
+            }
+
+            const int32_t startTetrahedron = MeshHelpers::GetStartTetrahedron(gridData, centroid);
+
+            const TetrahedronWalk gridWalk = MeshHelpers::FindTetrahedron(
+                    positions, tetrahedral, centroid, startTetrahedron);
+            const TetrahedronWalk firstWalk = MeshHelpers::FindTetrahedron(
+                    positions, tetrahedral, centroid, 0);
+
+            gridStepCount += gridWalk.stepCount;
+            firstStepCount += firstWalk.stepCount;
+            gridMaxStepCount = std::max(gridMaxStepCount, gridWalk.stepCount);
+            firstMaxStepCount = std::max(firstMaxStepCount, firstWalk.stepCount);
+        }
+
+        const float tetrahedronCount = static_cast<float>(tetrahedral.size());
+
+        LogI << "Light volume tetrahedron walk steps: "
+                << static_cast<float>(gridStepCount) / tetrahedronCount << " average, "
+                << gridMaxStepCount << " max from grid cells; "
+                << static_cast<float>(firstStepCount) / tetrahedronCount << " average, "
+                << firstMaxStepCount << " max from the first tetrahedron\n";
+    }
+
+    static LightVolumeComponent CreateLightVolume(const LightVolumeData& lightVolumeData,
+            const TetrahedronGridData& gridData)
+    {
+        const vk::Buffer positionsBuffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(lightVolumeData.positions));
+        const vk::Buffer tetrahedralBuffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(lightVolumeData.tetrahedral));
+        const vk::Buffer tetrahedronGridBuffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(GetTetrahedronGridBytes(gridData)));
+        const vk::Buffer coefficientsBuffer = BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc,
+                ByteView(lightVolumeData.coefficients));
+
+        return LightVolumeComponent{
+            positionsBuffer, tetrahedralBuffer, tetrahedronGridBuffer, coefficientsBuffer,
+            lightVolumeData.positions, lightVolumeData.edgeIndices
+        };
     }
 
     static vk::DescriptorSet AllocateCoefficientsDescriptorSet(
@@ -226,6 +421,113 @@ namespace Details
 
         return descriptorSet;
     }
+
+    static void LogProjectionTime(const char* projectionPath, float projectionSeconds, size_t probeCount)
+    {
+        if (probeCount == 0)
+        {
+            return;
+        }
+
+        const float miliseconds = projectionSeconds / Numbers::kMili;
+
+        LogI << "Light volume SH projection on " << projectionPath << ": "
+                << miliseconds * kProjectionTimeProbeCount / static_cast<float>(probeCount)
+                << " ms per 1000 probes\n";
+    }
+
+    static void LogBakeTime(float bakeSeconds, size_t probeCount)
+    {
+        LogI << "Light volume probes baked: " << probeCount << " probes in " << bakeSeconds << " s, "
+                << static_cast<float>(probeCount) / std::max(bakeSeconds, Numbers::kMicro) << " probes per second\n";
+    }
+
+    // Average of every coefficient over all probes, CPU and GPU projection paths should log matching values
+    static void LogCoefficientsAverage(const Bytes& coefficients, size_t probeCount)
+    {
+        if (probeCount == 0)
+        {
+            return;
+        }
+
+        Assert(coefficients.size() == probeCount * kCoefficientCount * sizeof(glm::vec3));
+
+        const glm::vec3* probeCoefficients = reinterpret_cast<const glm::vec3*>(coefficients.data());
+
+        std::array<glm::dvec3, kCoefficientCount> sums{};
+
+        for (size_t i = 0; i < probeCount * kCoefficientCount; ++i)
+        {
+            sums[i % kCoefficientCount] += glm::dvec3(probeCoefficients[i]);
+        }
+
+        std::string averages;
+
+        for (const glm::dvec3& sum : sums)
+        {
+            const glm::dvec3 average = sum / static_cast<double>(probeCount);
+
+            averages += Format(" (%.4f, %.4f, %.4f)", average.x, average.y, average.z);
+        }
+
+        LogI << "Light volume SH coefficients average:" << averages << "\n";
+    }
+
+    static std::vector<glm::vec3> GetBatchPositions(const std::vector<glm::vec3>& positions, size_t batchBegin)
+    {
+        const size_t batchEnd = std::min(batchBegin + kProbeBatchSize, positions.size());
+
+        return std::vector<glm::vec3>(positions.begin() + batchBegin, positions.begin() + batchEnd);
+    }
+
+    static Bytes ProjectProbesOnCpu(ProbeRenderer& probeRenderer, const std::vector<glm::vec3>& positions)
+    {
+        EASY_FUNCTION()
+
+        Bytes coefficients(positions.size() * kCoefficientCount * sizeof(glm::vec3));
+
+        const DataAccess<glm::vec3> coefficientsAccess{ ByteAccess(coefficients) };
+
+        const SphericalHarmonicsProjector projector(ProbeRenderer::kProbeExtent.width);
+
+        ProgressLogger progressLogger("GlobalIllumination::GenerateLightVolume", 1.0f);
+
+        float bakeSeconds = 0.0f;
+        float projectionSeconds = 0.0f;
+
+        for (size_t batchBegin = 0; batchBegin < positions.size(); batchBegin += kProbeBatchSize)
+        {
+            const std::vector<glm::vec3> batchPositions = GetBatchPositions(positions, batchBegin);
+
+            float startSeconds = Timer::GetGlobalSeconds();
+
+            const vk::Image probesImage = probeRenderer.CaptureProbes(batchPositions);
+
+            bakeSeconds += Timer::GetGlobalSeconds() - startSeconds;
+
+            startSeconds = Timer::GetGlobalSeconds();
+
+            const Bytes probesData = ImageHelpers::ReadImage(probesImage, vk::ImageLayout::eShaderReadOnlyOptimal);
+
+            VulkanContext::imageManager->DestroyImage(probesImage);
+
+            const DataAccess<glm::vec3> batchCoefficients(coefficientsAccess.data + batchBegin * kCoefficientCount,
+                    batchPositions.size() * kCoefficientCount);
+
+            projector.Project(ByteView(probesData), batchCoefficients);
+
+            projectionSeconds += Timer::GetGlobalSeconds() - startSeconds;
+
+            progressLogger.Log(batchBegin + batchPositions.size(), positions.size());
+        }
+
+        progressLogger.End();
+
+        LogBakeTime(bakeSeconds, positions.size());
+        LogProjectionTime("CPU", projectionSeconds, positions.size());
+
+        return coefficients;
+    }
 }
 
 GlobalIllumination::GlobalIllumination()
@@ -243,20 +545,66 @@ GlobalIllumination::~GlobalIllumination()
     VulkanContext::descriptorPool->DestroyDescriptorSetLayout(coefficientsLayout);
 }
 
+std::optional<LightVolumeComponent> GlobalIllumination::LoadLightVolume(const Scene& scene) const
+{
+    EASY_FUNCTION()
+
+    const size_t sceneHash = Details::CalculateSceneHash(scene);
+    const size_t configHash = Details::CalculateConfigHash();
+
+    const std::optional<LightVolumeData> lightVolumeData = LightVolumeCache::Load(sceneHash, configHash);
+
+    if (!lightVolumeData.has_value())
+    {
+        return std::nullopt;
+    }
+
+    LogI << "Light volume loaded from cache: " << lightVolumeData->positions.size() << " probes\n";
+
+    const TetrahedronGridData gridData = MeshHelpers::GenerateTetrahedronGrid(
+            lightVolumeData->positions, lightVolumeData->tetrahedral);
+
+    return Details::CreateLightVolume(lightVolumeData.value(), gridData);
+}
+
 LightVolumeComponent GlobalIllumination::GenerateLightVolume(const Scene& scene) const
 {
     EASY_FUNCTION()
 
-    const std::unique_ptr<ProbeRenderer> probeRenderer = std::make_unique<ProbeRenderer>(&scene);
+    const std::unique_ptr<ProbeRenderer> probeRenderer
+            = std::make_unique<ProbeRenderer>(&scene, Details::kProbeBatchSize);
 
     const AABBox bbox = Details::GetVolumeBBox(SceneHelpers::CalculateSceneBBox(scene));
-    std::vector<glm::vec3> positions = Details::GenerateLightVolumePositions(&scene, bbox);
-    const auto [tetrahedral, edgeIndices] = MeshHelpers::GenerateTetrahedral(positions);
+    const OcclusionRenderer occlusionRenderer(&scene);
+
+    std::vector<glm::vec3> positions = GlobalIlluminationHelpers::GenerateLightVolumePositions(bbox,
+            [&](const AABBox& cellBBox) { return occlusionRenderer.ContainsGeometry(cellBBox); });
+    auto [tetrahedral, edgeIndices] = MeshHelpers::GenerateTetrahedral(positions);
+
+    Bytes coefficients = Config::kLightVolumeCpuProjection
+            ? Details::ProjectProbesOnCpu(*probeRenderer, positions)
+            : ProjectProbesOnGpu(*probeRenderer, positions);
+
+    Details::LogCoefficientsAverage(coefficients, positions.size());
+
+    const LightVolumeData lightVolumeData{
+        std::move(positions), std::move(tetrahedral), std::move(edgeIndices), std::move(coefficients)
+    };
 
-    const vk::Buffer positionsBuffer = BufferHelpers::CreateBufferWithData(
-            vk::BufferUsageFlagBits::eStorageBuffer, ByteView(positions));
-    const vk::Buffer tetrahedralBuffer = BufferHelpers::CreateBufferWithData(
-            vk::BufferUsageFlagBits::eStorageBuffer, ByteView(tetrahedral));
+    LightVolumeCache::Save(Details::CalculateSceneHash(scene), Details::CalculateConfigHash(), lightVolumeData);
+
+    const TetrahedronGridData gridData = MeshHelpers::GenerateTetrahedronGrid(
+            lightVolumeData.positions, lightVolumeData.tetrahedral);
+
+    Details::LogTetrahedronWalkStatistics(lightVolumeData, gridData);
+
+    return Details::CreateLightVolume(lightVolumeData, gridData);
+}
+
+Bytes GlobalIllumination::ProjectProbesOnGpu(ProbeRenderer& probeRenderer,
+        const std::vector<glm::vec3>& positions) const
+{
+    EASY_FUNCTION()
 
     const uint32_t probeCount = static_cast<uint32_t>(positions.size());
     const vk::Buffer coefficientsBuffer = Details::CreateLightVolumeCoefficientsBuffer(probeCount);
@@ -266,41 +614,140 @@ LightVolumeComponent GlobalIllumination::GenerateLightVolume(const Scene& scene)
 
     ProgressLogger progressLogger("GlobalIllumination::GenerateLightVolume", 1.0f);
 
-    for (size_t i = 0; i < positions.size(); ++i)
+    float bakeSeconds = 0.0f;
+    float projectionSeconds = 0.0f;
+
+    for (size_t batchBegin = 0; batchBegin < positions.size(); batchBegin += Details::kProbeBatchSize)
     {
-        const Texture probeTexture = probeRenderer->CaptureProbe(positions[i]);
+        const std::vector<glm::vec3> batchPositions = Details::GetBatchPositions(positions, batchBegin);
 
-        const vk::DescriptorSet probeDescriptorSet
-                = Details::AllocateProbeDescriptorSet(probeLayout, probeTexture.view);
+        float startSeconds = Timer::GetGlobalSeconds();
 
-        const std::vector<vk::DescriptorSet> descriptorSets{
-            probeDescriptorSet, coefficientsDescriptorSet
-        };
+        const vk::Image probesImage = probeRenderer.CaptureProbes(batchPositions);
 
-        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
-            {
-                EASY_BLOCK("GlobalIllumination::ProcessProbe")
+        bakeSeconds += Timer::GetGlobalSeconds() - startSeconds;
+
+        startSeconds = Timer::GetGlobalSeconds();
 
-                commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, lightVolumePipeline->Get());
+        for (size_t i = 0; i < batchPositions.size(); ++i)
+        {
+            const vk::ImageSubresourceRange probeRange(vk::ImageAspectFlagBits::eColor,
+                    0, 1, static_cast<uint32_t>(i) * ImageHelpers::kCubeFaceCount, ImageHelpers::kCubeFaceCount);
 
-                commandBuffer.pushConstants<uint32_t>(lightVolumePipeline->GetLayout(),
-                        vk::ShaderStageFlagBits::eCompute, 0, { static_cast<uint32_t>(i) });
+            const vk::ImageView probeView = VulkanContext::imageManager->CreateView(
+                    probesImage, vk::ImageViewType::eCube, probeRange);
 
-                commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
-                        lightVolumePipeline->GetLayout(), 0, descriptorSets, {});
+            const vk::DescriptorSet probeDescriptorSet
+                    = Details::AllocateProbeDescriptorSet(probeLayout, probeView);
 
-                commandBuffer.dispatch(1, 1, 1);
-            });
+            const std::vector<vk::DescriptorSet> descriptorSets{
+                probeDescriptorSet, coefficientsDescriptorSet
+            };
+
+            const uint32_t probeIndex = static_cast<uint32_t>(batchBegin + i);
+
+            VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+                {
+                    EASY_BLOCK("GlobalIllumination::ProcessProbe")
+
+                    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, lightVolumePipeline->Get());
+
+                    commandBuffer.pushConstants<uint32_t>(lightVolumePipeline->GetLayout(),
+                            vk::ShaderStageFlagBits::eCompute, 0, { probeIndex });
+
+                    commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                            lightVolumePipeline->GetLayout(), 0, descriptorSets, {});
+
+                    commandBuffer.dispatch(1, 1, 1);
+                });
+
+            VulkanContext::descriptorPool->FreeDescriptorSets({ probeDescriptorSet });
+        }
+
+        VulkanContext::imageManager->DestroyImage(probesImage);
 
-        VulkanContext::descriptorPool->FreeDescriptorSets({ probeDescriptorSet });
-        VulkanContext::textureManager->DestroyTexture(probeTexture);
+        projectionSeconds += Timer::GetGlobalSeconds() - startSeconds;
 
-        progressLogger.Log(i, positions.size());
+        progressLogger.Log(batchBegin + batchPositions.size(), positions.size());
     }
 
     progressLogger.End();
 
-    return LightVolumeComponent{
-        positionsBuffer, tetrahedralBuffer, coefficientsBuffer, positions, edgeIndices
-    };
+    Details::LogBakeTime(bakeSeconds, positions.size());
+    Details::LogProjectionTime("GPU", projectionSeconds, positions.size());
+
+    Bytes coefficients = Details::ReadCoefficients(coefficientsBuffer);
+
+    VulkanContext::descriptorPool->FreeDescriptorSets({ coefficientsDescriptorSet });
+    VulkanContext::bufferManager->DestroyBuffer(coefficientsBuffer);
+
+    return coefficients;
+}
+
+std::vector<glm::vec3> GlobalIlluminationHelpers::GenerateLightVolumePositions(
+        const AABBox& volumeBBox, const std::function<bool(const AABBox&)>& geometryPredicate)
+{
+    EASY_FUNCTION()
+
+    std::vector<Details::BBoxInfo> bboxesInfo;
+    for (const AABBox& bbox : Details::SplitBBox(volumeBBox))
+    {
+        const std::vector<Details::BBoxInfo> subtreeBBoxesInfo = Details::ProcessBBox(geometryPredicate, bbox);
+
+        bboxesInfo.insert(bboxesInfo.end(), subtreeBBoxesInfo.begin(), subtreeBBoxesInfo.end());
+    }
+
+    const float deduplicationStartSeconds = Timer::GetGlobalSeconds();
+
+    std::vector<Details::GridKey> cornerKeys(bboxesInfo.size() * 8);
+
+    JobSystem::ParallelFor(static_cast<uint32_t>(bboxesInfo.size()), [&](uint32_t i)
+        {
+            const std::array<glm::vec3, 8> corners = bboxesInfo[i].bbox.GetCorners();
+
+            for (size_t j = 0; j < corners.size(); ++j)
+            {
+                cornerKeys[i * 8 + j] = Details::GetGridKey(corners[j]);
+            }
+        });
+
+    std::vector<Details::PositionInfo> positionsInfo;
+    positionsInfo.reserve(bboxesInfo.size());
+
+    std::unordered_map<Details::GridKey, size_t, Details::GridKeyHash> positionIndices;
+    positionIndices.reserve(bboxesInfo.size());
+
+    for (size_t i = 0; i < cornerKeys.size(); ++i)
+    {
+        const bool containsGeometry = bboxesInfo[i / 8].containsGeometry;
+
+        const auto [it, inserted] = positionIndices.emplace(cornerKeys[i], positionsInfo.size());
+
+        if (inserted)
+        {
+            const glm::vec3 position = Details::GetGridPosition(cornerKeys[i]);
+
+            positionsInfo.push_back(Details::PositionInfo{ position, containsGeometry });
+        }
+        else
+        {
+            positionsInfo[it->second].containsGeometry |= containsGeometry;
+        }
+    }
+
+    const float deduplicationSeconds = Timer::GetGlobalSeconds() - deduplicationStartSeconds;
+
+    LogI << "Light volume positions: " << cornerKeys.size() << " cell corners deduplicated to "
+            << positionsInfo.size() << " positions in " << deduplicationSeconds * 1000.0f << " ms\n";
+
+    std::vector<glm::vec3> positions;
+    for (const auto& [position, containsGeometry] : positionsInfo)
+    {
+        if (containsGeometry)
+        {
+            positions.push_back(position);
+        }
+    }
+
+    return positions;
 }
@@ -7,6 +7,7 @@
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Render/Vulkan/ComputePipeline.hpp"
 #include "Engine/Render/Vulkan/VulkanConfig.hpp"
+#include "Engine/Scene/EnvironmentCache.hpp"
 
 #include "Utils/TimeHelpers.hpp"
 
@@ -151,7 +152,8 @@ namespace Details
 
         VulkanContext::shaderManager->DestroyShaderModule(shaderModule);
 
-        const vk::ImageUsageFlags imageUsage = vk::ImageUsageFlagBits::eTransferDst
+        const vk::ImageUsageFlags imageUsage = vk::ImageUsageFlagBits::eTransferSrc
+                | vk::ImageUsageFlagBits::eTransferDst
                 | vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
 
         const ImageDescription imageDescription{
@@ -217,11 +219,40 @@ namespace Details
 
         descriptorPool.FreeDescriptorSets({ descriptorSet });
 
-        VulkanHelpers::SetObjectName(VulkanContext::device->Get(), image, "SpecularBRDF");
-
         return Texture{ image, view };
     }
 
+    static Texture LoadSpecularBRDF(vk::DescriptorSetLayout targetLayout, size_t configHash)
+    {
+        EASY_FUNCTION()
+
+        Texture specularBRDF;
+
+        if constexpr (Config::kEnvironmentCacheEnabled)
+        {
+            const std::optional<Texture> cachedSpecularBRDF = EnvironmentCache::LoadSpecularBRDF(configHash);
+
+            if (cachedSpecularBRDF.has_value())
+            {
+                specularBRDF = cachedSpecularBRDF.value();
+            }
+            else
+            {
+                specularBRDF = CreateSpecularBRDF(targetLayout);
+
+                EnvironmentCache::SaveSpecularBRDF(configHash, specularBRDF);
+            }
+        }
+        else
+        {
+            specularBRDF = CreateSpecularBRDF(targetLayout);
+        }
+
+        VulkanHelpers::SetObjectName(VulkanContext::device->Get(), specularBRDF.image, "SpecularBRDF");
+
+        return specularBRDF;
+    }
+
     static const vk::Extent2D& GetIrradianceExtent(const vk::Extent2D& cubemapExtent)
     {
         if (cubemapExtent.width <= kMaxIrradianceExtent.width)
@@ -244,7 +275,8 @@ namespace Details
 
     static vk::Image CreateIrradianceImage(vk::Format format, const vk::Extent2D& extent)
     {
-        constexpr vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
+        constexpr vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eStorage
+                | vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferSrc;
 
         const ImageDescription imageDescription{
             ImageType::eCube, format,
@@ -260,7 +292,8 @@ namespace Details
 
     static vk::Image CreateReflectionImage(vk::Format format, const vk::Extent2D& extent)
     {
-        constexpr vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
+        constexpr vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eStorage
+                | vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferSrc;
 
         const ImageDescription imageDescription{
             ImageType::eCube, format,
@@ -315,7 +348,7 @@ ImageBasedLighting::ImageBasedLighting()
     irradiancePipeline = Details::CreateIrradiancePipeline({ cubemapLayout, targetLayout });
     reflectionPipeline = Details::CreateReflectionPipeline({ cubemapLayout, targetLayout });
 
-    specularBRDF = Details::CreateSpecularBRDF(targetLayout);
+    specularBRDF = Details::LoadSpecularBRDF(targetLayout, GetConfigHash());
 
     samplers = Details::CreateSamplers();
 }
@@ -332,6 +365,21 @@ ImageBasedLighting::~ImageBasedLighting()
     VulkanContext::textureManager->DestroySampler(samplers.reflection);
 }
 
+size_t ImageBasedLighting::GetConfigHash() const
+{
+    size_t hash = 0;
+
+    CombineHash(hash, Details::kSpecularBRDFExtent.width);
+    CombineHash(hash, Details::kSpecularBRDFExtent.height);
+    CombineHash(hash, Details::kMaxIrradianceExtent.width);
+    CombineHash(hash, Details::kMaxIrradianceExtent.height);
+    CombineHash(hash, Details::kMaxReflectionExtent.width);
+    CombineHash(hash, Details::kMaxReflectionExtent.height);
+    CombineHash(hash, Config::kMaxEnvironmentLuminance);
+
+    return hash;
+}
+
 Texture ImageBasedLighting::GenerateIrradianceTexture(const Texture& cubemapTexture) const
 {
     EASY_FUNCTION()
@@ -350,34 +398,33 @@ Texture ImageBasedLighting::GenerateIrradianceTexture(const Texture& cubemapText
     const std::vector<vk::DescriptorSet> irradianceFacesDescriptorSets
             = Details::AllocateCubeFacesDescriptorSets(targetLayout, irradianceFacesViews);
 
-    for (uint32_t faceIndex = 0; faceIndex < ImageHelpers::kCubeFaceCount; ++faceIndex)
-    {
-        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
             {
-                if (faceIndex == 0)
-                {
-                    const ImageLayoutTransition layoutTransition{
-                        vk::ImageLayout::eUndefined,
-                        vk::ImageLayout::eGeneral,
-                        PipelineBarrier{
-                            SyncScope::kWaitForNone,
-                            SyncScope::kComputeShaderWrite
-                        }
-                    };
+                const ImageLayoutTransition layoutTransition{
+                    vk::ImageLayout::eUndefined,
+                    vk::ImageLayout::eGeneral,
+                    PipelineBarrier{
+                        SyncScope::kWaitForNone,
+                        SyncScope::kComputeShaderWrite
+                    }
+                };
 
-                    ImageHelpers::TransitImageLayout(commandBuffer, irradianceImage,
-                            ImageHelpers::kCubeColor, layoutTransition);
-                }
+                ImageHelpers::TransitImageLayout(commandBuffer, irradianceImage,
+                        ImageHelpers::kCubeColor, layoutTransition);
+            }
+
+            const glm::uvec3 groupCount = PipelineHelpers::CalculateWorkGroupCount(
+                    irradianceExtent, Details::kWorkGroupSize);
 
+            commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, irradiancePipeline->Get());
+
+            for (uint32_t faceIndex = 0; faceIndex < ImageHelpers::kCubeFaceCount; ++faceIndex)
+            {
                 const std::vector<vk::DescriptorSet> descriptorSets{
                     cubemapDescriptorSet, irradianceFacesDescriptorSets[faceIndex]
                 };
 
-                const glm::uvec3 groupCount = PipelineHelpers::CalculateWorkGroupCount(
-                        irradianceExtent, Details::kWorkGroupSize);
-
-                commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, irradiancePipeline->Get());
-
                 commandBuffer.pushConstants<uint32_t>(irradiancePipeline->GetLayout(),
                         vk::ShaderStageFlagBits::eCompute, 0, { faceIndex });
 
@@ -385,23 +432,22 @@ Texture ImageBasedLighting::GenerateIrradianceTexture(const Texture& cubemapText
                         irradiancePipeline->GetLayout(), 0, { descriptorSets }, {});
 
                 commandBuffer.dispatch(groupCount.x, groupCount.y, groupCount.z);
+            }
 
-                if (faceIndex == ImageHelpers::kCubeFaceCount - 1)
-                {
-                    const ImageLayoutTransition layoutTransition{
-                        vk::ImageLayout::eGeneral,
-                        vk::ImageLayout::eShaderReadOnlyOptimal,
-                        PipelineBarrier{
-                            SyncScope::kComputeShaderWrite,
-                            SyncScope::kBlockNone
-                        }
-                    };
+            {
+                const ImageLayoutTransition layoutTransition{
+                    vk::ImageLayout::eGeneral,
+                    vk::ImageLayout::eShaderReadOnlyOptimal,
+                    PipelineBarrier{
+                        SyncScope::kComputeShaderWrite,
+                        SyncScope::kBlockNone
+                    }
+                };
 
-                    ImageHelpers::TransitImageLayout(commandBuffer, irradianceImage,
-                            ImageHelpers::kCubeColor, layoutTransition);
-                }
-            });
-    }
+                ImageHelpers::TransitImageLayout(commandBuffer, irradianceImage,
+                        ImageHelpers::kCubeColor, layoutTransition);
+            }
+        });
 
     VulkanContext::descriptorPool->FreeDescriptorSets({ cubemapDescriptorSet });
     VulkanContext::descriptorPool->FreeDescriptorSets(irradianceFacesDescriptorSets);
@@ -453,30 +499,29 @@ Texture ImageBasedLighting::GenerateReflectionTexture(const Texture& cubemapText
             0, reflectionMipLevelCount,
             0, ImageHelpers::kCubeFaceCount);
 
-    for (uint32_t faceIndex = 0; faceIndex < ImageHelpers::kCubeFaceCount; ++faceIndex)
-    {
-        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+    VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+        {
             {
-                if (faceIndex == 0)
-                {
-                    const ImageLayoutTransition layoutTransition{
-                        vk::ImageLayout::eUndefined,
-                        vk::ImageLayout::eGeneral,
-                        PipelineBarrier{
-                            SyncScope::kWaitForNone,
-                            SyncScope::kComputeShaderWrite
-                        }
-                    };
+                const ImageLayoutTransition layoutTransition{
+                    vk::ImageLayout::eUndefined,
+                    vk::ImageLayout::eGeneral,
+                    PipelineBarrier{
+                        SyncScope::kWaitForNone,
+                        SyncScope::kComputeShaderWrite
+                    }
+                };
 
-                    ImageHelpers::TransitImageLayout(commandBuffer, reflectionImage,
-                            reflectionSubresourceRange, layoutTransition);
-                }
+                ImageHelpers::TransitImageLayout(commandBuffer, reflectionImage,
+                        reflectionSubresourceRange, layoutTransition);
+            }
 
-                commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, reflectionPipeline->Get());
+            commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, reflectionPipeline->Get());
 
-                commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
-                        reflectionPipeline->GetLayout(), 0, { cubemapDescriptorSet }, {});
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+                    reflectionPipeline->GetLayout(), 0, { cubemapDescriptorSet }, {});
 
+            for (uint32_t faceIndex = 0; faceIndex < ImageHelpers::kCubeFaceCount; ++faceIndex)
+            {
                 for (uint32_t mipLevel = 0; mipLevel < reflectionMipLevelCount; ++mipLevel)
                 {
                     const vk::Extent2D mipLevelExtent
@@ -501,23 +546,22 @@ Texture ImageBasedLighting::GenerateReflectionTexture(const Texture& cubemapText
 
                     commandBuffer.dispatch(groupCount.x, groupCount.y, groupCount.z);
                 }
+            }
 
-                if (faceIndex == ImageHelpers::kCubeFaceCount - 1)
-                {
-                    const ImageLayoutTransition layoutTransition{
-                        vk::ImageLayout::eGeneral,
-                        vk::ImageLayout::eShaderReadOnlyOptimal,
-                        PipelineBarrier{
-                            SyncScope::kComputeShaderWrite,
-                            SyncScope::kBlockNone
-                        }
-                    };
+            {
+                const ImageLayoutTransition layoutTransition{
+                    vk::ImageLayout::eGeneral,
+                    vk::ImageLayout::eShaderReadOnlyOptimal,
+                    PipelineBarrier{
+                        SyncScope::kComputeShaderWrite,
+                        SyncScope::kBlockNone
+                    }
+                };
 
-                    ImageHelpers::TransitImageLayout(commandBuffer, reflectionImage,
-                            reflectionSubresourceRange, layoutTransition);
-                }
-            });
-    }
+                ImageHelpers::TransitImageLayout(commandBuffer, reflectionImage,
+                        reflectionSubresourceRange, layoutTransition);
+            }
+        });
 
     VulkanContext::descriptorPool->FreeDescriptorSets({ cubemapDescriptorSet });
     for (const auto& reflectionFacesDescriptorSets : reflectionMipLevelsFacesDescriptorSets)
@@ -0,0 +1,106 @@
+#include "Engine/Scene/LightVolumeCache.hpp"
+
+#include "Engine/Filesystem/Filesystem.hpp"
+#include "Engine/Config.hpp"
+
+#include "Utils/Serialization.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kMagic = 0x4C564C53; // "SLVL"
+
+    static constexpr uint32_t kVersion = 1;
+
+    struct Header
+    {
+        uint32_t magic = kMagic;
+        uint32_t version = kVersion;
+        uint32_t tetrahedronSize = sizeof(gpu::Tetrahedron);
+        uint32_t coefficientCount = COEFFICIENT_COUNT;
+        uint64_t sceneHash = 0;
+        uint64_t configHash = 0;
+    };
+
+    static Filepath GetCachePath(size_t sceneHash)
+    {
+        const std::string filename = Format("%016zx.lightvolume", sceneHash);
+
+        return Filepath(Config::kCacheDirectory.GetAbsolute() + "LightVolumes/" + filename);
+    }
+
+    static bool IsHeaderValid(const Header& header, const Header& expectedHeader)
+    {
+        return header.magic == expectedHeader.magic
+                && header.version == expectedHeader.version
+                && header.tetrahedronSize == expectedHeader.tetrahedronSize
+                && header.coefficientCount == expectedHeader.coefficientCount
+                && header.sceneHash == expectedHeader.sceneHash
+                && header.configHash == expectedHeader.configHash;
+    }
+}
+
+std::optional<LightVolumeData> LightVolumeCache::Load(size_t sceneHash, size_t configHash)
+{
+    EASY_FUNCTION()
+
+    const Filepath cachePath = Details::GetCachePath(sceneHash);
+
+    if (!cachePath.Exists())
+    {
+        return std::nullopt;
+    }
+
+    const Bytes bytes = Filesystem::ReadBinaryFile(cachePath);
+
+    BinaryReader reader{ ByteView(bytes) };
+
+    Details::Header expectedHeader;
+    expectedHeader.sceneHash = sceneHash;
+    expectedHeader.configHash = configHash;
+
+    Details::Header header;
+    reader.Read(header);
+
+    if (!reader.IsValid() || !Details::IsHeaderValid(header, expectedHeader))
+    {
+        return std::nullopt;
+    }
+
+    LightVolumeData lightVolumeData;
+
+    reader.Read(lightVolumeData.positions);
+    reader.Read(lightVolumeData.tetrahedral);
+    reader.Read(lightVolumeData.edgeIndices);
+    reader.Read(lightVolumeData.coefficients);
+
+    const size_t expectedCoefficientsSize
+            = lightVolumeData.positions.size() * COEFFICIENT_COUNT * sizeof(glm::vec3);
+
+    if (!reader.IsValid() || !reader.IsEnd() || lightVolumeData.coefficients.size() != expectedCoefficientsSize)
+    {
+        LogW << "Corrupted light volume cache: " << cachePath.GetAbsolute() << "\n";
+        return std::nullopt;
+    }
+
+    return lightVolumeData;
+}
+
+void LightVolumeCache::Save(size_t sceneHash, size_t configHash, const LightVolumeData& lightVolumeData)
+{
+    EASY_FUNCTION()
+
+    Details::Header header;
+    header.sceneHash = sceneHash;
+    header.configHash = configHash;
+
+    BinaryWriter writer;
+
+    writer.Write(header);
+    writer.Write(lightVolumeData.positions);
+    writer.Write(lightVolumeData.tetrahedral);
+    writer.Write(lightVolumeData.edgeIndices);
+    writer.Write(lightVolumeData.coefficients);
+
+    Filesystem::WriteBinaryFile(Details::GetCachePath(sceneHash), ByteView(writer.GetBytes()));
+}
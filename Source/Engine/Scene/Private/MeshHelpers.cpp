@@ -2,6 +2,7 @@
 
 #include "Engine/Scene/MeshHelpers.hpp"
 
+#include "Utils/AABBox.hpp"
 #include "Utils/Assert.hpp"
 #include "Utils/Helpers.hpp"
 
@@ -13,6 +14,10 @@ namespace Details
     static constexpr size_t kTetrahedronVertexCount = 4;
     static constexpr size_t kTriangleVertexCount = 3;
 
+    static constexpr int32_t kMaxTetrahedronGridSize = 64;
+
+    static constexpr float kMinTetrahedronGridCellSize = 0.01f;
+
     using TetrahedronVertices = std::array<glm::vec3, kTetrahedronVertexCount>;
     using TetrahedronFaceIndices = std::array<size_t, kTriangleVertexCount>;
 
@@ -51,6 +56,46 @@ namespace Details
 
         return oppositeFaceIndices;
     }
+
+    static glm::vec4 GetBaryCoord(const std::vector<glm::vec3>& vertices,
+            const gpu::Tetrahedron& tetrahedron, const glm::vec3& position)
+    {
+        const glm::vec3 delta = position - vertices[tetrahedron.vertices[3]];
+
+        const glm::vec3 baryCoord = delta * glm::mat3(tetrahedron.matrix);
+
+        return glm::vec4(baryCoord, 1.0f - baryCoord.x - baryCoord.y - baryCoord.z);
+    }
+
+    static int32_t FindMostNegative(const glm::vec4& baryCoord)
+    {
+        int32_t index = -1;
+        float value = 0.0f;
+
+        for (int32_t i = 0; i < TET_VERTEX_COUNT; ++i)
+        {
+            if (baryCoord[i] < value)
+            {
+                index = i;
+                value = baryCoord[i];
+            }
+        }
+
+        return index;
+    }
+
+    // Cell size is chosen to get about one cell per vertex
+    static glm::ivec3 CalculateTetrahedronGridSize(const glm::vec3& extent, size_t vertexCount)
+    {
+        const float volume = extent.x * extent.y * extent.z;
+
+        const float cellSize = std::max(std::cbrt(volume / static_cast<float>(vertexCount)),
+                kMinTetrahedronGridCellSize);
+
+        const glm::ivec3 size = glm::ivec3(glm::ceil(extent / cellSize));
+
+        return glm::clamp(size, glm::ivec3(1), glm::ivec3(kMaxTetrahedronGridSize));
+    }
 }
 
 Mesh MeshHelpers::GenerateSphere(float radius, uint32_t sectorCount, uint32_t stackCount)
@@ -166,3 +211,108 @@ TetrahedralData MeshHelpers::GenerateTetrahedral(const std::vector<glm::vec3>& v
 
     return TetrahedralData{ tetrahedral, edgesIndices };
 }
+
+TetrahedronGridData MeshHelpers::GenerateTetrahedronGrid(const std::vector<glm::vec3>& vertices,
+        const std::vector<gpu::Tetrahedron>& tetrahedral)
+{
+    EASY_FUNCTION()
+
+    TetrahedronGridData gridData{};
+
+    if (tetrahedral.empty())
+    {
+        gridData.grid.size = glm::ivec4(1, 1, 1, 0);
+        gridData.cells = { 0 };
+
+        return gridData;
+    }
+
+    AABBox bbox;
+    for (const glm::vec3& vertex : vertices)
+    {
+        bbox.Add(vertex);
+    }
+
+    const glm::vec3 extent = glm::max(bbox.GetSize(), glm::vec3(Details::kMinTetrahedronGridCellSize));
+    const glm::ivec3 size = Details::CalculateTetrahedronGridSize(extent, vertices.size());
+    const glm::vec3 cellSize = extent / glm::vec3(size);
+
+    gridData.grid.origin = glm::vec4(bbox.GetMin(), 0.0f);
+    gridData.grid.inverseCellSize = glm::vec4(1.0f / cellSize, 0.0f);
+    gridData.grid.size = glm::ivec4(size, 0);
+
+    gridData.cells.resize(size.x * size.y * size.z);
+
+    // Neighboring cells are processed one after another, so each walk starts close to its target
+    int32_t tetrahedron = 0;
+
+    for (int32_t z = 0; z < size.z; ++z)
+    {
+        for (int32_t y = 0; y < size.y; ++y)
+        {
+            for (int32_t x = 0; x < size.x; ++x)
+            {
+                const glm::vec3 cellCenter = bbox.GetMin() + (glm::vec3(x, y, z) + 0.5f) * cellSize;
+
+                tetrahedron = FindTetrahedron(vertices, tetrahedral, cellCenter, tetrahedron).tetrahedron;
+
+                gridData.cells[(z * size.y + y) * size.x + x] = tetrahedron;
+            }
+        }
+    }
+
+    return gridData;
+}
+
+int32_t MeshHelpers::GetStartTetrahedron(const TetrahedronGridData& gridData, const glm::vec3& position)
+{
+    const gpu::TetrahedronGrid& grid = gridData.grid;
+
+    const glm::vec3 cellCoord = (position - glm::vec3(grid.origin)) * glm::vec3(grid.inverseCellSize);
+
+    const glm::ivec3 cell = glm::clamp(glm::ivec3(glm::floor(cellCoord)),
+            glm::ivec3(0), glm::ivec3(grid.size) - 1);
+
+    return gridData.cells[(cell.z * grid.size.y + cell.y) * grid.size.x + cell.x];
+}
+
+TetrahedronWalk MeshHelpers::FindTetrahedron(const std::vector<glm::vec3>& vertices,
+        const std::vector<gpu::Tetrahedron>& tetrahedral, const glm::vec3& position, int32_t startTetrahedron)
+{
+    TetrahedronWalk walk;
+    walk.tetrahedron = startTetrahedron;
+
+    int32_t prevTetrahedron = startTetrahedron;
+
+    while (walk.stepCount < tetrahedral.size())
+    {
+        const gpu::Tetrahedron& tetrahedron = tetrahedral[walk.tetrahedron];
+
+        const int32_t coordIndex = Details::FindMostNegative(Details::GetBaryCoord(vertices, tetrahedron, position));
+
+        if (coordIndex < 0)
+        {
+            break;
+        }
+
+        const int32_t nextTetrahedron = tetrahedron.neighbors[coordIndex];
+
+        if (nextTetrahedron == prevTetrahedron)
+        {
+            break;
+        }
+
+        if (nextTetrahedron < 0)
+        {
+            walk.outside = true;
+            break;
+        }
+
+        prevTetrahedron = walk.tetrahedron;
+        walk.tetrahedron = nextTetrahedron;
+
+        ++walk.stepCount;
+    }
+
+    return walk;
+}
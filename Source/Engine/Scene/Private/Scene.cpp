@@ -1,17 +1,68 @@
 #include "Engine/Scene/Scene.hpp"
 
+#include "Engine/CommandLine.hpp"
 #include "Engine/Render/RenderContext.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
+#include "Engine/Render/Vulkan/RayTracing/DynamicTlas.hpp"
 #include "Engine/Scene/StorageComponents.hpp"
 #include "Engine/Scene/Components.hpp"
 #include "Engine/Scene/Environment.hpp"
 #include "Engine/Scene/GlobalIllumination.hpp"
 #include "Engine/Scene/Material.hpp"
 #include "Engine/Scene/Primitive.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
 #include "Engine/Scene/SceneLoader.hpp"
+#include "Engine/Scene/TransformHierarchy.hpp"
+
+#include "Utils/Logger.hpp"
+#include "Utils/TimeHelpers.hpp"
 
 namespace Details
 {
+    void MarkTransformDirty(entt::registry& registry, entt::entity entity)
+    {
+        registry.get<TransformComponent>(entity).dirty = true;
+    }
+
+    void MarkRenderObjectsDirty(entt::registry& registry, entt::entity)
+    {
+        if (SceneBVH* sceneBVH = registry.ctx().find<SceneBVH>())
+        {
+            sceneBVH->MarkTopologyDirty();
+        }
+    }
+
+    void UpdateTransformHierarchy(Scene& scene)
+    {
+        EASY_FUNCTION()
+
+        const float startSeconds = Timer::GetGlobalSeconds();
+
+        const TransformHierarchy* previousHierarchy = scene.ctx().find<TransformHierarchy>();
+
+        const uint32_t version = previousHierarchy ? previousHierarchy->GetVersion() : 0;
+
+        TransformHierarchy& transformHierarchy = scene.ctx().insert_or_assign(TransformHierarchy(scene, version));
+
+        const uint32_t updatedCount = transformHierarchy.Update(scene);
+
+        const float updateSeconds = Timer::GetGlobalSeconds() - startSeconds;
+
+        LogI << "Transform hierarchy updated: " << updatedCount << " transforms, depth "
+                << transformHierarchy.GetDepth() << " in " << updateSeconds / Numbers::kMili << " ms\n";
+    }
+
+    void InitializeScene(Scene& scene)
+    {
+        UpdateTransformHierarchy(scene);
+
+        scene.on_update<TransformComponent>().connect<&MarkTransformDirty>();
+
+        scene.on_construct<RenderComponent>().connect<&MarkRenderObjectsDirty>();
+        scene.on_update<RenderComponent>().connect<&MarkRenderObjectsDirty>();
+        scene.on_destroy<RenderComponent>().connect<&MarkRenderObjectsDirty>();
+    }
+
     void AddTextureOffset(Material& material, int32_t offset)
     {
         if (material.data.baseColorTexture >= 0)
@@ -69,40 +120,168 @@ namespace Details
                 vk::BufferUsageFlagBits::eUniformBuffer, ByteView(materialData));
     }
 
-    vk::AccelerationStructureKHR GenerateTlas(const Scene& scene)
+    // Instances follow the scene BVH item order, so that they can be updated by item index
+    std::vector<TlasInstanceData> CollectTlasInstances(const Scene& scene)
     {
         EASY_FUNCTION()
 
         const auto& rtsc = scene.ctx().get<RayTracingStorageComponent>();
         const auto& msc = scene.ctx().get<MaterialStorageComponent>();
 
+        const std::vector<SceneBVH::Item>& items = scene.ctx().get<SceneBVH>().GetItems();
+
+        // Custom index is limited to 24 bits
+        Assert(items.size() <= static_cast<size_t>(1 << 24));
+
         std::vector<TlasInstanceData> instances;
-        for (auto&& [entity, tc, rc] : scene.view<TransformComponent, RenderComponent>().each())
+        instances.reserve(items.size());
+
+        for (const SceneBVH::Item& item : items)
         {
-            for (const auto& ro : rc.renderObjects)
-            {
-                Assert(ro.primitive <= static_cast<uint32_t>(std::numeric_limits<uint16_t>::max()));
-                Assert(ro.material <= static_cast<uint32_t>(std::numeric_limits<uint8_t>::max()));
+            const auto& tc = scene.get<TransformComponent>(item.entity);
+            const auto& ro = scene.get<RenderComponent>(item.entity).renderObjects[item.renderObject];
 
-                const Material& material = msc.materials[ro.material];
+            const Material& material = msc.materials[ro.material];
 
-                const vk::AccelerationStructureKHR blas = rtsc.blases[ro.primitive];
+            const vk::AccelerationStructureKHR blas = rtsc.blases[ro.primitive];
 
-                const vk::GeometryInstanceFlagsKHR flags = MaterialHelpers::GetTlasInstanceFlags(material.flags);
+            const vk::GeometryInstanceFlagsKHR flags = MaterialHelpers::GetTlasInstanceFlags(material.flags);
 
-                TlasInstanceData instance;
-                instance.blas = blas;
-                instance.transform = tc.worldTransform.GetMatrix();
-                instance.customIndex = ro.primitive | (ro.material << 16);
-                instance.mask = 0xFF;
-                instance.sbtRecordOffset = 0;
-                instance.flags = flags;
+            TlasInstanceData instance;
+            instance.blas = blas;
+            instance.transform = tc.worldTransform.GetMatrix();
+            instance.customIndex = static_cast<uint32_t>(instances.size());
+            instance.mask = 0xFF;
+            instance.sbtRecordOffset = 0;
+            instance.flags = flags;
 
-                instances.push_back(instance);
-            }
+            instances.push_back(instance);
+        }
+
+        return instances;
+    }
+
+    // Instance custom index points to the element describing its primitive and material
+    vk::Buffer CreateInstanceBuffer(const Scene& scene)
+    {
+        EASY_FUNCTION()
+
+        const auto& msc = scene.ctx().get<MaterialStorageComponent>();
+
+        const std::vector<SceneBVH::Item>& items = scene.ctx().get<SceneBVH>().GetItems();
+
+        std::vector<gpu::InstanceRT> instances;
+        instances.reserve(items.size());
+
+        uint32_t maxPrimitive = 0;
+        uint32_t maxMaterial = 0;
+
+        for (const SceneBVH::Item& item : items)
+        {
+            const auto& ro = scene.get<RenderComponent>(item.entity).renderObjects[item.renderObject];
+
+            gpu::InstanceRT instance{};
+            instance.primitive = ro.primitive;
+            instance.material = ro.material;
+            instance.flags = static_cast<uint32_t>(msc.materials[ro.material].flags);
+
+            instances.push_back(instance);
+
+            maxPrimitive = std::max(maxPrimitive, ro.primitive);
+            maxMaterial = std::max(maxMaterial, ro.material);
+        }
+
+        LogI << "Ray tracing instances: " << instances.size() << " instances, max primitive " << maxPrimitive
+                << ", max material " << maxMaterial << ", " << instances.size() * sizeof(gpu::InstanceRT)
+                << " bytes\n";
+
+        if (instances.empty())
+        {
+            instances.emplace_back();
+        }
+
+        return BufferHelpers::CreateBufferWithData(
+                vk::BufferUsageFlagBits::eStorageBuffer, ByteView(instances));
+    }
+
+    MergedGeometryStorageComponent MergeGeometry(Scene& scene)
+    {
+        EASY_FUNCTION()
+
+        auto& gsc = scene.ctx().get<GeometryStorageComponent>();
+
+        MergedGeometryStorageComponent mgsc;
+        mgsc.ranges.reserve(gsc.primitives.size());
+
+        uint32_t indexCount = 0;
+        uint32_t vertexCount = 0;
+
+        for (const Primitive& primitive : gsc.primitives)
+        {
+            Assert(primitive.indexType == vk::IndexType::eUint32);
+
+            mgsc.ranges.push_back({ indexCount, static_cast<int32_t>(vertexCount) });
+
+            indexCount += primitive.indexCount;
+            vertexCount += primitive.vertexCount;
+        }
+
+        mgsc.indexBuffer = VulkanContext::bufferPool->Allocate(indexCount * sizeof(uint32_t));
+        mgsc.vertexBuffer = VulkanContext::bufferPool->Allocate(vertexCount * sizeof(Primitive::Vertex));
+
+        VulkanContext::device->ExecuteOneTimeCommands([&](vk::CommandBuffer commandBuffer)
+            {
+                for (size_t i = 0; i < gsc.primitives.size(); ++i)
+                {
+                    const Primitive& primitive = gsc.primitives[i];
+                    const MergedGeometryStorageComponent::Range& range = mgsc.ranges[i];
+
+                    const vk::BufferCopy indexRegion(primitive.indexBuffer.offset,
+                            mgsc.indexBuffer.offset + range.firstIndex * sizeof(uint32_t),
+                            primitive.indexCount * sizeof(uint32_t));
+
+                    const vk::BufferCopy vertexRegion(primitive.vertexBuffer.offset,
+                            mgsc.vertexBuffer.offset
+                            + static_cast<vk::DeviceSize>(range.vertexOffset) * sizeof(Primitive::Vertex),
+                            primitive.vertexCount * sizeof(Primitive::Vertex));
+
+                    commandBuffer.copyBuffer(primitive.indexBuffer.buffer, mgsc.indexBuffer.buffer, { indexRegion });
+                    commandBuffer.copyBuffer(primitive.vertexBuffer.buffer, mgsc.vertexBuffer.buffer, { vertexRegion });
+                }
+
+                const PipelineBarrier barrier{
+                    SyncScope::kTransferWrite,
+                    SyncScope::kIndicesRead | SyncScope::kVerticesRead
+                };
+
+                VulkanHelpers::InsertMemoryBarrier(commandBuffer, barrier);
+            });
+
+        for (size_t i = 0; i < gsc.primitives.size(); ++i)
+        {
+            Primitive& primitive = gsc.primitives[i];
+            const MergedGeometryStorageComponent::Range& range = mgsc.ranges[i];
+
+            VulkanContext::bufferPool->Free(primitive.indexBuffer);
+            VulkanContext::bufferPool->Free(primitive.vertexBuffer);
+
+            primitive.indexBuffer = BufferSlice{
+                mgsc.indexBuffer.buffer,
+                mgsc.indexBuffer.offset + range.firstIndex * sizeof(uint32_t),
+                primitive.indexCount * sizeof(uint32_t)
+            };
+
+            primitive.vertexBuffer = BufferSlice{
+                mgsc.vertexBuffer.buffer,
+                mgsc.vertexBuffer.offset + static_cast<vk::DeviceSize>(range.vertexOffset) * sizeof(Primitive::Vertex),
+                primitive.vertexCount * sizeof(Primitive::Vertex)
+            };
         }
 
-        return VulkanContext::accelerationStructureManager->GenerateTlas(instances);
+        LogI << "Merged geometry: " << gsc.primitives.size() << " primitives, "
+                << indexCount << " indices, " << vertexCount << " vertices\n";
+
+        return mgsc;
     }
 
     CameraComponent CreateDefaultCamera()
@@ -165,11 +344,6 @@ public:
             }
         }
 
-        for (const auto& [srcEntity, dstEntity] : entities)
-        {
-            ComponentHelpers::AccumulateTransform(dstScene, dstEntity);
-        }
-
         MergeTextureStorageComponents();
 
         MergeMaterialStorageComponents();
@@ -316,6 +490,15 @@ private:
 Scene::Scene(const Filepath& path)
 {
     SceneHelpers::LoadScene(*this, path);
+
+    Details::InitializeScene(*this);
+}
+
+Scene::Scene(SceneData&& sceneData)
+{
+    SceneHelpers::LoadScene(*this, std::move(sceneData));
+
+    Details::InitializeScene(*this);
 }
 
 Scene::~Scene()
@@ -331,6 +514,7 @@ Scene::~Scene()
     {
         VulkanContext::bufferManager->DestroyBuffer(lvc.coefficientsBuffer);
         VulkanContext::bufferManager->DestroyBuffer(lvc.tetrahedralBuffer);
+        VulkanContext::bufferManager->DestroyBuffer(lvc.tetrahedronGridBuffer);
         VulkanContext::bufferManager->DestroyBuffer(lvc.positionsBuffer);
     }
 
@@ -346,23 +530,31 @@ Scene::~Scene()
         VulkanContext::textureManager->DestroySampler(sampler);
     }
 
-    const auto& gsc = ctx().get<GeometryStorageComponent>();
-
-    for (const Primitive& primitive : gsc.primitives)
+    if (const auto mgsc = ctx().find<MergedGeometryStorageComponent>())
     {
-        VulkanContext::bufferManager->DestroyBuffer(primitive.vertexBuffer);
-        VulkanContext::bufferManager->DestroyBuffer(primitive.indexBuffer);
+        VulkanContext::bufferPool->Free(mgsc->indexBuffer);
+        VulkanContext::bufferPool->Free(mgsc->vertexBuffer);
+    }
+    else
+    {
+        const auto& gsc = ctx().get<GeometryStorageComponent>();
+
+        for (const Primitive& primitive : gsc.primitives)
+        {
+            VulkanContext::bufferPool->Free(primitive.vertexBuffer);
+            VulkanContext::bufferPool->Free(primitive.indexBuffer);
+        }
     }
 
     if (const auto rtsc = ctx().find<RayTracingStorageComponent>())
     {
-        for (const vk::Buffer buffer : rtsc->vertexBuffers)
+        for (const BufferSlice& slice : rtsc->vertexBuffers)
         {
-            VulkanContext::bufferManager->DestroyBuffer(buffer);
+            VulkanContext::bufferPool->Free(slice);
         }
-        for (const vk::Buffer buffer : rtsc->indexBuffers)
+        for (const BufferSlice& slice : rtsc->indexBuffers)
         {
-            VulkanContext::bufferManager->DestroyBuffer(buffer);
+            VulkanContext::bufferPool->Free(slice);
         }
         for (const vk::AccelerationStructureKHR blas : rtsc->blases)
         {
@@ -370,6 +562,8 @@ Scene::~Scene()
         }
     }
 
+    ctx().erase<DynamicTlas>();
+
     if (const auto rsc = ctx().find<RenderStorageComponent>())
     {
         if (rsc->lightBuffer)
@@ -380,16 +574,51 @@ Scene::~Scene()
         {
             VulkanContext::bufferManager->DestroyBuffer(rsc->materialBuffer);
         }
-        if (rsc->tlas)
+        if (rsc->instanceBuffer)
         {
-            VulkanContext::accelerationStructureManager->DestroyAccelerationStructure(rsc->tlas);
+            VulkanContext::bufferManager->DestroyBuffer(rsc->instanceBuffer);
         }
     }
 }
 
+bool Scene::UpdateRayTracingInstances()
+{
+    if constexpr (!Config::kRayTracingEnabled)
+    {
+        return false;
+    }
+
+    auto& rsc = ctx().get<RenderStorageComponent>();
+
+    const uint32_t version = ctx().get<SceneBVH>().GetVersion();
+
+    if (rsc.instanceVersion == version)
+    {
+        return false;
+    }
+
+    EASY_FUNCTION()
+
+    VulkanContext::device->WaitIdle();
+
+    ctx().erase<DynamicTlas>();
+    VulkanContext::bufferManager->DestroyBuffer(rsc.instanceBuffer);
+
+    const DynamicTlas& dynamicTlas = ctx().emplace<DynamicTlas>(Details::CollectTlasInstances(*this));
+
+    rsc.tlas = dynamicTlas.Get();
+
+    rsc.instanceBuffer = Details::CreateInstanceBuffer(*this);
+    rsc.instanceVersion = version;
+
+    return true;
+}
+
 void Scene::AddScene(Scene&& scene, entt::entity spawn)
 {
     SceneAdder sceneAdder(std::move(scene), *this, spawn);
+
+    Details::UpdateTransformHierarchy(*this);
 }
 
 void Scene::PrepareToRender()
@@ -402,9 +631,23 @@ void Scene::PrepareToRender()
 
     rsc.materialBuffer = Details::CreateMaterialBuffer(*this);
 
+    if constexpr (Config::kGpuDrivenRendering)
+    {
+        Assert(!ctx().contains<MergedGeometryStorageComponent>());
+
+        ctx().emplace<MergedGeometryStorageComponent>(Details::MergeGeometry(*this));
+    }
+
+    ctx().emplace<SceneBVH>(*this);
+
     if constexpr (Config::kRayTracingEnabled)
     {
-        rsc.tlas = Details::GenerateTlas(*this);
+        const DynamicTlas& dynamicTlas = ctx().emplace<DynamicTlas>(Details::CollectTlasInstances(*this));
+
+        rsc.tlas = dynamicTlas.Get();
+
+        rsc.instanceBuffer = Details::CreateInstanceBuffer(*this);
+        rsc.instanceVersion = ctx().get<SceneBVH>().GetVersion();
     }
 
     if (!ctx().contains<CameraComponent&>())
@@ -435,7 +678,21 @@ void Scene::PrepareToRender()
 
         auto& lvc = emplace<LightVolumeComponent>(entity);
 
-        lvc = RenderContext::globalIllumination->GenerateLightVolume(*this);
+        std::optional<LightVolumeComponent> cachedLvc;
+
+        if (!CommandLine::Contains(CommandLine::kRebuildLightVolume))
+        {
+            cachedLvc = RenderContext::globalIllumination->LoadLightVolume(*this);
+        }
+
+        if (cachedLvc.has_value())
+        {
+            lvc = cachedLvc.value();
+        }
+        else
+        {
+            lvc = RenderContext::globalIllumination->GenerateLightVolume(*this);
+        }
 
         ctx().emplace<LightVolumeComponent&>(lvc);
     }
@@ -0,0 +1,378 @@
+#include <numeric>
+
+#include <xmmintrin.h>
+
+#include "Engine/Scene/SceneBVH.hpp"
+
+#include "Engine/Camera.hpp"
+#include "Engine/JobSystem.hpp"
+#include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/StorageComponents.hpp"
+
+#include "Utils/Logger.hpp"
+#include "Utils/TimeHelpers.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kMaxLeafSize = 4;
+
+    static constexpr uint32_t kPlaneCount = 6;
+
+    // Planes are tested in groups of 4, one SSE lane per plane
+    static constexpr uint32_t kPlaneGroupCount = 2;
+
+    // Never rejects anything, fills lanes of the last group
+    static constexpr glm::vec4 kPaddingPlane(0.0f, 0.0f, 0.0f, 1.0f);
+
+    struct FrustumPlanes
+    {
+        std::array<__m128, kPlaneGroupCount> x;
+        std::array<__m128, kPlaneGroupCount> y;
+        std::array<__m128, kPlaneGroupCount> z;
+        std::array<__m128, kPlaneGroupCount> w;
+        std::array<__m128, kPlaneGroupCount> absX;
+        std::array<__m128, kPlaneGroupCount> absY;
+        std::array<__m128, kPlaneGroupCount> absZ;
+    };
+
+    static FrustumPlanes GetFrustumPlanes(const glm::mat4& viewProj)
+    {
+        std::array<glm::vec4, kPlaneGroupCount * 4> planes;
+        planes.fill(kPaddingPlane);
+
+        const std::array<glm::vec4, kPlaneCount> frustumPlanes = CameraHelpers::GetFrustumPlanes(viewProj);
+
+        std::ranges::copy(frustumPlanes, planes.begin());
+
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        FrustumPlanes result;
+
+        for (uint32_t i = 0; i < kPlaneGroupCount; ++i)
+        {
+            const glm::vec4* group = planes.data() + i * 4;
+
+            result.x[i] = _mm_setr_ps(group[0].x, group[1].x, group[2].x, group[3].x);
+            result.y[i] = _mm_setr_ps(group[0].y, group[1].y, group[2].y, group[3].y);
+            result.z[i] = _mm_setr_ps(group[0].z, group[1].z, group[2].z, group[3].z);
+            result.w[i] = _mm_setr_ps(group[0].w, group[1].w, group[2].w, group[3].w);
+
+            result.absX[i] = _mm_andnot_ps(signMask, result.x[i]);
+            result.absY[i] = _mm_andnot_ps(signMask, result.y[i]);
+            result.absZ[i] = _mm_andnot_ps(signMask, result.z[i]);
+        }
+
+        return result;
+    }
+
+    static AABBox::Intersection TestBounds(const FrustumPlanes& planes,
+            const glm::vec3& center, const glm::vec3& extent)
+    {
+        const __m128 zero = _mm_setzero_ps();
+
+        const __m128 centerX = _mm_set1_ps(center.x);
+        const __m128 centerY = _mm_set1_ps(center.y);
+        const __m128 centerZ = _mm_set1_ps(center.z);
+
+        const __m128 extentX = _mm_set1_ps(extent.x);
+        const __m128 extentY = _mm_set1_ps(extent.y);
+        const __m128 extentZ = _mm_set1_ps(extent.z);
+
+        __m128 outside = zero;
+        __m128 intersect = zero;
+
+        for (uint32_t i = 0; i < kPlaneGroupCount; ++i)
+        {
+            const __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(centerX, planes.x[i]), _mm_mul_ps(centerY, planes.y[i])),
+                    _mm_add_ps(_mm_mul_ps(centerZ, planes.z[i]), planes.w[i]));
+
+            const __m128 radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(extentX, planes.absX[i]), _mm_mul_ps(extentY, planes.absY[i])),
+                    _mm_mul_ps(extentZ, planes.absZ[i]));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+            intersect = _mm_or_ps(intersect, _mm_cmplt_ps(_mm_sub_ps(distance, radius), zero));
+        }
+
+        if (_mm_movemask_ps(outside) != 0)
+        {
+            return AABBox::Intersection::eOutside;
+        }
+
+        if (_mm_movemask_ps(intersect) != 0)
+        {
+            return AABBox::Intersection::eIntersect;
+        }
+
+        return AABBox::Intersection::eInside;
+    }
+
+    static uint32_t GetLongestAxis(const glm::vec3& size)
+    {
+        if (size.x >= size.y && size.x >= size.z)
+        {
+            return 0;
+        }
+
+        return size.y >= size.z ? 1 : 2;
+    }
+
+    static AABBox GetBBox(const glm::vec3& center, const glm::vec3& extent)
+    {
+        return AABBox(center - extent, center + extent);
+    }
+
+    template <class T>
+    static std::vector<T> Reorder(const std::vector<T>& values, const std::vector<uint32_t>& order)
+    {
+        std::vector<T> result;
+        result.reserve(values.size());
+
+        for (const uint32_t index : order)
+        {
+            result.push_back(values[index]);
+        }
+
+        return result;
+    }
+}
+
+SceneBVH::SceneBVH(const Scene& scene)
+{
+    Build(scene);
+}
+
+void SceneBVH::Build(const Scene& scene)
+{
+    EASY_FUNCTION()
+
+    const float startSeconds = Timer::GetGlobalSeconds();
+
+    for (auto&& [entity, tc, rc] : scene.view<TransformComponent, RenderComponent>().each())
+    {
+        for (uint32_t i = 0; i < static_cast<uint32_t>(rc.renderObjects.size()); ++i)
+        {
+            items.push_back(Item{ entity, i });
+        }
+    }
+
+    if (items.empty())
+    {
+        return;
+    }
+
+    CalculateItemBounds(scene);
+
+    std::vector<uint32_t> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    nodes.reserve(items.size() * 2 / Details::kMaxLeafSize + 1);
+
+    BuildNode(order, 0, static_cast<uint32_t>(items.size()));
+
+    items = Details::Reorder(items, order);
+    itemBounds = Details::Reorder(itemBounds, order);
+
+    RefitNodes();
+
+    const float buildSeconds = Timer::GetGlobalSeconds() - startSeconds;
+
+    LogI << "Scene BVH built: " << nodes.size() << " nodes for " << items.size()
+            << " render objects in " << buildSeconds / Numbers::kMili << " ms\n";
+}
+
+void SceneBVH::Refit(const Scene& scene)
+{
+    EASY_FUNCTION()
+
+    CalculateItemBounds(scene);
+
+    RefitNodes();
+
+    dirty = false;
+}
+
+void SceneBVH::Rebuild(const Scene& scene)
+{
+    items.clear();
+    itemBounds.clear();
+    nodes.clear();
+
+    Build(scene);
+
+    ++version;
+
+    dirty = false;
+    topologyDirty = false;
+}
+
+std::vector<uint32_t> SceneBVH::Cull(const glm::mat4& viewProj, CullingStats& stats) const
+{
+    EASY_FUNCTION()
+
+    const TimePoint startTimePoint = std::chrono::high_resolution_clock::now();
+
+    stats = CullingStats{};
+
+    std::vector<uint32_t> visibleItems;
+
+    if (nodes.empty())
+    {
+        return visibleItems;
+    }
+
+    visibleItems.reserve(items.size());
+
+    const Details::FrustumPlanes planes = Details::GetFrustumPlanes(viewProj);
+
+    std::vector<uint32_t> stack{ 0 };
+
+    while (!stack.empty())
+    {
+        const uint32_t nodeIndex = stack.back();
+        stack.pop_back();
+
+        const Node& node = nodes[nodeIndex];
+
+        ++stats.testedCount;
+
+        const AABBox::Intersection intersection = Details::TestBounds(planes, node.center, node.extent);
+
+        if (intersection == AABBox::Intersection::eOutside)
+        {
+            continue;
+        }
+
+        const uint32_t lastItem = node.firstItem + node.itemCount;
+
+        if (intersection == AABBox::Intersection::eInside)
+        {
+            for (uint32_t i = node.firstItem; i < lastItem; ++i)
+            {
+                visibleItems.push_back(i);
+            }
+        }
+        else if (node.rightChild == 0)
+        {
+            for (uint32_t i = node.firstItem; i < lastItem; ++i)
+            {
+                ++stats.testedCount;
+
+                const Bounds& bounds = itemBounds[i];
+
+                if (Details::TestBounds(planes, bounds.center, bounds.extent) != AABBox::Intersection::eOutside)
+                {
+                    visibleItems.push_back(i);
+                }
+            }
+        }
+        else
+        {
+            stack.push_back(node.rightChild);
+            stack.push_back(nodeIndex + 1);
+        }
+    }
+
+    stats.drawnCount = static_cast<uint32_t>(visibleItems.size());
+    stats.culledCount = static_cast<uint32_t>(items.size()) - stats.drawnCount;
+
+    stats.cullMiliseconds = std::chrono::duration<float, std::milli>(
+            std::chrono::high_resolution_clock::now() - startTimePoint).count();
+
+    return visibleItems;
+}
+
+void SceneBVH::CalculateItemBounds(const Scene& scene)
+{
+    const auto& geometryComponent = scene.ctx().get<GeometryStorageComponent>();
+
+    itemBounds.resize(items.size());
+
+    JobSystem::ParallelFor(static_cast<uint32_t>(items.size()), [&](uint32_t i)
+        {
+            const Item& item = items[i];
+
+            const auto& tc = scene.get<TransformComponent>(item.entity);
+            const auto& rc = scene.get<RenderComponent>(item.entity);
+
+            const Primitive& primitive = geometryComponent.primitives[rc.renderObjects[item.renderObject].primitive];
+
+            const AABBox bbox = primitive.bbox.GetTransformed(tc.worldTransform.GetMatrix());
+
+            itemBounds[i] = Bounds{ bbox.GetCenter(), bbox.GetSize() * 0.5f };
+        });
+}
+
+uint32_t SceneBVH::BuildNode(std::vector<uint32_t>& order, uint32_t firstItem, uint32_t itemCount)
+{
+    const uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+
+    Node& node = nodes.emplace_back();
+    node.firstItem = firstItem;
+    node.itemCount = itemCount;
+
+    if (itemCount <= Details::kMaxLeafSize)
+    {
+        return nodeIndex;
+    }
+
+    AABBox centerBBox;
+
+    for (uint32_t i = firstItem; i < firstItem + itemCount; ++i)
+    {
+        centerBBox.Add(itemBounds[order[i]].center);
+    }
+
+    const uint32_t axis = Details::GetLongestAxis(centerBBox.GetSize());
+
+    const auto pred = [&](uint32_t a, uint32_t b)
+        {
+            return itemBounds[a].center[axis] < itemBounds[b].center[axis];
+        };
+
+    const uint32_t leftCount = itemCount / 2;
+
+    const auto begin = order.begin() + firstItem;
+
+    std::nth_element(begin, begin + leftCount, begin + itemCount, pred);
+
+    BuildNode(order, firstItem, leftCount);
+
+    const uint32_t rightChild = BuildNode(order, firstItem + leftCount, itemCount - leftCount);
+
+    nodes[nodeIndex].rightChild = rightChild;
+
+    return nodeIndex;
+}
+
+void SceneBVH::RefitNodes()
+{
+    // Children always follow their parents, so reverse order visits them first
+    for (size_t i = nodes.size(); i-- > 0;)
+    {
+        Node& node = nodes[i];
+
+        AABBox bbox;
+
+        if (node.rightChild == 0)
+        {
+            for (uint32_t j = node.firstItem; j < node.firstItem + node.itemCount; ++j)
+            {
+                bbox.Add(Details::GetBBox(itemBounds[j].center, itemBounds[j].extent));
+            }
+        }
+        else
+        {
+            const Node& leftChild = nodes[i + 1];
+            const Node& rightChild = nodes[node.rightChild];
+
+            bbox.Add(Details::GetBBox(leftChild.center, leftChild.extent));
+            bbox.Add(Details::GetBBox(rightChild.center, rightChild.extent));
+        }
+
+        node.center = bbox.GetCenter();
+        node.extent = bbox.GetSize() * 0.5f;
+    }
+}
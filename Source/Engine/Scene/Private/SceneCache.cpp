@@ -0,0 +1,301 @@
+#include "Engine/Scene/SceneCache.hpp"
+
+#include "Engine/Filesystem/Filesystem.hpp"
+#include "Engine/Config.hpp"
+
+#include "Utils/Serialization.hpp"
+#include "Utils/Logger.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kMagic = 0x4E435353; // "SSCN"
+
+    static constexpr uint32_t kVersion = 3;
+
+    struct Header
+    {
+        uint32_t magic = kMagic;
+        uint32_t version = kVersion;
+        uint32_t vertexSize = sizeof(Primitive::Vertex);
+        uint32_t materialSize = sizeof(gpu::Material);
+        uint64_t sourceHash = 0;
+        int64_t sourceTime = 0;
+    };
+
+    static Filepath GetCachePath(const Filepath& scenePath)
+    {
+        const size_t pathHash = std::hash<Filepath>()(scenePath);
+
+        const std::string filename = Format("%s_%016zx.scene", scenePath.GetBaseName().c_str(), pathHash);
+
+        return Filepath(Config::kCacheDirectory.GetAbsolute() + "Scenes/" + filename);
+    }
+
+    static Header GetSourceHeader(const Filepath& scenePath)
+    {
+        Header header;
+
+        header.sourceHash = std::hash<std::string>()(Filesystem::ReadFile(scenePath));
+        header.sourceTime = Filesystem::GetLastWriteTime(scenePath);
+
+        return header;
+    }
+
+    static bool IsHeaderValid(const Header& header, const Header& sourceHeader)
+    {
+        return header.magic == sourceHeader.magic
+                && header.version == sourceHeader.version
+                && header.vertexSize == sourceHeader.vertexSize
+                && header.materialSize == sourceHeader.materialSize
+                && header.sourceHash == sourceHeader.sourceHash
+                && header.sourceTime == sourceHeader.sourceTime;
+    }
+
+    static void WriteImage(BinaryWriter& writer, const SceneData::Image& image)
+    {
+        writer.Write(image.uri);
+        writer.Write(image.data);
+    }
+
+    static void ReadImage(BinaryReader& reader, SceneData::Image& image)
+    {
+        reader.Read(image.uri);
+        reader.Read(image.data);
+    }
+
+    // Written field by field, raw struct bytes would include padding and the disengaged optional storage
+    static void WriteSampler(BinaryWriter& writer, const SamplerDescription& sampler)
+    {
+        writer.Write(sampler.magFilter);
+        writer.Write(sampler.minFilter);
+        writer.Write(sampler.mipmapMode);
+        writer.Write(sampler.addressMode);
+
+        writer.Write(sampler.maxAnisotropy.has_value());
+        if (sampler.maxAnisotropy.has_value())
+        {
+            writer.Write(sampler.maxAnisotropy.value());
+        }
+
+        writer.Write(sampler.minLod);
+        writer.Write(sampler.maxLod);
+        writer.Write(sampler.unnormalizedCoords);
+    }
+
+    static void ReadSampler(BinaryReader& reader, SamplerDescription& sampler)
+    {
+        reader.Read(sampler.magFilter);
+        reader.Read(sampler.minFilter);
+        reader.Read(sampler.mipmapMode);
+        reader.Read(sampler.addressMode);
+
+        bool hasMaxAnisotropy = false;
+        reader.Read(hasMaxAnisotropy);
+        if (hasMaxAnisotropy)
+        {
+            sampler.maxAnisotropy = 0.0f;
+            reader.Read(sampler.maxAnisotropy.value());
+        }
+
+        reader.Read(sampler.minLod);
+        reader.Read(sampler.maxLod);
+        reader.Read(sampler.unnormalizedCoords);
+    }
+
+    static void WriteMaterial(BinaryWriter& writer, const Material& material)
+    {
+        writer.Write(material.data);
+        writer.Write(static_cast<uint32_t>(material.flags));
+    }
+
+    static void ReadMaterial(BinaryReader& reader, Material& material)
+    {
+        uint32_t flags = 0;
+
+        reader.Read(material.data);
+        reader.Read(flags);
+
+        material.flags = MaterialFlags(flags);
+    }
+
+    static void WriteGeometry(BinaryWriter& writer, const SceneData::Geometry& geometry)
+    {
+        writer.Write(geometry.indices);
+        writer.Write(geometry.vertices);
+        writer.Write(geometry.bbox);
+    }
+
+    static void ReadGeometry(BinaryReader& reader, SceneData::Geometry& geometry)
+    {
+        reader.Read(geometry.indices);
+        reader.Read(geometry.vertices);
+        reader.Read(geometry.bbox);
+    }
+
+    static void WriteNode(BinaryWriter& writer, const SceneData::Node& node)
+    {
+        writer.Write(node.parent);
+        writer.Write(node.transform.GetMatrix());
+        writer.Write(node.renderObjects);
+
+        writer.Write(node.camera.has_value());
+        if (node.camera.has_value())
+        {
+            writer.Write(node.camera.value());
+        }
+
+        writer.Write(node.light.has_value());
+        if (node.light.has_value())
+        {
+            writer.Write(node.light.value());
+        }
+
+        writer.Write(node.environmentPath);
+        writer.Write(node.scenePath);
+    }
+
+    static void ReadNode(BinaryReader& reader, SceneData::Node& node)
+    {
+        glm::mat4 matrix;
+
+        reader.Read(node.parent);
+        reader.Read(matrix);
+        reader.Read(node.renderObjects);
+
+        node.transform = Transform(matrix);
+
+        bool hasCamera = false;
+        reader.Read(hasCamera);
+        if (hasCamera)
+        {
+            node.camera = SceneData::Camera();
+            reader.Read(node.camera.value());
+        }
+
+        bool hasLight = false;
+        reader.Read(hasLight);
+        if (hasLight)
+        {
+            node.light = LightComponent();
+            reader.Read(node.light.value());
+        }
+
+        reader.Read(node.environmentPath);
+        reader.Read(node.scenePath);
+    }
+
+    template <class T, class F>
+    static void WriteArray(BinaryWriter& writer, const std::vector<T>& values, F&& functor)
+    {
+        writer.Write(static_cast<uint64_t>(values.size()));
+
+        for (const T& value : values)
+        {
+            functor(writer, value);
+        }
+    }
+
+    template <class T, class F>
+    static void ReadArray(BinaryReader& reader, std::vector<T>& values, F&& functor)
+    {
+        uint64_t size = 0;
+        reader.Read(size);
+
+        for (uint64_t i = 0; i < size && reader.IsValid(); ++i)
+        {
+            functor(reader, values.emplace_back());
+        }
+    }
+}
+
+std::optional<SceneData> SceneCache::Load(const Filepath& scenePath)
+{
+    EASY_FUNCTION()
+
+    const Filepath cachePath = Details::GetCachePath(scenePath);
+
+    if (!cachePath.Exists())
+    {
+        return std::nullopt;
+    }
+
+    const Bytes bytes = Filesystem::ReadBinaryFile(cachePath);
+
+    BinaryReader reader{ ByteView(bytes) };
+
+    Details::Header header;
+    reader.Read(header);
+
+    if (!reader.IsValid() || !Details::IsHeaderValid(header, Details::GetSourceHeader(scenePath)))
+    {
+        return std::nullopt;
+    }
+
+    SceneData sceneData;
+
+    uint64_t dependencyCount = 0;
+    reader.Read(dependencyCount);
+
+    for (uint64_t i = 0; i < dependencyCount && reader.IsValid(); ++i)
+    {
+        std::string& dependency = sceneData.dependencies.emplace_back();
+        int64_t dependencyTime = 0;
+
+        reader.Read(dependency);
+        reader.Read(dependencyTime);
+
+        const Filepath dependencyPath(scenePath.GetDirectory() + dependency);
+
+        if (Filesystem::GetLastWriteTime(dependencyPath) != dependencyTime)
+        {
+            return std::nullopt;
+        }
+    }
+
+    Details::ReadArray(reader, sceneData.images, &Details::ReadImage);
+
+    Details::ReadArray(reader, sceneData.samplers, &Details::ReadSampler);
+    reader.Read(sceneData.textures);
+
+    Details::ReadArray(reader, sceneData.materials, &Details::ReadMaterial);
+    Details::ReadArray(reader, sceneData.geometries, &Details::ReadGeometry);
+    Details::ReadArray(reader, sceneData.nodes, &Details::ReadNode);
+
+    if (!reader.IsValid() || !reader.IsEnd())
+    {
+        LogW << "Corrupted scene cache: " << cachePath.GetAbsolute() << "\n";
+        return std::nullopt;
+    }
+
+    return sceneData;
+}
+
+void SceneCache::Save(const Filepath& scenePath, const SceneData& sceneData)
+{
+    EASY_FUNCTION()
+
+    BinaryWriter writer;
+
+    writer.Write(Details::GetSourceHeader(scenePath));
+
+    writer.Write(static_cast<uint64_t>(sceneData.dependencies.size()));
+
+    for (const std::string& dependency : sceneData.dependencies)
+    {
+        const Filepath dependencyPath(scenePath.GetDirectory() + dependency);
+
+        writer.Write(dependency);
+        writer.Write(Filesystem::GetLastWriteTime(dependencyPath));
+    }
+
+    Details::WriteArray(writer, sceneData.images, &Details::WriteImage);
+
+    Details::WriteArray(writer, sceneData.samplers, &Details::WriteSampler);
+    writer.Write(sceneData.textures);
+
+    Details::WriteArray(writer, sceneData.materials, &Details::WriteMaterial);
+    Details::WriteArray(writer, sceneData.geometries, &Details::WriteGeometry);
+    Details::WriteArray(writer, sceneData.nodes, &Details::WriteNode);
+
+    Filesystem::WriteBinaryFile(Details::GetCachePath(scenePath), ByteView(writer.GetBytes()));
+}
@@ -0,0 +1,172 @@
+#include "Engine/Scene/SceneGenerator.hpp"
+
+#include "Engine/Scene/MeshHelpers.hpp"
+#include "Engine/Scene/SceneCache.hpp"
+#include "Engine/Config.hpp"
+
+#include "Utils/Assert.hpp"
+
+namespace Details
+{
+    static constexpr float kPrimitiveRadius = 0.5f;
+
+    static constexpr float kInstanceSpacing = 1.5f;
+
+    // Sphere tessellations are cycled through, so that neighbouring primitives differ in size and vertex count
+    static constexpr uint32_t kMinSectorCount = 4;
+    static constexpr uint32_t kMinStackCount = 3;
+    static constexpr uint32_t kSectorCountVariation = 8;
+    static constexpr uint32_t kStackCountVariation = 5;
+
+    // Sphere poles lie on the Z axis, tangents of their vertices can't be derived from it
+    static constexpr float kPoleNormalZ = 0.999f;
+
+    static constexpr glm::vec3 kLightColor = Vector3::kUnit;
+
+    static SceneData::Geometry GenerateGeometry(uint32_t index)
+    {
+        const uint32_t sectorCount = kMinSectorCount + index % kSectorCountVariation;
+        const uint32_t stackCount = kMinStackCount + index / kSectorCountVariation % kStackCountVariation;
+
+        const Mesh mesh = MeshHelpers::GenerateSphere(kPrimitiveRadius, sectorCount, stackCount);
+
+        SceneData::Geometry geometry;
+        geometry.indices = mesh.indices;
+        geometry.vertices.reserve(mesh.vertices.size());
+
+        for (const glm::vec3& position : mesh.vertices)
+        {
+            const glm::vec3 normal = glm::normalize(position);
+
+            const glm::vec3 tangent = std::abs(normal.z) < kPoleNormalZ
+                    ? glm::normalize(glm::cross(Vector3::kZ, normal)) : Vector3::kX;
+
+            geometry.vertices.push_back(Primitive::Vertex{ position, normal, tangent, glm::vec2(0.0f) });
+
+            geometry.bbox.Add(position);
+        }
+
+        return geometry;
+    }
+
+    static Material GenerateMaterial(uint32_t index, uint32_t materialCount)
+    {
+        const float hue = static_cast<float>(index) / static_cast<float>(materialCount);
+
+        const glm::vec3 phase = glm::vec3(0.0f, 1.0f, 2.0f) / 3.0f;
+        const glm::vec3 baseColor = 0.5f + 0.5f * glm::cos(2.0f * Numbers::kPi * (hue + phase));
+
+        Material material{};
+
+        material.data.baseColorTexture = -1;
+        material.data.roughnessMetallicTexture = -1;
+        material.data.normalTexture = -1;
+        material.data.occlusionTexture = -1;
+        material.data.emissionTexture = -1;
+
+        material.data.baseColorFactor = glm::vec4(baseColor, 1.0f);
+        material.data.emissionFactor = glm::vec4(Vector3::kZero, 0.0f);
+
+        material.data.roughnessFactor = 0.2f + 0.6f * glm::fract(hue * 7.0f);
+        material.data.metallicFactor = index % 2 == 0 ? 0.0f : 1.0f;
+        material.data.normalScale = 1.0f;
+        material.data.occlusionStrength = 1.0f;
+        material.data.alphaCutoff = 0.5f;
+
+        // Winding of the generated spheres is not guaranteed to match the renderer culling
+        material.flags |= MaterialFlagBits::eDoubleSided;
+
+        return material;
+    }
+
+    static SceneData::Node GenerateCameraNode(float sceneSize)
+    {
+        const glm::vec3 position = glm::vec3(0.0f, 0.25f, 0.6f) * sceneSize;
+
+        CameraProjection projection = Config::DefaultCamera::kProjection;
+        projection.zFar = std::max(projection.zFar, sceneSize * 2.0f);
+
+        SceneData::Node node;
+        node.camera = SceneData::Camera{
+            CameraLocation{ position, glm::normalize(-position), Direction::kUp },
+            projection
+        };
+
+        return node;
+    }
+
+    static SceneData::Node GenerateLightNode()
+    {
+        const glm::quat rotation = glm::angleAxis(glm::radians(-60.0f), Vector3::kZ);
+
+        SceneData::Node node;
+        node.transform = Transform(Vector3::kZero, rotation, Vector3::kUnit);
+        node.light = LightComponent{ LightComponent::Type::eDirectional, kLightColor };
+
+        return node;
+    }
+}
+
+SceneData SceneGenerator::Generate(const Description& description)
+{
+    EASY_FUNCTION()
+
+    Assert(description.primitiveCount > 0 && description.materialCount > 0);
+    Assert(description.instanceCount > 0 && description.hierarchyDepth > 0);
+
+    SceneData sceneData;
+
+    sceneData.geometries.reserve(description.primitiveCount);
+
+    for (uint32_t i = 0; i < description.primitiveCount; ++i)
+    {
+        sceneData.geometries.push_back(Details::GenerateGeometry(i));
+    }
+
+    sceneData.materials.reserve(description.materialCount);
+
+    for (uint32_t i = 0; i < description.materialCount; ++i)
+    {
+        sceneData.materials.push_back(Details::GenerateMaterial(i, description.materialCount));
+    }
+
+    const uint32_t chainCount = (description.instanceCount + description.hierarchyDepth - 1)
+            / description.hierarchyDepth;
+
+    const uint32_t gridSize = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(chainCount))));
+
+    const float sceneSize = static_cast<float>(gridSize) * Details::kInstanceSpacing;
+
+    sceneData.nodes.reserve(description.instanceCount + 2);
+
+    sceneData.nodes.push_back(Details::GenerateCameraNode(sceneSize));
+    sceneData.nodes.push_back(Details::GenerateLightNode());
+
+    // Chains of instances grow upwards from the cells of a square grid
+    for (uint32_t i = 0; i < description.instanceCount; ++i)
+    {
+        const uint32_t chainIndex = i / description.hierarchyDepth;
+        const bool isRoot = i % description.hierarchyDepth == 0;
+
+        glm::vec3 translation = Direction::kUp * Details::kInstanceSpacing;
+
+        if (isRoot)
+        {
+            const glm::vec2 cell(chainIndex % gridSize, chainIndex / gridSize);
+            const glm::vec2 position = (cell + 0.5f) * Details::kInstanceSpacing - 0.5f * sceneSize;
+
+            translation = glm::vec3(position.x, 0.0f, position.y);
+        }
+
+        SceneData::Node node;
+        node.parent = isRoot ? -1 : static_cast<int32_t>(sceneData.nodes.size()) - 1;
+        node.transform = Transform(translation, Quat::kIdentity, Vector3::kUnit);
+        node.renderObjects.push_back(RenderObject{
+            i % description.primitiveCount, i % description.materialCount
+        });
+
+        sceneData.nodes.push_back(std::move(node));
+    }
+
+    return sceneData;
+}
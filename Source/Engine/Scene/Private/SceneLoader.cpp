@@ -2,17 +2,20 @@
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #define TINYGLTF_USE_CPP14
+#define TINYGLTF_NO_EXTERNAL_IMAGE
 #include <tiny_gltf.h>
 #pragma warning(pop)
 
 #include "Engine/Scene/SceneLoader.hpp"
 
+#include "Engine/JobSystem.hpp"
 #include "Engine/Render/Vulkan/VulkanConfig.hpp"
 #include "Engine/Render/Vulkan/VulkanContext.hpp"
 #include "Engine/Render/RenderContext.hpp"
 #include "Engine/Scene/StorageComponents.hpp"
 #include "Engine/Scene/Environment.hpp"
 #include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/SceneCache.hpp"
 #include "Engine/Scene/Material.hpp"
 #include "Engine/Scene/Primitive.hpp"
 #include "Engine/Scene/Scene.hpp"
@@ -22,28 +25,28 @@
 
 namespace Details
 {
-    using NodeFunctor = std::function<entt::entity(const tinygltf::Node&, entt::entity)>;
+    using NodeFunctor = std::function<int32_t(const tinygltf::Node&, int32_t)>;
 
-    static vk::Format GetFormat(const tinygltf::Image& image)
+    static constexpr size_t kLoadingStageCount = 4;
+
+    static constexpr int32_t kImageComponentCount = STBI_rgb_alpha;
+
+    static constexpr vk::Format kImageFormat = vk::Format::eR8G8B8A8Unorm;
+
+    static constexpr size_t kDecodedImagesMemoryBudget = 512 * static_cast<size_t>(Numbers::kMegabyte);
+
+    struct DecodedImage
     {
-        Assert(image.bits == 8);
-        Assert(image.pixel_type == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE);
+        vk::Extent2D extent;
+        Bytes data;
+    };
 
-        switch (image.component)
-        {
-        case 1:
-            return vk::Format::eR8Unorm;
-        case 2:
-            return vk::Format::eR8G8Unorm;
-        case 3:
-            return vk::Format::eR8G8B8Unorm;
-        case 4:
-            return vk::Format::eR8G8B8A8Unorm;
-        default:
-            Assert(false);
-            return vk::Format::eUndefined;
-        }
-    }
+    // Consecutive images which are decoded together
+    struct ImageBatch
+    {
+        size_t begin = 0;
+        size_t end = 0;
+    };
 
     static vk::Filter GetSamplerFilter(int32_t filter)
     {
@@ -160,31 +163,19 @@ namespace Details
         return DataView<T>(data, accessor.count);
     }
 
-    static ByteView GetAccessorByteView(const tinygltf::Model& model,
-            const tinygltf::Accessor& accessor)
-    {
-        const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
-        Assert(bufferView.byteStride == 0 || bufferView.byteStride == GetAccessorValueSize(accessor));
-
-        const size_t offset = bufferView.byteOffset + accessor.byteOffset;
-        const uint8_t* data = model.buffers[bufferView.buffer].data.data() + offset;
-
-        return DataView<uint8_t>(data, bufferView.byteLength - accessor.byteOffset);
-    }
-
     static void EnumerateNodes(const tinygltf::Model& model, const NodeFunctor& functor)
     {
-        using Enumerator = std::function<void(const tinygltf::Node&, entt::entity)>;
+        using Enumerator = std::function<void(const tinygltf::Node&, int32_t)>;
 
-        const Enumerator enumerator = [&](const tinygltf::Node& node, entt::entity parent)
+        const Enumerator enumerator = [&](const tinygltf::Node& node, int32_t parent)
             {
-                const entt::entity entity = functor(node, parent);
+                const int32_t index = functor(node, parent);
 
                 for (const auto& childIndex : node.children)
                 {
                     const tinygltf::Node& child = model.nodes[childIndex];
 
-                    enumerator(child, entity);
+                    enumerator(child, index);
                 }
             };
 
@@ -194,30 +185,203 @@ namespace Details
             {
                 const tinygltf::Node& node = model.nodes[nodeIndex];
 
-                enumerator(node, entt::null);
+                enumerator(node, -1);
             }
         }
     }
 
-    static std::vector<Texture> RetrieveImages(const tinygltf::Model& model)
+    static std::string DecodeUri(const std::string& uri)
     {
-        std::vector<Texture> textures;
-        textures.reserve(model.images.size());
+        std::string result;
+        result.reserve(uri.size());
 
-        for (const auto& image : model.images)
+        for (size_t i = 0; i < uri.size(); ++i)
         {
-            const vk::Format format = GetFormat(image);
-            const vk::Extent2D extent = VulkanHelpers::GetExtent(image.width, image.height);
+            if (uri[i] == '%' && i + 2 < uri.size())
+            {
+                const std::string hex = uri.substr(i + 1, 2);
+
+                result.push_back(static_cast<char>(std::strtol(hex.c_str(), nullptr, 16)));
 
-            textures.push_back(VulkanContext::textureManager->CreateTexture(format, extent, ByteView(image.image)));
+                i += 2;
+            }
+            else
+            {
+                result.push_back(uri[i]);
+            }
         }
 
-        return textures;
+        return result;
+    }
+
+    static bool IsExternalUri(const std::string& uri)
+    {
+        return !uri.empty() && uri.find("data:") != 0;
+    }
+
+    // Embedded images are stored encoded, decoding is deferred to SceneLoader::CreateImages
+    static bool LoadEncodedImage(tinygltf::Image* image, const int, std::string* errors, std::string*,
+            int, int, const unsigned char* bytes, int size, void*)
+    {
+        int32_t width, height, componentCount;
+
+        if (!stbi_info_from_memory(bytes, size, &width, &height, &componentCount))
+        {
+            if (errors)
+            {
+                *errors += "Unsupported image format: " + image->name + "\n";
+            }
+
+            return false;
+        }
+
+        image->width = width;
+        image->height = height;
+        image->component = kImageComponentCount;
+        image->bits = 8;
+        image->pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+        image->image.assign(bytes, bytes + size);
+
+        return true;
+    }
+
+    static tinygltf::Model LoadModel(const Filepath& path)
+    {
+        EASY_FUNCTION()
+
+        tinygltf::TinyGLTF loader;
+        tinygltf::Model model;
+
+        loader.SetImageLoader(&LoadEncodedImage, nullptr);
+
+        std::string errors;
+        std::string warnings;
+
+        const bool result = loader.LoadASCIIFromFile(&model, &errors, &warnings, path.GetAbsolute());
+
+        if (!warnings.empty())
+        {
+            LogW << "Scene loaded with warnings:\n" << warnings;
+        }
+
+        if (!errors.empty())
+        {
+            LogE << "Failed to load scene:\n" << errors;
+        }
+
+        Assert(result);
+
+        return model;
+    }
+
+    static Filepath GetImagePath(const Filepath& scenePath, const SceneData::Image& image)
+    {
+        return Filepath(scenePath.GetDirectory() + image.uri);
+    }
+
+    static size_t EstimateDecodedImageSize(const Filepath& scenePath, const SceneData::Image& image)
+    {
+        int32_t width = 0, height = 0, componentCount = 0;
+
+        if (image.uri.empty())
+        {
+            stbi_info_from_memory(image.data.data(), static_cast<int32_t>(image.data.size()),
+                    &width, &height, &componentCount);
+        }
+        else
+        {
+            stbi_info(GetImagePath(scenePath, image).GetAbsolute().c_str(), &width, &height, &componentCount);
+        }
+
+        return static_cast<size_t>(width) * static_cast<size_t>(height) * kImageComponentCount;
+    }
+
+    static DecodedImage DecodeImage(const Filepath& scenePath, const SceneData::Image& image)
+    {
+        EASY_FUNCTION()
+
+        int32_t width, height;
+
+        uint8_t* data = nullptr;
+
+        if (image.uri.empty())
+        {
+            data = stbi_load_from_memory(image.data.data(), static_cast<int32_t>(image.data.size()),
+                    &width, &height, nullptr, kImageComponentCount);
+        }
+        else
+        {
+            data = stbi_load(GetImagePath(scenePath, image).GetAbsolute().c_str(),
+                    &width, &height, nullptr, kImageComponentCount);
+        }
+
+        Assert(data);
+
+        const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * kImageComponentCount;
+
+        DecodedImage decodedImage{ VulkanHelpers::GetExtent(width, height), Bytes(data, data + size) };
+
+        stbi_image_free(data);
+
+        return decodedImage;
+    }
+
+    // Two batches are in flight at once: one is decoded while the previous one is uploaded
+    static std::vector<ImageBatch> SplitImagesIntoBatches(const Filepath& scenePath,
+            const std::vector<SceneData::Image>& images)
+    {
+        EASY_FUNCTION()
+
+        constexpr size_t kBatchMemoryBudget = kDecodedImagesMemoryBudget / 2;
+
+        std::vector<ImageBatch> batches;
+
+        size_t batchSize = 0;
+
+        for (size_t i = 0; i < images.size(); ++i)
+        {
+            const size_t imageSize = EstimateDecodedImageSize(scenePath, images[i]);
+
+            if (batches.empty() || batchSize + imageSize > kBatchMemoryBudget)
+            {
+                batches.push_back(ImageBatch{ i, i });
+
+                batchSize = 0;
+            }
+
+            batches.back().end = i + 1;
+
+            batchSize += imageSize;
+        }
+
+        return batches;
+    }
+
+    static std::vector<SceneData::Image> RetrieveImages(tinygltf::Model& model)
+    {
+        std::vector<SceneData::Image> images;
+        images.reserve(model.images.size());
+
+        for (auto& gltfImage : model.images)
+        {
+            SceneData::Image& image = images.emplace_back();
+
+            if (gltfImage.bufferView < 0 && IsExternalUri(gltfImage.uri))
+            {
+                image.uri = DecodeUri(gltfImage.uri);
+            }
+            else
+            {
+                image.data = std::move(gltfImage.image);
+            }
+        }
+
+        return images;
     }
 
-    static std::vector<vk::Sampler> RetrieveSamplers(const tinygltf::Model& model)
+    static std::vector<SamplerDescription> RetrieveSamplers(const tinygltf::Model& model)
     {
-        std::vector<vk::Sampler> samplers;
+        std::vector<SamplerDescription> samplers;
         samplers.reserve(model.samplers.size());
 
         for (const auto& sampler : model.samplers)
@@ -234,12 +398,27 @@ namespace Details
                 false
             };
 
-            samplers.push_back(VulkanContext::textureManager->CreateSampler(samplerDescription));
+            samplers.push_back(samplerDescription);
         }
 
         return samplers;
     }
 
+    static std::vector<SceneData::SampledImage> RetrieveTextures(const tinygltf::Model& model)
+    {
+        std::vector<SceneData::SampledImage> textures;
+        textures.reserve(model.textures.size());
+
+        for (const auto& texture : model.textures)
+        {
+            Assert(texture.source >= 0);
+
+            textures.push_back(SceneData::SampledImage{ texture.source, texture.sampler });
+        }
+
+        return textures;
+    }
+
     static Material RetrieveMaterial(const tinygltf::Material& gltfMaterial)
     {
         Assert(gltfMaterial.pbrMetallicRoughness.baseColorTexture.texCoord == 0);
@@ -349,134 +528,126 @@ namespace Details
         return vertices;
     }
 
-    static Primitive RetrievePrimitive(
-            const tinygltf::Model& model, const tinygltf::Primitive& gltfPrimitive)
+    static std::vector<uint32_t> RetrieveIndices(
+            const tinygltf::Model& model, const tinygltf::Accessor& indicesAccessor)
     {
-        Assert(gltfPrimitive.indices >= 0);
-        const tinygltf::Accessor& indicesAccessor = model.accessors[gltfPrimitive.indices];
-
         const vk::IndexType indexType = GetIndexType(indicesAccessor.componentType);
-        const ByteView indices = GetAccessorByteView(model, indicesAccessor);
-
-        std::vector<Primitive::Vertex> vertices = RetrieveVertices(model, gltfPrimitive);
 
-        if (!gltfPrimitive.attributes.contains("NORMAL"))
-        {
-            PrimitiveHelpers::CalculateNormals(indexType, indices, vertices);
-        }
-        if (!gltfPrimitive.attributes.contains("TANGENT"))
+        if (indexType == vk::IndexType::eUint32)
         {
-            PrimitiveHelpers::CalculateTangents(indexType, indices, vertices);
-        }
-
-        const uint32_t indexCount = static_cast<uint32_t>(indicesAccessor.count);
+            const DataView<uint32_t> indices = GetAccessorDataView<uint32_t>(model, indicesAccessor);
 
-        const vk::Buffer indexBuffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eIndexBuffer, indices);
+            return std::vector<uint32_t>(indices.data, indices.data + indices.size);
+        }
 
-        const vk::Buffer vertexBuffer = BufferHelpers::CreateBufferWithData(
-                vk::BufferUsageFlagBits::eVertexBuffer, ByteView(vertices));
+        Assert(indexType == vk::IndexType::eUint16);
 
-        Primitive primitive;
+        const DataView<uint16_t> indices16 = GetAccessorDataView<uint16_t>(model, indicesAccessor);
 
-        primitive.indexType = indexType;
-        primitive.indexCount = indexCount;
-        primitive.indexBuffer = indexBuffer;
-        primitive.vertexBuffer = vertexBuffer;
+        std::vector<uint32_t> indices32(indices16.size);
 
-        for (const auto& vertex : vertices)
+        for (size_t i = 0; i < indices16.size; ++i)
         {
-            primitive.bbox.Add(vertex.position);
+            indices32[i] = static_cast<uint32_t>(indices16[i]);
         }
 
-        return primitive;
+        return indices32;
     }
 
-    static vk::AccelerationStructureKHR GenerateBlas(
+    static SceneData::Geometry RetrieveGeometry(
             const tinygltf::Model& model, const tinygltf::Primitive& gltfPrimitive)
     {
         Assert(gltfPrimitive.indices >= 0);
         const tinygltf::Accessor& indicesAccessor = model.accessors[gltfPrimitive.indices];
 
-        Assert(gltfPrimitive.attributes.contains("POSITION"));
-        const tinygltf::Accessor& positionsAccessor = model.accessors[gltfPrimitive.attributes.at("POSITION")];
+        SceneData::Geometry geometry;
 
-        Assert(positionsAccessor.type == TINYGLTF_TYPE_VEC3);
-        Assert(positionsAccessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT);
+        geometry.indices = RetrieveIndices(model, indicesAccessor);
+        geometry.vertices = RetrieveVertices(model, gltfPrimitive);
 
-        BlasGeometryData geometryData;
+        const ByteView indices(geometry.indices);
 
-        geometryData.indexType = GetIndexType(indicesAccessor.componentType);
-        geometryData.indexCount = static_cast<uint32_t>(indicesAccessor.count);
-        geometryData.indices = GetAccessorByteView(model, indicesAccessor);
+        if (!gltfPrimitive.attributes.contains("NORMAL"))
+        {
+            PrimitiveHelpers::CalculateNormals(vk::IndexType::eUint32, indices, geometry.vertices);
+        }
+        if (!gltfPrimitive.attributes.contains("TANGENT"))
+        {
+            PrimitiveHelpers::CalculateTangents(vk::IndexType::eUint32, indices, geometry.vertices);
+        }
 
-        geometryData.vertexFormat = vk::Format::eR32G32B32Sfloat;
-        geometryData.vertexStride = sizeof(glm::vec3);
-        geometryData.vertexCount = static_cast<uint32_t>(positionsAccessor.count);
-        geometryData.vertices = GetAccessorByteView(model, positionsAccessor);
+        for (const auto& vertex : geometry.vertices)
+        {
+            geometry.bbox.Add(vertex.position);
+        }
 
-        return VulkanContext::accelerationStructureManager->GenerateBlas(geometryData);
+        return geometry;
     }
 
-    static vk::Buffer CreateRayTracingIndexBuffer(
-            const tinygltf::Model& model, const tinygltf::Primitive& gltfPrimitive)
+    static std::vector<SceneData::Geometry> RetrieveGeometries(const tinygltf::Model& model)
     {
-        Assert(gltfPrimitive.indices >= 0);
-        const tinygltf::Accessor& indicesAccessor = model.accessors[gltfPrimitive.indices];
+        std::vector<SceneData::Geometry> geometries;
+        geometries.reserve(model.meshes.size());
 
-        const vk::IndexType indexType = GetIndexType(indicesAccessor.componentType);
-
-        const ByteView indices = GetAccessorByteView(model, indicesAccessor);
-
-        if (indexType == vk::IndexType::eUint32)
+        for (const auto& mesh : model.meshes)
         {
-            return BufferHelpers::CreateBufferWithData(vk::BufferUsageFlagBits::eStorageBuffer, indices);
+            for (const auto& primitive : mesh.primitives)
+            {
+                geometries.push_back(RetrieveGeometry(model, primitive));
+            }
         }
 
-        Assert(indexType == vk::IndexType::eUint16);
+        return geometries;
+    }
 
-        const DataView<uint16_t> indices16 = DataView<uint16_t>(indices);
+    static Primitive CreatePrimitive(const SceneData::Geometry& geometry)
+    {
+        Primitive primitive;
 
-        std::vector<uint32_t> indices32(indices16.size);
+        primitive.indexType = vk::IndexType::eUint32;
+        primitive.indexCount = static_cast<uint32_t>(geometry.indices.size());
+        primitive.vertexCount = static_cast<uint32_t>(geometry.vertices.size());
+        primitive.indexBuffer = BufferHelpers::CreateSliceWithData(ByteView(geometry.indices));
+        primitive.vertexBuffer = BufferHelpers::CreateSliceWithData(ByteView(geometry.vertices));
+        primitive.bbox = geometry.bbox;
 
-        for (size_t i = 0; i < indices16.size; ++i)
-        {
-            indices32[i] = static_cast<uint32_t>(indices16[i]);
-        }
-
-        return BufferHelpers::CreateBufferWithData(vk::BufferUsageFlagBits::eStorageBuffer, ByteView(indices32));
+        return primitive;
     }
 
-    static vk::Buffer CreateRayTracingVertexBuffer(
-            const tinygltf::Model& model, const tinygltf::Primitive& gltfPrimitive)
+    static BlasGeometryBuffers GetBlasGeometryBuffers(const Primitive& primitive, const SceneData::Geometry& geometry)
     {
-        Assert(gltfPrimitive.indices >= 0);
-        const tinygltf::Accessor& indicesAccessor = model.accessors[gltfPrimitive.indices];
+        BlasGeometryBuffers geometryBuffers;
 
-        const vk::IndexType indexType = GetIndexType(indicesAccessor.componentType);
+        geometryBuffers.indexType = primitive.indexType;
+        geometryBuffers.indexCount = primitive.indexCount;
+        geometryBuffers.indexBuffer = primitive.indexBuffer;
 
-        const ByteView indices = GetAccessorByteView(model, indicesAccessor);
+        geometryBuffers.vertexFormat = vk::Format::eR32G32B32Sfloat;
+        geometryBuffers.vertexStride = sizeof(Primitive::Vertex);
+        geometryBuffers.vertexCount = static_cast<uint32_t>(geometry.vertices.size());
+        geometryBuffers.vertexBuffer = primitive.vertexBuffer;
 
-        std::vector<Primitive::Vertex> vertices = RetrieveVertices(model, gltfPrimitive);
+        return geometryBuffers;
+    }
 
-        if (!gltfPrimitive.attributes.contains("NORMAL"))
-        {
-            PrimitiveHelpers::CalculateNormals(indexType, indices, vertices);
-        }
-        if (!gltfPrimitive.attributes.contains("TANGENT"))
-        {
-            PrimitiveHelpers::CalculateTangents(indexType, indices, vertices);
-        }
+    static BufferSlice CreateRayTracingIndexBuffer(const SceneData::Geometry& geometry)
+    {
+        return BufferHelpers::CreateSliceWithData(ByteView(geometry.indices));
+    }
 
-        std::vector<gpu::VertexRT> verticesRT(vertices.size());
+    static BufferSlice CreateRayTracingVertexBuffer(const SceneData::Geometry& geometry)
+    {
+        std::vector<gpu::VertexRT> verticesRT(geometry.vertices.size());
 
-        for (size_t i = 0; i < vertices.size(); ++i)
+        for (size_t i = 0; i < geometry.vertices.size(); ++i)
         {
-            verticesRT[i].normal = glm::vec4(vertices[i].normal, vertices[i].texCoord.x);
-            verticesRT[i].tangent = glm::vec4(vertices[i].tangent, vertices[i].texCoord.y);
+            const Primitive::Vertex& vertex = geometry.vertices[i];
+
+            verticesRT[i].normal = glm::vec4(vertex.normal, vertex.texCoord.x);
+            verticesRT[i].tangent = glm::vec4(vertex.tangent, vertex.texCoord.y);
         }
 
-        return BufferHelpers::CreateBufferWithData(vk::BufferUsageFlagBits::eStorageBuffer, ByteView(verticesRT));
+        return BufferHelpers::CreateSliceWithData(ByteView(verticesRT));
     }
 
     static Transform RetrieveTransform(const tinygltf::Node& node)
@@ -552,72 +723,271 @@ namespace Details
 
         return Config::DefaultCamera::kProjection;
     }
+
+    static std::vector<RenderObject> RetrieveRenderObjects(const tinygltf::Model& model, int32_t meshIndex)
+    {
+        const tinygltf::Mesh& mesh = model.meshes[meshIndex];
+
+        size_t meshOffset = 0;
+        for (int32_t i = 0; i < meshIndex; ++i)
+        {
+            meshOffset += model.meshes[i].primitives.size();
+        }
+
+        std::vector<RenderObject> renderObjects(mesh.primitives.size());
+
+        for (size_t i = 0; i < mesh.primitives.size(); ++i)
+        {
+            const tinygltf::Primitive& primitive = mesh.primitives[i];
+
+            Assert(primitive.material >= 0);
+
+            renderObjects[i].primitive = static_cast<uint32_t>(meshOffset + i);
+            renderObjects[i].material = static_cast<uint32_t>(primitive.material);
+        }
+
+        return renderObjects;
+    }
+
+    static LightComponent RetrieveLight(const tinygltf::Model& model, const tinygltf::Node& node)
+    {
+        const int32_t lightIndex = node.extensions.at("KHR_lights_punctual").Get("light").Get<int32_t>();
+
+        Assert(lightIndex >= 0);
+
+        const tinygltf::Light& light = model.lights[lightIndex];
+
+        LightComponent lc;
+
+        if (light.type == "directional")
+        {
+            lc.type = LightComponent::Type::eDirectional;
+        }
+        else if (light.type == "point")
+        {
+            lc.type = LightComponent::Type::ePoint;
+        }
+        else
+        {
+            Assert(false);
+        }
+
+        lc.color = GetVec<3>(light.color) * static_cast<float>(light.intensity);
+
+        return lc;
+    }
+
+    static std::vector<SceneData::Node> RetrieveNodes(const tinygltf::Model& model)
+    {
+        std::vector<SceneData::Node> nodes;
+        nodes.reserve(model.nodes.size());
+
+        EnumerateNodes(model, [&](const tinygltf::Node& gltfNode, int32_t parent)
+            {
+                const int32_t index = static_cast<int32_t>(nodes.size());
+
+                SceneData::Node& node = nodes.emplace_back();
+
+                node.parent = parent;
+                node.transform = RetrieveTransform(gltfNode);
+
+                if (gltfNode.mesh >= 0)
+                {
+                    node.renderObjects = RetrieveRenderObjects(model, gltfNode.mesh);
+                }
+
+                if (gltfNode.camera >= 0)
+                {
+                    const tinygltf::Camera& camera = model.cameras[gltfNode.camera];
+
+                    node.camera = SceneData::Camera{
+                        RetrieveCameraLocation(gltfNode),
+                        RetrieveCameraProjection(camera)
+                    };
+                }
+
+                if (gltfNode.extensions.contains("KHR_lights_punctual"))
+                {
+                    node.light = RetrieveLight(model, gltfNode);
+                }
+
+                if (gltfNode.extras.Has("environment"))
+                {
+                    const tinygltf::Value& environment = gltfNode.extras.Get("environment");
+
+                    node.environmentPath = environment.Get("panoramaPath").Get<std::string>();
+                }
+
+                if (gltfNode.extras.Has("scene"))
+                {
+                    node.scenePath = gltfNode.extras.Get("scene").Get("path").Get<std::string>();
+                }
+
+                return index;
+            });
+
+        return nodes;
+    }
+
+    static std::vector<std::string> RetrieveDependencies(const tinygltf::Model& model)
+    {
+        std::vector<std::string> dependencies;
+
+        for (const auto& buffer : model.buffers)
+        {
+            if (IsExternalUri(buffer.uri))
+            {
+                dependencies.push_back(DecodeUri(buffer.uri));
+            }
+        }
+
+        return dependencies;
+    }
+
+    static SceneData RetrieveSceneData(tinygltf::Model& model)
+    {
+        EASY_FUNCTION()
+
+        SceneData sceneData;
+
+        sceneData.images = RetrieveImages(model);
+        sceneData.samplers = RetrieveSamplers(model);
+        sceneData.textures = RetrieveTextures(model);
+
+        sceneData.materials.reserve(model.materials.size());
+
+        for (const auto& material : model.materials)
+        {
+            sceneData.materials.push_back(RetrieveMaterial(material));
+        }
+
+        sceneData.geometries = RetrieveGeometries(model);
+        sceneData.nodes = RetrieveNodes(model);
+        sceneData.dependencies = RetrieveDependencies(model);
+
+        return sceneData;
+    }
 }
 
 class SceneLoader
 {
 public:
-    SceneLoader(Scene& scene_, const Filepath& path)
+    SceneLoader(Scene& scene_, const Filepath& path_)
         : scene(scene_)
+        , path(path_)
     {
-        LoadModel(path);
+        const float startSeconds = Timer::GetGlobalSeconds();
 
-        AddTextureStorageComponent();
+        ProgressLogger progressLogger("SceneLoader: " + path.GetFilename(), 1.0f);
 
-        AddMaterialStorageComponent();
+        const bool cached = LoadSceneData();
 
-        AddGeometryStorageComponent();
+        progressLogger.Log(1, Details::kLoadingStageCount);
 
-        AddRayTracingStorageComponent();
+        AddComponents(progressLogger);
 
-        AddNodes();
+        progressLogger.End();
+
+        const float loadingSeconds = Timer::GetGlobalSeconds() - startSeconds;
+
+        LogI << "Scene " << path.GetFilename() << (cached ? " loaded from cache in " : " loaded from source in ")
+                << loadingSeconds << " s\n";
+    }
+
+    // Generated scenes have no directory, so their images have to be embedded
+    SceneLoader(Scene& scene_, SceneData&& sceneData_)
+        : scene(scene_)
+        , sceneData(std::move(sceneData_))
+    {
+        const float startSeconds = Timer::GetGlobalSeconds();
+
+        ProgressLogger progressLogger("SceneLoader: generated", 1.0f);
+
+        progressLogger.Log(1, Details::kLoadingStageCount);
+
+        AddComponents(progressLogger);
+
+        progressLogger.End();
+
+        const float loadingSeconds = Timer::GetGlobalSeconds() - startSeconds;
+
+        LogI << "Generated scene loaded in " << loadingSeconds << " s\n";
     }
 
 private:
     Scene& scene;
 
-    tinygltf::Model model;
+    Filepath path;
 
-    void LoadModel(const Filepath& path)
+    SceneData sceneData;
+
+    bool LoadSceneData()
     {
         EASY_FUNCTION()
 
-        tinygltf::TinyGLTF loader;
-
-        std::string errors;
-        std::string warnings;
+        if constexpr (Config::kSceneCacheEnabled)
+        {
+            std::optional<SceneData> cachedSceneData = SceneCache::Load(path);
 
-        const bool result = loader.LoadASCIIFromFile(&model, &errors, &warnings, path.GetAbsolute());
+            if (cachedSceneData.has_value())
+            {
+                sceneData = std::move(cachedSceneData.value());
 
-        if (!warnings.empty())
-        {
-            LogW << "Scene loaded with warnings:\n" << warnings;
+                return true;
+            }
         }
 
-        if (!errors.empty())
+        tinygltf::Model model = Details::LoadModel(path);
+
+        sceneData = Details::RetrieveSceneData(model);
+
+        if constexpr (Config::kSceneCacheEnabled)
         {
-            LogE << "Failed to load scene:\n" << errors;
+            SceneCache::Save(path, sceneData);
         }
 
-        Assert(result);
+        return false;
     }
 
-    void AddTextureStorageComponent() const
+    void AddComponents(ProgressLogger& progressLogger)
+    {
+        AddTextureStorageComponent();
+
+        AddMaterialStorageComponent();
+
+        progressLogger.Log(2, Details::kLoadingStageCount);
+
+        AddGeometryStorageComponent();
+
+        AddRayTracingStorageComponent();
+
+        progressLogger.Log(3, Details::kLoadingStageCount);
+
+        AddNodes();
+
+        VulkanContext::uploadManager->Flush();
+    }
+
+    void AddTextureStorageComponent()
     {
         EASY_FUNCTION()
 
         auto& tsc = scene.ctx().emplace<TextureStorageComponent>();
 
-        tsc.images = Details::RetrieveImages(model);
-        tsc.samplers = Details::RetrieveSamplers(model);
+        tsc.images = CreateImages();
 
-        tsc.textures.reserve(model.textures.size());
+        tsc.samplers.reserve(sceneData.samplers.size());
 
-        for (const auto& texture : model.textures)
+        for (const auto& samplerDescription : sceneData.samplers)
         {
-            Assert(texture.source >= 0);
+            tsc.samplers.push_back(VulkanContext::textureManager->CreateSampler(samplerDescription));
+        }
 
-            const vk::ImageView view = tsc.images[texture.source].view;
+        tsc.textures.reserve(sceneData.textures.size());
+
+        for (const auto& texture : sceneData.textures)
+        {
+            const vk::ImageView view = tsc.images[texture.image].view;
 
             vk::Sampler sampler = RenderContext::defaultSampler;
             if (texture.sampler >= 0)
@@ -629,18 +999,90 @@ private:
         }
     }
 
-    void AddMaterialStorageComponent() const
+    // Decoding runs on worker threads while the main thread uploads the previously decoded batch
+    std::vector<Texture> CreateImages()
     {
         EASY_FUNCTION()
 
-        auto& msc = scene.ctx().emplace<MaterialStorageComponent>();
+        const std::vector<Details::ImageBatch> batches = Details::SplitImagesIntoBatches(path, sceneData.images);
 
-        msc.materials.reserve(model.materials.size());
+        std::vector<Details::DecodedImage> decodedImages(sceneData.images.size());
 
-        for (const auto& material : model.materials)
+        std::array<JobCounter, 2> counters;
+
+        std::atomic<float> decodingSeconds = 0.0f;
+
+        const auto decodeBatch = [&](const Details::ImageBatch& batch, JobCounter& counter)
+            {
+                for (size_t i = batch.begin; i < batch.end; ++i)
+                {
+                    JobSystem::Execute([&, i]()
+                        {
+                            const float startSeconds = Timer::GetGlobalSeconds();
+
+                            decodedImages[i] = Details::DecodeImage(path, sceneData.images[i]);
+
+                            sceneData.images[i].data = Bytes();
+
+                            decodingSeconds += Timer::GetGlobalSeconds() - startSeconds;
+                        }, counter);
+                }
+            };
+
+        std::vector<Texture> images;
+        images.reserve(sceneData.images.size());
+
+        float waitingSeconds = 0.0f;
+        float uploadingSeconds = 0.0f;
+
+        if (!batches.empty())
+        {
+            decodeBatch(batches.front(), counters.front());
+        }
+
+        for (size_t i = 0; i < batches.size(); ++i)
         {
-            msc.materials.push_back(Details::RetrieveMaterial(material));
+            float startSeconds = Timer::GetGlobalSeconds();
+
+            JobSystem::Wait(counters[i % counters.size()]);
+
+            waitingSeconds += Timer::GetGlobalSeconds() - startSeconds;
+
+            if (i + 1 < batches.size())
+            {
+                decodeBatch(batches[i + 1], counters[(i + 1) % counters.size()]);
+            }
+
+            startSeconds = Timer::GetGlobalSeconds();
+
+            for (size_t j = batches[i].begin; j < batches[i].end; ++j)
+            {
+                Details::DecodedImage& decodedImage = decodedImages[j];
+
+                images.push_back(VulkanContext::textureManager->CreateTexture(
+                        Details::kImageFormat, decodedImage.extent, ByteView(decodedImage.data)));
+
+                decodedImage.data = Bytes();
+            }
+
+            uploadingSeconds += Timer::GetGlobalSeconds() - startSeconds;
         }
+
+        LogI << "Scene images: " << images.size() << " in " << batches.size() << " batches, "
+                << "decoding " << decodingSeconds.load() << " s on " << JobSystem::GetThreadCount() << " threads, "
+                << "waiting for decoding " << waitingSeconds << " s, "
+                << "uploading " << uploadingSeconds << " s" << "\n";
+
+        return images;
+    }
+
+    void AddMaterialStorageComponent() const
+    {
+        EASY_FUNCTION()
+
+        auto& msc = scene.ctx().emplace<MaterialStorageComponent>();
+
+        msc.materials = sceneData.materials;
     }
 
     void AddGeometryStorageComponent() const
@@ -649,14 +1091,11 @@ private:
 
         auto& gsc = scene.ctx().emplace<GeometryStorageComponent>();
 
-        gsc.primitives.reserve(model.meshes.size());
+        gsc.primitives.reserve(sceneData.geometries.size());
 
-        for (const auto& mesh : model.meshes)
+        for (const auto& geometry : sceneData.geometries)
         {
-            for (const auto& primitive : mesh.primitives)
-            {
-                gsc.primitives.push_back(Details::RetrievePrimitive(model, primitive));
-            }
+            gsc.primitives.push_back(Details::CreatePrimitive(geometry));
         }
     }
 
@@ -668,21 +1107,26 @@ private:
         {
             auto& rtsc = scene.ctx().emplace<RayTracingStorageComponent>();
 
-            rtsc.indexBuffers.reserve(model.meshes.size());
-            rtsc.vertexBuffers.reserve(model.meshes.size());
+            rtsc.indexBuffers.reserve(sceneData.geometries.size());
+            rtsc.vertexBuffers.reserve(sceneData.geometries.size());
 
-            rtsc.blases.reserve(model.meshes.size());
+            const auto& gsc = scene.ctx().get<GeometryStorageComponent>();
 
-            for (const auto& mesh : model.meshes)
+            std::vector<BlasGeometryBuffers> blasGeometries;
+            blasGeometries.reserve(sceneData.geometries.size());
+
+            for (size_t i = 0; i < sceneData.geometries.size(); ++i)
             {
-                for (const auto& primitive : mesh.primitives)
-                {
-                    rtsc.indexBuffers.push_back(Details::CreateRayTracingIndexBuffer(model, primitive));
-                    rtsc.vertexBuffers.push_back(Details::CreateRayTracingVertexBuffer(model, primitive));
+                const SceneData::Geometry& geometry = sceneData.geometries[i];
 
-                    rtsc.blases.push_back(Details::GenerateBlas(model, primitive));
-                }
+                rtsc.indexBuffers.push_back(Details::CreateRayTracingIndexBuffer(geometry));
+                rtsc.vertexBuffers.push_back(Details::CreateRayTracingVertexBuffer(geometry));
+
+                blasGeometries.push_back(Details::GetBlasGeometryBuffers(gsc.primitives[i], geometry));
             }
+
+            rtsc.blases = VulkanContext::accelerationStructureManager->GenerateBlases(
+                    blasGeometries, VulkanConfig::kBlasCompactionEnabled);
         }
     }
 
@@ -690,41 +1134,46 @@ private:
     {
         EASY_FUNCTION()
 
-        Details::EnumerateNodes(model, [&](const tinygltf::Node& node, entt::entity parent)
-            {
-                const entt::entity entity = scene.create();
+        std::vector<entt::entity> entities;
+        entities.reserve(sceneData.nodes.size());
 
-                AddHierarchyComponent(entity, parent);
+        for (const auto& node : sceneData.nodes)
+        {
+            const entt::entity entity = scene.create();
 
-                AddTransformComponent(entity, node);
+            const entt::entity parent = node.parent >= 0 ? entities[node.parent] : entt::null;
 
-                if (node.mesh >= 0)
-                {
-                    AddRenderComponent(entity, node);
-                }
+            entities.push_back(entity);
 
-                if (node.camera >= 0)
-                {
-                    AddCameraComponent(entity, node);
-                }
+            AddHierarchyComponent(entity, parent);
 
-                if (node.extensions.contains("KHR_lights_punctual"))
-                {
-                    AddLightComponent(entity, node);
-                }
+            AddTransformComponent(entity, node);
 
-                if (node.extras.Has("environment"))
-                {
-                    AddEnvironmentComponent(entity, node);
-                }
+            if (!node.renderObjects.empty())
+            {
+                AddRenderComponent(entity, node);
+            }
 
-                if (node.extras.Has("scene"))
-                {
-                    AddScene(entity, node);
-                }
+            if (node.camera.has_value())
+            {
+                AddCameraComponent(entity, node);
+            }
 
-                return entity;
-            });
+            if (node.light.has_value())
+            {
+                AddLightComponent(entity, node);
+            }
+
+            if (!node.environmentPath.empty())
+            {
+                AddEnvironmentComponent(entity, node);
+            }
+
+            if (!node.scenePath.empty())
+            {
+                AddScene(entity, node);
+            }
+        }
     }
 
     void AddHierarchyComponent(entt::entity entity, entt::entity parent) const
@@ -743,54 +1192,32 @@ private:
         }
     }
 
-    void AddTransformComponent(entt::entity entity, const tinygltf::Node& node) const
+    void AddTransformComponent(entt::entity entity, const SceneData::Node& node) const
     {
         EASY_FUNCTION()
 
         auto& tc = scene.emplace<TransformComponent>(entity);
 
-        tc.localTransform = Details::RetrieveTransform(node);
-
-        ComponentHelpers::AccumulateTransform(scene, entity);
+        tc.localTransform = node.transform;
     }
 
-    void AddRenderComponent(entt::entity entity, const tinygltf::Node& node) const
+    void AddRenderComponent(entt::entity entity, const SceneData::Node& node) const
     {
         EASY_FUNCTION()
 
         auto& rc = scene.emplace<RenderComponent>(entity);
 
-        const tinygltf::Mesh& mesh = model.meshes[node.mesh];
-
-        size_t meshOffset = 0;
-        for (int32_t i = 0; i < node.mesh; ++i)
-        {
-            meshOffset += model.meshes[i].primitives.size();
-        }
-
-        rc.renderObjects.resize(mesh.primitives.size());
-
-        for (size_t i = 0; i < mesh.primitives.size(); ++i)
-        {
-            const tinygltf::Primitive& primitive = mesh.primitives[i];
-
-            Assert(primitive.material >= 0);
-
-            rc.renderObjects[i].primitive = static_cast<uint32_t>(meshOffset + i);
-            rc.renderObjects[i].material = static_cast<uint32_t>(primitive.material);
-        }
+        rc.renderObjects = node.renderObjects;
     }
 
-    void AddCameraComponent(entt::entity entity, const tinygltf::Node& node) const
+    void AddCameraComponent(entt::entity entity, const SceneData::Node& node) const
     {
         EASY_FUNCTION()
 
         auto& cc = scene.emplace<CameraComponent>(entity);
 
-        const tinygltf::Camera& camera = model.cameras[node.camera];
-
-        cc.location = Details::RetrieveCameraLocation(node);
-        cc.projection = Details::RetrieveCameraProjection(camera);
+        cc.location = node.camera->location;
+        cc.projection = node.camera->projection;
 
         cc.viewMatrix = CameraHelpers::CalculateViewMatrix(cc.location);
         cc.projMatrix = CameraHelpers::CalculateProjMatrix(cc.projection);
@@ -801,45 +1228,20 @@ private:
         }
     }
 
-    void AddLightComponent(entt::entity entity, const tinygltf::Node& node) const
+    void AddLightComponent(entt::entity entity, const SceneData::Node& node) const
     {
         EASY_FUNCTION()
 
-        auto& lc = scene.emplace<LightComponent>(entity);
-
-        const int32_t lightIndex = node.extensions.at("KHR_lights_punctual").Get("light").Get<int32_t>();
-
-        Assert(lightIndex >= 0);
-
-        const tinygltf::Light& light = model.lights[lightIndex];
-
-        if (light.type == "directional")
-        {
-            lc.type = LightComponent::Type::eDirectional;
-        }
-        else if (light.type == "point")
-        {
-            lc.type = LightComponent::Type::ePoint;
-        }
-        else
-        {
-            Assert(false);
-        }
-
-        lc.color = Details::GetVec<3>(light.color) * static_cast<float>(light.intensity);
+        scene.emplace<LightComponent>(entity) = node.light.value();
     }
 
-    void AddEnvironmentComponent(entt::entity entity, const tinygltf::Node& node) const
+    void AddEnvironmentComponent(entt::entity entity, const SceneData::Node& node) const
     {
         EASY_FUNCTION()
 
         auto& ec = scene.emplace<EnvironmentComponent>(entity);
 
-        const tinygltf::Value& environment = node.extras.Get("environment");
-
-        const Filepath panoramaPath(environment.Get("panoramaPath").Get<std::string>());
-
-        ec = EnvironmentHelpers::LoadEnvironment(panoramaPath);
+        ec = EnvironmentHelpers::LoadEnvironment(Filepath(node.environmentPath));
 
         if (!scene.ctx().contains<EnvironmentComponent&>())
         {
@@ -847,13 +1249,11 @@ private:
         }
     }
 
-    void AddScene(entt::entity entity, const tinygltf::Node& node) const
+    void AddScene(entt::entity entity, const SceneData::Node& node) const
     {
         EASY_FUNCTION()
 
-        const Filepath scenePath(node.extras.Get("scene").Get("path").Get<std::string>());
-
-        scene.AddScene(Scene(scenePath), entity);
+        scene.AddScene(Scene(Filepath(node.scenePath)), entity);
     }
 };
 
@@ -863,3 +1263,10 @@ void SceneHelpers::LoadScene(Scene& scene, const Filepath& path)
 
     SceneLoader sceneLoader(scene, path);
 }
+
+void SceneHelpers::LoadScene(Scene& scene, SceneData&& sceneData)
+{
+    EASY_FUNCTION()
+
+    SceneLoader sceneLoader(scene, std::move(sceneData));
+}
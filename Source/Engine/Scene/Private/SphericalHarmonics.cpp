@@ -0,0 +1,233 @@
+#include <xmmintrin.h>
+
+#include <glm/gtc/packing.hpp>
+
+#include "Engine/Scene/SphericalHarmonics.hpp"
+
+#include "Engine/JobSystem.hpp"
+
+#include "Utils/Assert.hpp"
+#include "Utils/Helpers.hpp"
+
+namespace Details
+{
+    static constexpr uint32_t kFaceCount = 6;
+
+    static constexpr uint32_t kChannelCount = 3;
+
+    // RGBA16F texel
+    static constexpr size_t kTexelSize = 4 * sizeof(uint16_t);
+
+    // Probes projected together, one SSE lane per probe
+    static constexpr uint32_t kLaneCount = 4;
+
+    static constexpr uint32_t kSumCount = SphericalHarmonicsProjector::kCoefficientCount * kChannelCount;
+
+    using LaneProbes = std::array<const uint8_t*, kLaneCount>;
+
+    using LaneSums = std::array<float, kSumCount * kLaneCount>;
+
+    // Inverse of the Vulkan cube map face selection, s and t are in [-1, 1]
+    static glm::vec3 GetTexelDirection(uint32_t faceIndex, float s, float t)
+    {
+        switch (faceIndex)
+        {
+        case 0:
+            return glm::vec3(1.0f, -t, -s);
+        case 1:
+            return glm::vec3(-1.0f, -t, s);
+        case 2:
+            return glm::vec3(s, 1.0f, t);
+        case 3:
+            return glm::vec3(s, -1.0f, -t);
+        case 4:
+            return glm::vec3(s, -t, 1.0f);
+        case 5:
+            return glm::vec3(-s, -t, -1.0f);
+        default:
+            Assert(false);
+            return glm::vec3();
+        }
+    }
+
+    static float CalculateAreaElement(float x, float y)
+    {
+        return std::atan2(x * y, std::sqrt(x * x + y * y + 1.0f));
+    }
+
+    static float CalculateTexelSolidAngle(float s, float t, float halfTexelSize)
+    {
+        const float x0 = s - halfTexelSize;
+        const float y0 = t - halfTexelSize;
+        const float x1 = s + halfTexelSize;
+        const float y1 = t + halfTexelSize;
+
+        return CalculateAreaElement(x0, y0) - CalculateAreaElement(x0, y1)
+                - CalculateAreaElement(x1, y0) + CalculateAreaElement(x1, y1);
+    }
+
+    // Same basis and order as LightVolume.comp
+    static std::array<float, SphericalHarmonicsProjector::kCoefficientCount> CalculateBasis(const glm::vec3& N)
+    {
+        return {
+            0.282095f,
+            0.488603f * N.y,
+            0.488603f * N.z,
+            0.488603f * N.x,
+            1.092548f * N.x * N.y,
+            1.092548f * N.y * N.z,
+            0.315392f * (3.0f * N.z * N.z - 1.0f),
+            1.092548f * N.x * N.z,
+            0.546274f * (N.x * N.x - N.y * N.y)
+        };
+    }
+
+    // Interleaves channels of the lane probes per texel, so each SSE load fetches one channel of all lanes
+    static std::vector<float> DecodeLaneProbes(const LaneProbes& probes, uint32_t texelCount)
+    {
+        std::vector<float> luminance(texelCount * kChannelCount * kLaneCount, 0.0f);
+
+        for (uint32_t lane = 0; lane < kLaneCount; ++lane)
+        {
+            if (probes[lane] == nullptr)
+            {
+                continue;
+            }
+
+            for (uint32_t i = 0; i < texelCount; ++i)
+            {
+                uint64_t packedTexel = 0;
+                std::memcpy(&packedTexel, probes[lane] + i * kTexelSize, kTexelSize);
+
+                const glm::vec4 texel = glm::unpackHalf4x16(packedTexel);
+
+                for (uint32_t c = 0; c < kChannelCount; ++c)
+                {
+                    luminance[(i * kChannelCount + c) * kLaneCount + lane] = texel[c];
+                }
+            }
+        }
+
+        return luminance;
+    }
+
+    static LaneSums ProjectLaneProbes(const std::vector<float>& weightedBasis,
+            const std::vector<float>& luminance, uint32_t texelCount)
+    {
+        constexpr uint32_t kCoefficientCount = SphericalHarmonicsProjector::kCoefficientCount;
+
+        std::array<__m128, kSumCount> sums;
+        sums.fill(_mm_setzero_ps());
+
+        for (uint32_t i = 0; i < texelCount; ++i)
+        {
+            const float* texelBasis = weightedBasis.data() + i * kCoefficientCount;
+            const float* texelLuminance = luminance.data() + i * kChannelCount * kLaneCount;
+
+            const __m128 r = _mm_loadu_ps(texelLuminance);
+            const __m128 g = _mm_loadu_ps(texelLuminance + kLaneCount);
+            const __m128 b = _mm_loadu_ps(texelLuminance + kLaneCount * 2);
+
+            for (uint32_t j = 0; j < kCoefficientCount; ++j)
+            {
+                const __m128 basis = _mm_set1_ps(texelBasis[j]);
+
+                sums[j * kChannelCount + 0] = _mm_add_ps(sums[j * kChannelCount + 0], _mm_mul_ps(basis, r));
+                sums[j * kChannelCount + 1] = _mm_add_ps(sums[j * kChannelCount + 1], _mm_mul_ps(basis, g));
+                sums[j * kChannelCount + 2] = _mm_add_ps(sums[j * kChannelCount + 2], _mm_mul_ps(basis, b));
+            }
+        }
+
+        LaneSums result;
+
+        for (uint32_t i = 0; i < kSumCount; ++i)
+        {
+            _mm_storeu_ps(result.data() + i * kLaneCount, sums[i]);
+        }
+
+        return result;
+    }
+}
+
+SphericalHarmonicsProjector::SphericalHarmonicsProjector(uint32_t faceSize_)
+    : faceSize(faceSize_)
+    , texelCount(faceSize_ * faceSize_ * Details::kFaceCount)
+{
+    EASY_FUNCTION()
+
+    const float halfTexelSize = 1.0f / static_cast<float>(faceSize);
+
+    // LightVolume.comp integrates over the sphere and divides the result by PI
+    constexpr float kNormalization = Numbers::kInversePi;
+
+    weightedBasis.resize(texelCount * kCoefficientCount);
+
+    for (uint32_t faceIndex = 0; faceIndex < Details::kFaceCount; ++faceIndex)
+    {
+        for (uint32_t y = 0; y < faceSize; ++y)
+        {
+            for (uint32_t x = 0; x < faceSize; ++x)
+            {
+                const float s = (2.0f * static_cast<float>(x) + 1.0f) * halfTexelSize - 1.0f;
+                const float t = (2.0f * static_cast<float>(y) + 1.0f) * halfTexelSize - 1.0f;
+
+                const glm::vec3 N = glm::normalize(Details::GetTexelDirection(faceIndex, s, t));
+
+                const float weight = Details::CalculateTexelSolidAngle(s, t, halfTexelSize) * kNormalization;
+
+                const auto basis = Details::CalculateBasis(N);
+
+                const uint32_t texelIndex = (faceIndex * faceSize + y) * faceSize + x;
+
+                for (uint32_t i = 0; i < kCoefficientCount; ++i)
+                {
+                    weightedBasis[texelIndex * kCoefficientCount + i] = basis[i] * weight;
+                }
+            }
+        }
+    }
+}
+
+void SphericalHarmonicsProjector::Project(const ByteView& probesData, const DataAccess<glm::vec3>& coefficients) const
+{
+    EASY_FUNCTION()
+
+    const size_t probeSize = texelCount * Details::kTexelSize;
+
+    Assert(probesData.size % probeSize == 0);
+
+    const uint32_t probeCount = static_cast<uint32_t>(probesData.size / probeSize);
+
+    Assert(coefficients.size == probeCount * kCoefficientCount);
+
+    const uint32_t groupCount = (probeCount + Details::kLaneCount - 1) / Details::kLaneCount;
+
+    JobSystem::ParallelFor(groupCount, [&](uint32_t groupIndex)
+        {
+            const uint32_t firstProbe = groupIndex * Details::kLaneCount;
+
+            Details::LaneProbes probes{};
+
+            for (uint32_t lane = 0; lane < Details::kLaneCount && firstProbe + lane < probeCount; ++lane)
+            {
+                probes[lane] = probesData.data + (firstProbe + lane) * probeSize;
+            }
+
+            const std::vector<float> luminance = Details::DecodeLaneProbes(probes, texelCount);
+
+            const Details::LaneSums sums = Details::ProjectLaneProbes(weightedBasis, luminance, texelCount);
+
+            for (uint32_t lane = 0; lane < Details::kLaneCount && firstProbe + lane < probeCount; ++lane)
+            {
+                for (uint32_t i = 0; i < kCoefficientCount; ++i)
+                {
+                    glm::vec3& coefficient = coefficients[(firstProbe + lane) * kCoefficientCount + i];
+
+                    for (uint32_t c = 0; c < Details::kChannelCount; ++c)
+                    {
+                        coefficient[c] = sums[(i * Details::kChannelCount + c) * Details::kLaneCount + lane];
+                    }
+                }
+            }
+        }, 1);
+}
@@ -0,0 +1,127 @@
+#include "Engine/Scene/TransformHierarchy.hpp"
+
+#include "Engine/JobSystem.hpp"
+#include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/Scene.hpp"
+
+namespace Details
+{
+    // Smaller levels are not worth scheduling jobs
+    static constexpr uint32_t kMinParallelLevelSize = 1024;
+}
+
+TransformHierarchy::TransformHierarchy(const Scene& scene, uint32_t version_)
+    : version(version_)
+{
+    EASY_FUNCTION()
+
+    for (auto&& [entity, tc, hc] : scene.view<TransformComponent, HierarchyComponent>().each())
+    {
+        if (hc.parent == entt::null)
+        {
+            nodes.push_back(Node{ entity, kNoParent });
+        }
+    }
+
+    levelOffsets.push_back(0);
+
+    uint32_t levelBegin = 0;
+
+    while (levelBegin < static_cast<uint32_t>(nodes.size()))
+    {
+        const uint32_t levelEnd = static_cast<uint32_t>(nodes.size());
+
+        for (uint32_t i = levelBegin; i < levelEnd; ++i)
+        {
+            const entt::entity entity = nodes[i].entity;
+
+            for (const entt::entity child : scene.get<HierarchyComponent>(entity).children)
+            {
+                if (scene.all_of<TransformComponent>(child))
+                {
+                    nodes.push_back(Node{ child, i });
+                }
+            }
+        }
+
+        levelOffsets.push_back(levelEnd);
+
+        levelBegin = levelEnd;
+    }
+}
+
+uint32_t TransformHierarchy::Update(Scene& scene)
+{
+    EASY_FUNCTION()
+
+    std::vector<uint8_t> updated(nodes.size(), 0);
+
+    for (size_t level = 0; level + 1 < levelOffsets.size(); ++level)
+    {
+        const uint32_t levelBegin = levelOffsets[level];
+        const uint32_t levelSize = levelOffsets[level + 1] - levelBegin;
+
+        const auto functor = [&](uint32_t i)
+            {
+                const uint32_t index = levelBegin + i;
+
+                const Node& node = nodes[index];
+
+                const bool parentUpdated = node.parent != kNoParent && updated[node.parent];
+
+                TransformComponent& tc = scene.get<TransformComponent>(node.entity);
+
+                if (!tc.dirty && !parentUpdated)
+                {
+                    return;
+                }
+
+                if (node.parent == kNoParent)
+                {
+                    tc.worldTransform = tc.localTransform;
+                }
+                else
+                {
+                    const Node& parentNode = nodes[node.parent];
+
+                    const TransformComponent& parentTc = scene.get<TransformComponent>(parentNode.entity);
+
+                    tc.worldTransform = tc.localTransform * parentTc.worldTransform;
+                }
+
+                tc.dirty = false;
+
+                updated[index] = 1;
+            };
+
+        // Nodes of the same level never depend on each other
+        if (levelSize >= Details::kMinParallelLevelSize)
+        {
+            JobSystem::ParallelFor(levelSize, functor);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < levelSize; ++i)
+            {
+                functor(i);
+            }
+        }
+    }
+
+    updatedEntities.clear();
+
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        if (updated[i])
+        {
+            updatedEntities.push_back(nodes[i].entity);
+        }
+    }
+
+    if (!updatedEntities.empty())
+    {
+        ++version;
+    }
+
+    return static_cast<uint32_t>(updatedEntities.size());
+}
@@ -8,17 +8,24 @@
 
 struct CameraComponent;
 struct EnvironmentComponent;
+struct SceneData;
 
 class Scene : public entt::registry
 {
 public:
     Scene(const Filepath& path);
 
+    explicit Scene(SceneData&& sceneData);
+
     ~Scene();
 
     void AddScene(Scene&& scene, entt::entity spawn);
 
     void PrepareToRender();
+
+    // Recreates the TLAS and the instance buffer after the scene BVH was rebuilt, since they follow its item order.
+    // Returns true if they were recreated, descriptor sets referencing them have to be recreated as well.
+    bool UpdateRayTracingInstances();
 };
 
 namespace SceneHelpers
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Utils/AABBox.hpp"
+
+class Scene;
+
+// Bounding volume hierarchy over world space bounds of scene render objects, used for frustum culling
+class SceneBVH
+{
+public:
+    struct Item
+    {
+        entt::entity entity = entt::null;
+        uint32_t renderObject = 0; // index in RenderComponent::renderObjects
+    };
+
+    struct CullingStats
+    {
+        uint32_t testedCount = 0; // bounding boxes tested against the frustum, both nodes and items
+        uint32_t culledCount = 0;
+        uint32_t drawnCount = 0;
+        float cullMiliseconds = 0.0f;
+    };
+
+    explicit SceneBVH(const Scene& scene);
+
+    const std::vector<Item>& GetItems() const { return items; }
+
+    // Incremented on every rebuild, item indices of different versions are not compatible
+    uint32_t GetVersion() const { return version; }
+
+    bool IsDirty() const { return dirty; }
+
+    void MarkDirty() { dirty = true; }
+
+    bool IsTopologyDirty() const { return topologyDirty; }
+
+    // Render objects were added or removed, the items have to be collected again
+    void MarkTopologyDirty() { topologyDirty = true; }
+
+    // Recalculates bounds from the current world transforms keeping the hierarchy topology
+    void Refit(const Scene& scene);
+
+    // Collects items from the current render components and builds the hierarchy from scratch
+    void Rebuild(const Scene& scene);
+
+    // Returns indices of items which bounds intersect the frustum of viewProj
+    std::vector<uint32_t> Cull(const glm::mat4& viewProj, CullingStats& stats) const;
+
+private:
+    // Items of every subtree are stored contiguously, the left child immediately follows its parent
+    struct Node
+    {
+        glm::vec3 center;
+        uint32_t firstItem = 0;
+        glm::vec3 extent;
+        uint32_t itemCount = 0;
+        uint32_t rightChild = 0; // 0 for leaves
+    };
+
+    struct Bounds
+    {
+        glm::vec3 center;
+        glm::vec3 extent;
+    };
+
+    std::vector<Item> items;
+    std::vector<Bounds> itemBounds;
+    std::vector<Node> nodes;
+
+    uint32_t version = 0;
+
+    bool dirty = false;
+    bool topologyDirty = false;
+
+    void Build(const Scene& scene);
+
+    void CalculateItemBounds(const Scene& scene);
+
+    // Splits items of order in the median of the longest centroid axis until they fit into leaves
+    uint32_t BuildNode(std::vector<uint32_t>& order, uint32_t firstItem, uint32_t itemCount);
+
+    void RefitNodes();
+};
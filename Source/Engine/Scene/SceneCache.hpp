@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Engine/Render/Vulkan/Resources/TextureHelpers.hpp"
+#include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/Material.hpp"
+#include "Engine/Scene/Primitive.hpp"
+#include "Engine/Camera.hpp"
+
+class Filepath;
+
+// CPU side representation of a processed scene, shared by glTF and cache loading paths
+struct SceneData
+{
+    // Images are kept encoded and decoded on worker threads right before the upload
+    struct Image
+    {
+        std::string uri; // relative to the scene directory, empty for embedded images
+        Bytes data; // encoded file contents of embedded images
+    };
+
+    struct SampledImage
+    {
+        int32_t image = -1;
+        int32_t sampler = -1;
+    };
+
+    struct Geometry
+    {
+        std::vector<uint32_t> indices;
+        std::vector<Primitive::Vertex> vertices;
+        AABBox bbox;
+    };
+
+    struct Camera
+    {
+        CameraLocation location;
+        CameraProjection projection;
+    };
+
+    struct Node
+    {
+        int32_t parent = -1;
+        Transform transform;
+        std::vector<RenderObject> renderObjects;
+        std::optional<Camera> camera;
+        std::optional<LightComponent> light;
+        std::string environmentPath;
+        std::string scenePath;
+    };
+
+    std::vector<Image> images;
+    std::vector<SamplerDescription> samplers;
+    std::vector<SampledImage> textures;
+    std::vector<Material> materials;
+    std::vector<Geometry> geometries;
+    std::vector<Node> nodes; // parents always precede their children
+
+    std::vector<std::string> dependencies; // files besides the scene one that affect the processed data
+};
+
+namespace SceneCache
+{
+    std::optional<SceneData> Load(const Filepath& scenePath);
+
+    void Save(const Filepath& scenePath, const SceneData& sceneData);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+struct SceneData;
+
+// Procedural scenes built without any assets, used to stress the renderer beyond the sizes of the test scenes
+namespace SceneGenerator
+{
+    struct Description
+    {
+        uint32_t primitiveCount = 1;
+        uint32_t materialCount = 1;
+        uint32_t instanceCount = 1;
+        uint32_t hierarchyDepth = 1; // instances are chained into parent-child lists of this length
+    };
+
+    SceneData Generate(const Description& description);
+}
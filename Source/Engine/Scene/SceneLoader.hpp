@@ -2,8 +2,11 @@
 
 class Scene;
 class Filepath;
+struct SceneData;
 
 namespace SceneHelpers
 {
     void LoadScene(Scene& scene, const Filepath& path);
+
+    void LoadScene(Scene& scene, SceneData&& sceneData);
 }
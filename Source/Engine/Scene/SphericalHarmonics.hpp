@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Shaders/Common/Common.h"
+
+#include "Utils/DataHelpers.hpp"
+
+// Projects RGBA16F cubemaps into SH9 on the CPU, the result matches LightVolume.comp normalization
+class SphericalHarmonicsProjector
+{
+public:
+    static constexpr uint32_t kCoefficientCount = COEFFICIENT_COUNT;
+
+    explicit SphericalHarmonicsProjector(uint32_t faceSize_);
+
+    // probesData contains cubemaps tightly packed one after another with faces in Vulkan layer order,
+    // kCoefficientCount values per probe are written to coefficients in the same order
+    void Project(const ByteView& probesData, const DataAccess<glm::vec3>& coefficients) const;
+
+private:
+    uint32_t faceSize = 0;
+    uint32_t texelCount = 0;
+
+    // Basis values of every texel multiplied by the texel solid angle, kCoefficientCount per texel
+    std::vector<float> weightedBasis;
+};
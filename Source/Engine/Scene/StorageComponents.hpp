@@ -23,10 +23,25 @@ struct GeometryStorageComponent
     std::vector<Primitive> primitives;
 };
 
+// All primitives merged into shared buffers, so that a single indirect draw can reference any of them.
+// Primitive buffers become views into the merged ones, which own the geometry memory.
+struct MergedGeometryStorageComponent
+{
+    struct Range
+    {
+        uint32_t firstIndex = 0;
+        int32_t vertexOffset = 0;
+    };
+
+    BufferSlice indexBuffer;
+    BufferSlice vertexBuffer;
+    std::vector<Range> ranges; // matches GeometryStorageComponent::primitives
+};
+
 struct RayTracingStorageComponent
 {
-    std::vector<vk::Buffer> indexBuffers;
-    std::vector<vk::Buffer> vertexBuffers;
+    std::vector<BufferSlice> indexBuffers;
+    std::vector<BufferSlice> vertexBuffers;
     std::vector<vk::AccelerationStructureKHR> blases;
 };
 
@@ -35,4 +50,6 @@ struct RenderStorageComponent
     vk::Buffer lightBuffer;
     vk::Buffer materialBuffer;
     vk::AccelerationStructureKHR tlas;
+    vk::Buffer instanceBuffer;
+    uint32_t instanceVersion = 0; // version of the scene BVH whose item order TLAS instances follow
 };
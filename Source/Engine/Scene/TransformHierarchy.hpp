@@ -0,0 +1,40 @@
+#pragma once
+
+class Scene;
+
+// Entities with transforms flattened in the order of their hierarchy depth, parents always precede children
+class TransformHierarchy
+{
+public:
+    // Version continues from the replaced hierarchy, so that its users notice the updates made by the new one
+    TransformHierarchy(const Scene& scene, uint32_t version_);
+
+    uint32_t GetDepth() const { return static_cast<uint32_t>(levelOffsets.size()) - 1; }
+
+    // Incremented by every update which recalculates any world transform
+    uint32_t GetVersion() const { return version; }
+
+    // Entities whose world transforms were recalculated by the last update
+    const std::vector<entt::entity>& GetUpdatedEntities() const { return updatedEntities; }
+
+    // Recalculates world transforms of dirty entities and all their descendants, returns the updated count
+    uint32_t Update(Scene& scene);
+
+private:
+    static constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+
+    struct Node
+    {
+        entt::entity entity = entt::null;
+        uint32_t parent = kNoParent; // index in nodes
+    };
+
+    std::vector<Node> nodes;
+
+    // Nodes of depth i occupy [levelOffsets[i], levelOffsets[i + 1])
+    std::vector<uint32_t> levelOffsets;
+
+    uint32_t version = 0;
+
+    std::vector<entt::entity> updatedEntities;
+};
@@ -0,0 +1,18 @@
+#include "Engine/Systems/SceneBVHSystem.hpp"
+
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
+
+void SceneBVHSystem::Process(Scene& scene, float)
+{
+    SceneBVH& sceneBVH = scene.ctx().get<SceneBVH>();
+
+    if (sceneBVH.IsTopologyDirty())
+    {
+        sceneBVH.Rebuild(scene);
+    }
+    else if (sceneBVH.IsDirty())
+    {
+        sceneBVH.Refit(scene);
+    }
+}
@@ -0,0 +1,44 @@
+#include "Engine/Systems/TransformSystem.hpp"
+
+#include "Engine/Render/Vulkan/RayTracing/DynamicTlas.hpp"
+#include "Engine/Scene/Components.hpp"
+#include "Engine/Scene/Scene.hpp"
+#include "Engine/Scene/SceneBVH.hpp"
+#include "Engine/Scene/TransformHierarchy.hpp"
+
+void TransformSystem::Process(Scene& scene, float)
+{
+    const uint32_t updatedCount = scene.ctx().get<TransformHierarchy>().Update(scene);
+
+    if (updatedCount == 0)
+    {
+        return;
+    }
+
+    SceneBVH* sceneBVH = scene.ctx().find<SceneBVH>();
+
+    if (!sceneBVH)
+    {
+        return;
+    }
+
+    sceneBVH->MarkDirty();
+
+    DynamicTlas* dynamicTlas = scene.ctx().find<DynamicTlas>();
+
+    // Topology changes rebuild the scene BVH, the TLAS is then recreated with current transforms
+    if (dynamicTlas && !sceneBVH->IsTopologyDirty())
+    {
+        const std::vector<SceneBVH::Item>& items = sceneBVH->GetItems();
+
+        Assert(items.size() == dynamicTlas->GetInstanceCount());
+
+        // Only instances whose transforms actually changed are written and refitted
+        for (uint32_t i = 0; i < static_cast<uint32_t>(items.size()); ++i)
+        {
+            const auto& tc = scene.get<TransformComponent>(items[i].entity);
+
+            dynamicTlas->SetInstanceTransform(i, tc.worldTransform.GetMatrix());
+        }
+    }
+}
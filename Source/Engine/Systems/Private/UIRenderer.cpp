@@ -90,6 +90,7 @@ namespace Details
         initInfo.Device = VulkanContext::device->Get();
         initInfo.QueueFamily = VulkanContext::device->GetQueuesDescription().graphicsFamilyIndex;
         initInfo.Queue = VulkanContext::device->GetQueues().graphics;
+        initInfo.PipelineCache = VulkanContext::pipelineCache->Get();
         initInfo.DescriptorPool = descriptorPool;
         initInfo.MinImageCount = VulkanContext::swapchain->GetImageCount();
         initInfo.ImageCount = VulkanContext::swapchain->GetImageCount();
@@ -179,6 +180,13 @@ void UIRenderer::BuildFrame() const
         ImGui::Text("%s", text.c_str());
     }
 
+    ImGui::Separator();
+
+    for (const auto& [name, depth, averageMiliseconds] : VulkanContext::gpuProfiler->GetScopeStats())
+    {
+        ImGui::Text("%*s%s: %.3f ms", static_cast<int>(depth * 2), "", name.c_str(), averageMiliseconds);
+    }
+
     ImGui::End();
 }
 
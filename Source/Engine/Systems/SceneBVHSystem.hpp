@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Engine/Systems/System.hpp"
+
+class Scene;
+
+// Refits the scene BVH after transform updates and rebuilds it after render object changes,
+// so culling always uses current world bounds
+class SceneBVHSystem
+        : public System
+{
+public:
+    void Process(Scene& scene, float deltaSeconds) override;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Engine/Systems/System.hpp"
+
+class Scene;
+
+// Propagates local transform changes to world transforms and to the scene BVH and TLAS which depend on them
+class TransformSystem
+        : public System
+{
+public:
+    void Process(Scene& scene, float deltaSeconds) override;
+};
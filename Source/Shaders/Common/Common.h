@@ -37,6 +37,15 @@ struct VertexRT
     vec4 tangent; // .w - texCoord.y
 };
 
+// Indexed by TLAS instance custom index
+struct InstanceRT
+{
+    uint primitive;
+    uint material;
+    uint flags; // MaterialFlags
+    uint padding;
+};
+
 struct Tetrahedron
 {
     int vertices[TET_VERTEX_COUNT];
@@ -44,6 +53,37 @@ struct Tetrahedron
     mat3x4 matrix;
 };
 
+struct TetrahedronGrid
+{
+    vec4 origin;
+    vec4 inverseCellSize;
+    ivec4 size;
+};
+
+struct DrawObject
+{
+    mat4 transform;
+    vec4 bboxCenter; // object space
+    vec4 bboxExtent;
+    uint firstIndex;
+    uint indexCount;
+    int vertexOffset;
+    uint materialIndex;
+    uint bucketIndex;
+    uint firstCommand; // commands of the bucket start there
+    uvec2 padding;
+};
+
+// Matches VkDrawIndexedIndirectCommand
+struct DrawCommand
+{
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
 struct CameraPT
 {
     mat4 inverseView;
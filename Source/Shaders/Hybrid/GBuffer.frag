@@ -12,6 +12,7 @@
 #define ALPHA_TEST 0
 #define DOUBLE_SIDED 0
 #define NORMAL_MAPPING 0
+#define GPU_DRIVEN 0
 
 layout(constant_id = 1) const uint MATERIAL_COUNT = 256;
 
@@ -29,6 +30,9 @@ layout(location = 2) in vec2 inTexCoord;
 #if NORMAL_MAPPING
 layout(location = 3) in vec3 inTangent;
 #endif
+#if GPU_DRIVEN
+layout(location = 4) flat in uint inMaterialIndex;
+#endif
 
 layout(location = 0) out vec4 gBuffer0;
 layout(location = 1) out vec4 gBuffer1;
@@ -37,7 +41,11 @@ layout(location = 3) out vec4 gBuffer3;
 
 void main() 
 {
+#if GPU_DRIVEN
+    Material material = materials[inMaterialIndex];
+#else
     Material material = materials[materialIndex];
+#endif
 
 #if ALPHA_TEST
     vec4 baseColor = material.baseColorFactor;
@@ -1,14 +1,22 @@
 #version 460
+#extension GL_GOOGLE_include_directive : require
 
 #define SHADER_STAGE vertex
 #pragma shader_stage(vertex)
 
+#include "Common/Common.h"
+
 #define DEPTH_ONLY 0
 #define NORMAL_MAPPING 0
+#define GPU_DRIVEN 0
 
+#if GPU_DRIVEN
+layout(set = 2, binding = 0) readonly buffer Objects{ DrawObject objects[]; };
+#else
 layout(push_constant) uniform PushConstants{
     mat4 transform;
 };
+#endif
 
 layout(set = 0, binding = 0) uniform cameraBuffer{ mat4 viewProj; };
 
@@ -24,6 +32,9 @@ layout(location = 2) out vec2 outTexCoord;
 #if NORMAL_MAPPING
 layout(location = 3) out vec3 outTangent;
 #endif
+#if GPU_DRIVEN
+layout(location = 4) flat out uint outMaterialIndex;
+#endif
 #endif
 
 out gl_PerVertex 
@@ -33,6 +44,11 @@ out gl_PerVertex
 
 void main() 
 {
+#if GPU_DRIVEN
+    // firstInstance of every draw command is the object index
+    const mat4 transform = objects[gl_InstanceIndex].transform;
+#endif
+
     const vec4 worldPosition = transform * vec4(inPosition, 1.0);
 
 #if !DEPTH_ONLY
@@ -46,6 +62,10 @@ void main()
 #if NORMAL_MAPPING
     outTangent = normalize(vec3(normalTransform * vec4(inTangent, 0.0)));
 #endif
+
+#if GPU_DRIVEN
+    outMaterialIndex = objects[gl_InstanceIndex].materialIndex;
+#endif
 #endif
 
     gl_Position = viewProj * worldPosition;
@@ -17,6 +17,15 @@ void main() {}
 layout(set = 2, binding = 4) readonly buffer Positions{ float positions[]; };
 layout(set = 2, binding = 5) readonly buffer Tetrahedral{ Tetrahedron tetrahedral[]; };
 layout(set = 2, binding = 6) readonly buffer Coefficients{ float coefficients[]; };
+layout(set = 2, binding = 7) readonly buffer Grid{ TetrahedronGrid grid; int gridCells[]; };
+
+int GetStartTetrahedron(vec3 position)
+{
+    const vec3 cellCoord = (position - grid.origin.xyz) * grid.inverseCellSize.xyz;
+    const ivec3 cell = clamp(ivec3(floor(cellCoord)), ivec3(0), grid.size.xyz - 1);
+
+    return gridCells[(cell.z * grid.size.y + cell.y) * grid.size.x + cell.x];
+}
 
 vec4 GetBaryCoord(vec3 position, uint tetIndex)
 {
@@ -54,8 +63,8 @@ int FindMostNegative(vec4 baryCoord)
 
 vec3 SampleLightVolume(vec3 position, vec3 N)
 {
-    int tetIndex = 0;
-    int prevTetIndex = 0;
+    int tetIndex = GetStartTetrahedron(position);
+    int prevTetIndex = tetIndex;
 
     vec4 baryCoord;
     int coordIndex;
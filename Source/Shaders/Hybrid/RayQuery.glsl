@@ -23,6 +23,7 @@ layout(set = 4, binding = 2) uniform sampler2D textures[];
 
 layout(set = 4, binding = 3) readonly buffer IndicesData{ uint indices[]; } indicesData[];
 layout(set = 4, binding = 4) readonly buffer VerticesData{ VertexRT vertices[]; } verticesData[];
+layout(set = 4, binding = 5) readonly buffer InstancesData{ InstanceRT instances[]; };
 
 uvec3 GetIndices(uint instanceId, uint primitiveId)
 {
@@ -55,8 +56,10 @@ float TraceRay(Ray ray)
             const uint primitiveId = rayQueryGetIntersectionPrimitiveIndexEXT(rayQuery, false);
             const vec2 hitCoord = rayQueryGetIntersectionBarycentricsEXT(rayQuery, false);
 
-            const uint instanceId = customIndex & 0x0000FFFF;
-            const uint materialId = customIndex >> 16;
+            const InstanceRT instance = instances[customIndex];
+
+            const uint instanceId = instance.primitive;
+            const uint materialId = instance.material;
 
             const uvec3 indices = GetIndices(instanceId, primitiveId);
 
@@ -128,3 +128,11 @@ constexpr size_t GetSize()
 
     return std::extent_v<T>;
 }
+
+template <class T>
+constexpr T AlignUp(T value, T alignment)
+{
+    static_assert(std::is_integral_v<T>);
+
+    return (value + alignment - 1) / alignment * alignment;
+}
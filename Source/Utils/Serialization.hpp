@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Utils/DataHelpers.hpp"
+
+class BinaryWriter
+{
+public:
+    template <class T>
+    void Write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(&value);
+
+        bytes.insert(bytes.end(), data, data + sizeof(T));
+    }
+
+    template <class T>
+    void Write(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        Write(static_cast<uint64_t>(values.size()));
+
+        const uint8_t* data = reinterpret_cast<const uint8_t*>(values.data());
+
+        bytes.insert(bytes.end(), data, data + values.size() * sizeof(T));
+    }
+
+    void Write(const std::string& value)
+    {
+        Write(static_cast<uint64_t>(value.size()));
+
+        bytes.insert(bytes.end(), value.begin(), value.end());
+    }
+
+    const Bytes& GetBytes() const { return bytes; }
+
+private:
+    Bytes bytes;
+};
+
+class BinaryReader
+{
+public:
+    explicit BinaryReader(const ByteView& data_)
+        : data(data_)
+    {}
+
+    template <class T>
+    void Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        Consume(&value, sizeof(T));
+    }
+
+    template <class T>
+    void Read(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        const size_t size = ReadSize(sizeof(T));
+
+        values.resize(size);
+
+        Consume(values.data(), size * sizeof(T));
+    }
+
+    void Read(std::string& value)
+    {
+        const size_t size = ReadSize(sizeof(char));
+
+        value.resize(size);
+
+        Consume(value.data(), size);
+    }
+
+    bool IsValid() const { return valid; }
+
+    bool IsEnd() const { return offset == data.size; }
+
+private:
+    ByteView data;
+
+    size_t offset = 0;
+
+    bool valid = true;
+
+    size_t ReadSize(size_t elementSize)
+    {
+        uint64_t size = 0;
+
+        Read(size);
+
+        if (elementSize != 0 && size > (data.size - offset) / elementSize)
+        {
+            valid = false;
+            return 0;
+        }
+
+        return static_cast<size_t>(size);
+    }
+
+    void Consume(void* dst, size_t size)
+    {
+        if (!valid || size > data.size - offset)
+        {
+            valid = false;
+            return;
+        }
+
+        if (size > 0)
+        {
+            std::memcpy(dst, data.data + offset, size);
+        }
+
+        offset += size;
+    }
+};
@@ -1,10 +1,13 @@
 #include "Engine/Engine.hpp"
+#include "Engine/CommandLine.hpp"
 
-int main(int, char**)
+int main(int argc, char* argv[])
 {
     EASY_PROFILER_ENABLE
     profiler::startListen();
 
+    CommandLine::Parse(argc, argv);
+
     Engine::Create();
     Engine::Run();
     Engine::Destroy();